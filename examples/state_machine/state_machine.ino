@@ -317,6 +317,8 @@ void handleRunningState() {
 void startPortalMode() {
     Serial.println("🌐 Starting captive portal mode");
     
+    // true only means bring-up has begun; the AP is started from portal.loop()
+    // and onPortalFailed moves us to ERROR_STATE if that fails
     if (portal.startPortal("FlexifiDevice-Setup")) {
         changeAppState(AppState::PORTAL_ACTIVE);
     } else {
@@ -491,6 +493,11 @@ void setupCallbacks() {
     portal.onPortalStop([]() {
         Serial.println("🌐 Portal callback: Stopped");
     });
+    
+    portal.onPortalFailed([]() {
+        Serial.println("❌ Portal callback: Access point failed to start");
+        changeAppState(AppState::ERROR_STATE);
+    });
 }
 
 /*
@@ -2,13 +2,98 @@
 #include "PortalWebServer.h"
 #include "StorageManager.h"
 #include "TemplateManager.h"
+#include "generated/web_asset_types.h"
 #include "FlexifiParameter.h"
 #include <WiFi.h>
 #include <ArduinoJson.h>
 #include <DNSServer.h>
+#include <StreamString.h>
 
-// Static instance for WiFi event callbacks
-Flexifi* Flexifi::_instance = nullptr;
+namespace {
+
+// Task mode event group bits
+const EventBits_t TASK_BIT_WAKE = (1 << 0);
+const EventBits_t TASK_BIT_STOP = (1 << 1);
+const EventBits_t TASK_BIT_STOPPED = (1 << 2);
+
+// WiFi events waiting for loop() or the Flexifi task
+const UBaseType_t WIFI_EVENT_QUEUE_LENGTH = 16;
+
+// Holds the API mutex for the enclosing scope; no-op if it could not be allocated
+class ApiLock {
+public:
+    explicit ApiLock(SemaphoreHandle_t mutex) : _mutex(mutex) {
+        if (_mutex) {
+            xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+        }
+    }
+    ~ApiLock() {
+        if (_mutex) {
+            xSemaphoreGiveRecursive(_mutex);
+        }
+    }
+
+private:
+    SemaphoreHandle_t _mutex;
+};
+
+} // namespace
+
+// Renders templates from the scan table and parameter views published by loop().
+// Both are captured when the page starts, so a stream that is regenerated chunk by
+// chunk always sees the same data, even if a scan completes mid-response, and the
+// web server task never needs the API lock.
+class FlexifiTemplateData : public TemplateData {
+public:
+    explicit FlexifiTemplateData(const Flexifi* portal) :
+        _networks(std::atomic_load(&portal->_networks)),
+        _parameters(std::atomic_load(&portal->_parameterViews)) {}
+
+    size_t count(uint8_t collection) const override {
+        if (collection == FlexifiAssets::VAR_NETWORKS) {
+            return _networks ? _networks->size() : 0;
+        }
+        if (collection == FlexifiAssets::VAR_PARAMETERS) {
+            return _parameters ? _parameters->size() : 0;
+        }
+        return 0;
+    }
+
+    bool write(uint8_t variable, uint8_t collection, size_t index, Print& out) const override {
+        if (variable == FlexifiAssets::VAR_CUSTOM_PARAMETERS) {
+            if (_parameters) {
+                for (const FlexifiParameterView& parameter : *_parameters) {
+                    out.print(parameter.html);
+                }
+            }
+            return true;
+        }
+
+        if (collection == FlexifiAssets::VAR_NETWORKS && index < count(collection)) {
+            const FlexifiNetwork& network = (*_networks)[index];
+            switch (variable) {
+                case FlexifiAssets::VAR_SSID:    TemplateManager::writeEscaped(out, network.ssid.c_str()); return true;
+                case FlexifiAssets::VAR_RSSI:    out.print(network.rssi); return true;
+                case FlexifiAssets::VAR_CHANNEL: out.print(network.channel); return true;
+                case FlexifiAssets::VAR_SECURE:  out.print(network.secure ? "true" : "false"); return true;
+                case FlexifiAssets::VAR_SIGNAL:  out.print(Flexifi::_getSignalStrengthIcon(network.rssi)); return true;
+            }
+        } else if (collection == FlexifiAssets::VAR_PARAMETERS && index < count(collection)) {
+            const FlexifiParameterView& parameter = (*_parameters)[index];
+            switch (variable) {
+                case FlexifiAssets::VAR_ID:        TemplateManager::writeEscaped(out, parameter.id.c_str()); return true;
+                case FlexifiAssets::VAR_LABEL:     TemplateManager::writeEscaped(out, parameter.label.c_str()); return true;
+                case FlexifiAssets::VAR_VALUE:     TemplateManager::writeEscaped(out, parameter.value.c_str()); return true;
+                case FlexifiAssets::VAR_PARAMETER: out.print(parameter.html); return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::shared_ptr<const std::vector<FlexifiNetwork>> _networks;
+    std::shared_ptr<const std::vector<FlexifiParameterView>> _parameters;
+};
 
 Flexifi::Flexifi(AsyncWebServer* server, bool generatePassword) :
     _server(server),
@@ -24,51 +109,100 @@ Flexifi::Flexifi(AsyncWebServer* server, bool generatePassword) :
     _apPassword(""),
     _generatedPassword(""),
     _useGeneratedPassword(generatePassword),
+    _autoConnectEnabled(true),
+    _lastAutoConnectAttempt(0),
+    _autoConnectDelay(0),
+    _autoConnectRetryCount(0),
+    _autoConnectLimitReachedLogged(false),
+    _backoffInitial(FLEXIFI_AUTOCONNECT_BACKOFF_INITIAL),
+    _backoffMax(FLEXIFI_AUTOCONNECT_BACKOFF_MAX),
+    _backoffMultiplier(FLEXIFI_AUTOCONNECT_BACKOFF_MULTIPLIER),
+    _backoffJitter(FLEXIFI_AUTOCONNECT_BACKOFF_JITTER),
+    _autoConnectMaxRetries(FLEXIFI_AUTOCONNECT_MAX_RETRIES),
+    _autoConnectIndex(0),
+    _autoConnectHandle(0),
+    _autoConnectNextPending(false),
     _portalTimeout(FLEXIFI_PORTAL_TIMEOUT),
     _connectTimeout(FLEXIFI_CONNECT_TIMEOUT),
     _portalStartTime(0),
     _connectStartTime(0),
+    _connectDeadline(FLEXIFI_CONNECT_TIMEOUT),
+    _connectAttempt(0),
+    _connectHandle(0),
+    _nextConnectHandle(1),
+    _connectCallback(nullptr),
+    _lastDisconnectReason(0),
     _lastScanTime(0),
     _lastStorageRetry(0),
     _networkCount(0),
-    _networksJSON("[]"),
+    _networksJSON(new String("[]")),
+    _networks(nullptr),
+    _scanGeneration(0),
     _minSignalQuality(-70),
     _mdnsHostname("flexifi"),
     _mdnsStarted(false),
     _scanInProgress(false),
-    _parameters(nullptr),
-    _parameterCount(0),
-    _maxParameters(10),
-    _autoConnectEnabled(true),
-    _lastAutoConnectAttempt(0),
-    _autoConnectRetryCount(0),
-    _autoConnectLimitReachedLogged(false),
+    _scanPending(false),
+    _scanPendingSince(0),
+    _startupStage(StartupStage::NONE),
+    _startupStageTime(0),
+    _apModeReady(false),
+    _roamingEnabled(false),
+    _roamRssiThreshold(FLEXIFI_ROAM_RSSI_THRESHOLD),
+    _roamHysteresis(FLEXIFI_ROAM_HYSTERESIS),
+    _roamScanInterval(FLEXIFI_ROAM_SCAN_INTERVAL),
+    _roamMinInterval(FLEXIFI_ROAM_MIN_INTERVAL),
+    _roamWeakLink(false),
+    _roamScanInProgress(false),
+    _roamInProgress(false),
+    _roamRecovery(false),
+    _lastRoamCheck(0),
+    _lastRoamScan(0),
+    _lastRoamTime(0),
+    _roamTimeBelowThreshold(0),
+    _roamCount(0),
+    _roamTargetBSSID(""),
+    _statusProfilesDirty(true),
+    _statusJSON(nullptr),
+    _statusJSONVersion(0),
+    _statusJSONScanSeconds(0),
+    _parameterViews(nullptr),
+    _parameterViewsRevision(0),
     _onPortalStart(nullptr),
     _onPortalStop(nullptr),
+    _onPortalFailed(nullptr),
     _onWiFiConnect(nullptr),
     _onWiFiDisconnect(nullptr),
     _onConfigSave(nullptr),
     _onScanComplete(nullptr),
     _onConnectStart(nullptr),
     _onConnectFailed(nullptr),
-    _onInternalScanComplete(nullptr) {
+    _onRoamStart(nullptr),
+    _onRoamComplete(nullptr),
+    _taskHandle(nullptr),
+    _taskEvents(nullptr),
+    _wifiEventQueue(nullptr),
+    _apiMutex(nullptr),
+    _onInternalScanComplete(nullptr),
+    _wifiEventId(0),
+    _wifiEventRegistered(false) {
     
     if (!_server) {
         FLEXIFI_LOGE("AsyncWebServer pointer is null");
         return;
     }
     
-    // Set static instance for WiFi event callbacks
-    _instance = this;
+    // loop() and the Flexifi task hold this while they run; web handlers wait a bounded time
+    _apiMutex = xSemaphoreCreateRecursiveMutex();
+    if (!_apiMutex) {
+        FLEXIFI_LOGE("Failed to allocate API mutex");
+    }
     
     // Initialize components
     _storage = new StorageManager();
     _templateManager = new TemplateManager();
     _portalServer = new PortalWebServer(_server, this);
     
-    // Initialize parameters
-    _initParameters();
-    
     // Setup WiFi event handlers
     _setupWiFiEvents();
     
@@ -78,19 +212,23 @@ Flexifi::Flexifi(AsyncWebServer* server, bool generatePassword) :
         FLEXIFI_LOGI("Generated portal password: %s", _generatedPassword.c_str());
     }
     
+    _touchStatus();
+    
     FLEXIFI_LOGI("Flexifi initialized");
 }
 
 Flexifi::~Flexifi() {
-    stopPortal();
-    
-    // Clear static instance
-    if (_instance == this) {
-        _instance = nullptr;
+    // Stop receiving WiFi events before tearing anything down
+    if (_wifiEventRegistered) {
+        WiFi.removeEvent(_wifiEventId);
+        _wifiEventRegistered = false;
     }
     
-    // Clean up parameters
-    _clearParameters();
+    stopTask();
+    stopPortal();
+    
+    // Library-owned parameters are deleted by the registry
+    _parameters.clear();
     
     if (_dnsServer) {
         delete _dnsServer;
@@ -111,6 +249,21 @@ Flexifi::~Flexifi() {
         delete _templateManager;
         _templateManager = nullptr;
     }
+    
+    if (_wifiEventQueue) {
+        vQueueDelete(_wifiEventQueue);
+        _wifiEventQueue = nullptr;
+    }
+    
+    if (_taskEvents) {
+        vEventGroupDelete(_taskEvents);
+        _taskEvents = nullptr;
+    }
+    
+    if (_apiMutex) {
+        vSemaphoreDelete(_apiMutex);
+        _apiMutex = nullptr;
+    }
 }
 
 bool Flexifi::init() {
@@ -135,11 +288,15 @@ bool Flexifi::init() {
         }
     }
     
+    // Publish the first status snapshot before any request can ask for it
+    _refreshStatus();
+    
     FLEXIFI_LOGI("Flexifi initialization completed");
     return true;
 }
 
 void Flexifi::setTemplate(const String& templateName) {
+    ApiLock lock(_apiMutex);
     if (_templateManager) {
         _templateManager->setTemplate(templateName);
         FLEXIFI_LOGI("Template set to: %s", templateName.c_str());
@@ -147,13 +304,27 @@ void Flexifi::setTemplate(const String& templateName) {
 }
 
 void Flexifi::setCustomTemplate(const String& htmlTemplate) {
+    ApiLock lock(_apiMutex);
     if (_templateManager) {
         _templateManager->setCustomTemplate(htmlTemplate);
         FLEXIFI_LOGI("Custom template set");
     }
 }
 
+bool Flexifi::setCustomTemplateFile(const String& path) {
+    ApiLock lock(_apiMutex);
+    return _templateManager && _templateManager->setCustomTemplateFile(path);
+}
+
+void Flexifi::setRenderCacheBudget(size_t bytes) {
+    ApiLock lock(_apiMutex);
+    if (_templateManager) {
+        _templateManager->setRenderCacheBudget(bytes);
+    }
+}
+
 void Flexifi::setCredentials(const String& ssid, const String& password) {
+    ApiLock lock(_apiMutex);
     _currentSSID = ssid;
     _currentPassword = password;
     FLEXIFI_LOGD("Credentials set for SSID: %s", ssid.c_str());
@@ -171,6 +342,7 @@ void Flexifi::setConnectTimeout(unsigned long timeout) {
 
 // mDNS Configuration
 void Flexifi::setMDNSHostname(const String& hostname) {
+    ApiLock lock(_apiMutex);
     _mdnsHostname = hostname;
     FLEXIFI_LOGI("mDNS hostname set to: %s", hostname.c_str());
     
@@ -182,6 +354,7 @@ void Flexifi::setMDNSHostname(const String& hostname) {
 }
 
 String Flexifi::getMDNSHostname() const {
+    ApiLock lock(_apiMutex);
     return _mdnsHostname;
 }
 
@@ -238,6 +411,7 @@ void Flexifi::_stopMDNS() {
 }
 
 bool Flexifi::startPortal(const String& apName, const String& apPassword) {
+    ApiLock lock(_apiMutex);
     if (_portalState != PortalState::STOPPED) {
         FLEXIFI_LOGW("Portal already running");
         return false;
@@ -258,6 +432,7 @@ bool Flexifi::startPortal(const String& apName, const String& apPassword) {
     // Initialize storage
     if (!_storage->init()) {
         FLEXIFI_LOGE("Failed to initialize storage");
+        _publishEvent(FlexifiEventType::STORAGE_ERROR);
         return false;
     }
     
@@ -267,25 +442,15 @@ bool Flexifi::startPortal(const String& apName, const String& apPassword) {
         return false;
     }
     
-    // Set up access point
-    if (!_setupAP()) {
-        FLEXIFI_LOGE("Failed to set up access point");
-        return false;
-    }
-    
-    _portalStartTime = millis();
-    _onPortalStateChange(PortalState::ACTIVE);
-    
-    // Trigger portal start callback
-    if (_onPortalStart) {
-        _onPortalStart();
-    }
+    // Switch WiFi mode; the access point itself is brought up from loop()
+    _beginAPSetup();
     
-    FLEXIFI_LOGI("Portal started successfully");
+    FLEXIFI_LOGI("Portal startup initiated");
     return true;
 }
 
 void Flexifi::stopPortal() {
+    ApiLock lock(_apiMutex);
     if (_portalState == PortalState::STOPPED) {
         return;
     }
@@ -293,14 +458,22 @@ void Flexifi::stopPortal() {
     FLEXIFI_LOGI("Stopping portal");
     
     _onPortalStateChange(PortalState::STOPPING);
+    _startupStage = StartupStage::NONE;
     
     // Stop access point
     _stopAP();
     
     // Clear cached network data to free memory
-    _networksJSON = "[]";
+    std::atomic_store(&_networksJSON, std::shared_ptr<const String>(new String("[]")));
+    std::atomic_store(&_networks, std::shared_ptr<const std::vector<FlexifiNetwork>>());
+    _scanGeneration++;
     _networkCount = 0;
+    if (_templateManager) {
+        _templateManager->clearRenderCache();
+    }
     _scanInProgress = false;
+    _scanPending = false;
+    _touchStatus();
     
     _onPortalStateChange(PortalState::STOPPED);
     
@@ -308,6 +481,7 @@ void Flexifi::stopPortal() {
     if (_onPortalStop) {
         _onPortalStop();
     }
+    _publishEvent(FlexifiEventType::PORTAL_STOP);
     
     FLEXIFI_LOGI("Portal stopped");
 }
@@ -321,11 +495,14 @@ PortalState Flexifi::getPortalState() const {
 }
 
 bool Flexifi::saveConfig() {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
     
     bool success = _storage->saveCredentials(_currentSSID, _currentPassword);
+    _statusProfilesDirty = true;  // Saving credentials also records a profile
+    _touchStatus();
     if (success) {
         FLEXIFI_LOGI("Configuration saved: %s", _currentSSID.c_str());
         
@@ -336,13 +513,17 @@ bool Flexifi::saveConfig() {
         if (_onConfigSave) {
             _onConfigSave(_currentSSID, _currentPassword);
         }
+        _publishEvent(FlexifiEventType::CONFIG_SAVE, _currentSSID.c_str(), 0, true);
     } else {
         FLEXIFI_LOGE("Failed to save configuration");
+        _publishEvent(FlexifiEventType::CONFIG_SAVE, _currentSSID.c_str(), 0, false);
+        _publishEvent(FlexifiEventType::STORAGE_ERROR, _currentSSID.c_str());
     }
     return success;
 }
 
 bool Flexifi::loadConfig() {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
@@ -361,6 +542,7 @@ bool Flexifi::loadConfig() {
 }
 
 void Flexifi::clearConfig() {
+    ApiLock lock(_apiMutex);
     if (_storage) {
         _storage->clearCredentials();
         _currentSSID = "";
@@ -370,12 +552,15 @@ void Flexifi::clearConfig() {
 }
 
 bool Flexifi::retryStorageInit() {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
     
     bool success = _storage->retryInitialization();
     if (success) {
+        _statusProfilesDirty = true;
+        _touchStatus();
         // If storage became available, try to load config and parameters
         loadConfig();
         _loadParameterValues();
@@ -386,29 +571,37 @@ bool Flexifi::retryStorageInit() {
 
 // WiFi Profile Management
 bool Flexifi::addWiFiProfile(const String& ssid, const String& password, int priority) {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
     
     FLEXIFI_LOGI("Adding WiFi profile: %s (priority: %d)", ssid.c_str(), priority);
     WiFiProfile profile(ssid, password, priority);
+    _statusProfilesDirty = true;
+    _touchStatus();
     return _storage->saveWiFiProfile(profile);
 }
 
 bool Flexifi::updateWiFiProfile(const String& ssid, const String& password, int priority) {
+    ApiLock lock(_apiMutex);
     return addWiFiProfile(ssid, password, priority); // saveWiFiProfile handles updates
 }
 
 bool Flexifi::deleteWiFiProfile(const String& ssid) {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
     
     FLEXIFI_LOGI("Deleting WiFi profile: %s", ssid.c_str());
+    _statusProfilesDirty = true;
+    _touchStatus();
     return _storage->deleteWiFiProfile(ssid);
 }
 
 bool Flexifi::hasWiFiProfile(const String& ssid) {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
@@ -423,13 +616,17 @@ bool Flexifi::hasWiFiProfile(const String& ssid) {
 }
 
 void Flexifi::clearAllWiFiProfiles() {
+    ApiLock lock(_apiMutex);
     if (_storage) {
         _storage->clearAllWiFiProfiles();
+        _statusProfilesDirty = true;
+        _touchStatus();
         FLEXIFI_LOGI("All WiFi profiles cleared");
     }
 }
 
 int Flexifi::getWiFiProfileCount() const {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return 0;
     }
@@ -439,6 +636,7 @@ int Flexifi::getWiFiProfileCount() const {
 }
 
 String Flexifi::getWiFiProfilesJSON() const {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return "[]";
     }
@@ -449,6 +647,7 @@ String Flexifi::getWiFiProfilesJSON() const {
 
 // Auto-connect functionality
 bool Flexifi::autoConnect() {
+    ApiLock lock(_apiMutex);
     if (!_autoConnectEnabled) {
         FLEXIFI_LOGD("🚫 autoConnect() called but auto-connect is disabled");
         return false;
@@ -461,34 +660,70 @@ bool Flexifi::autoConnect() {
     
     FLEXIFI_LOGI("🔍 autoConnect() called - enabled: YES, storage: YES");
     
+    // A round through the saved profiles is still running
+    if (_autoConnectHandle != 0 || _autoConnectNextPending) {
+        return false;
+    }
+    
     // Check retry limits
     unsigned long now = millis();
-    if (_autoConnectRetryCount >= MAX_AUTO_CONNECT_RETRIES) {
+    if (_autoConnectMaxRetries > 0 && _autoConnectRetryCount >= _autoConnectMaxRetries) {
         if (!_autoConnectLimitReachedLogged) {
-            FLEXIFI_LOGW("🚫 Auto-connect retry limit reached (%d/%d)", _autoConnectRetryCount, MAX_AUTO_CONNECT_RETRIES);
+            FLEXIFI_LOGW("🚫 Auto-connect retry limit reached (%d/%d)", _autoConnectRetryCount, _autoConnectMaxRetries);
             _autoConnectLimitReachedLogged = true;
         }
         return false;
     }
     
-    // Check retry delay (but allow immediate first attempt)
-    if (_lastAutoConnectAttempt > 0 && now - _lastAutoConnectAttempt < AUTO_CONNECT_RETRY_DELAY) {
-        unsigned long remainingDelay = AUTO_CONNECT_RETRY_DELAY - (now - _lastAutoConnectAttempt);
-        FLEXIFI_LOGD("🕐 Auto-connect retry delay: %lu ms remaining", remainingDelay);
+    // Wait out the current backoff delay (zero before the first attempt)
+    if (now - _lastAutoConnectAttempt < _autoConnectDelay) {
+        FLEXIFI_LOGD("🕐 Auto-connect backoff: %lu ms remaining", getAutoConnectDelayRemaining());
         return false;
     }
     
-    _lastAutoConnectAttempt = now;
     _autoConnectRetryCount++;
+    _lastAutoConnectAttempt = now;
+    _autoConnectDelay = _computeBackoffDelay(_autoConnectRetryCount);
     
-    FLEXIFI_LOGI("🔄 Starting auto-connect attempt %d/%d", _autoConnectRetryCount, MAX_AUTO_CONNECT_RETRIES);
+    FLEXIFI_LOGI("🔄 Starting auto-connect attempt %d (next retry in %lu ms)", _autoConnectRetryCount, _autoConnectDelay);
     
     // Try to connect to saved profiles
     return _tryConnectToProfiles();
 }
 
+void Flexifi::setAutoConnectBackoff(unsigned long initialDelay, unsigned long maxDelay, float multiplier, float jitter) {
+    ApiLock lock(_apiMutex);
+    _backoffInitial = initialDelay;
+    _backoffMax = maxDelay > initialDelay ? maxDelay : initialDelay;
+    _backoffMultiplier = multiplier >= 1.0f ? multiplier : 1.0f;
+    _backoffJitter = constrain(jitter, 0.0f, 1.0f);
+    FLEXIFI_LOGD("Auto-connect backoff set to: %lu-%lu ms (x%.2f, jitter %.2f)", 
+                 _backoffInitial, _backoffMax, _backoffMultiplier, _backoffJitter);
+}
+
+void Flexifi::setAutoConnectMaxRetries(int maxRetries) {
+    ApiLock lock(_apiMutex);
+    _autoConnectMaxRetries = maxRetries > 0 ? maxRetries : 0;
+    _autoConnectLimitReachedLogged = false;
+}
+
+void Flexifi::resetAutoConnectBackoff() {
+    ApiLock lock(_apiMutex);
+    _autoConnectRetryCount = 0;
+    _lastAutoConnectAttempt = 0;
+    _autoConnectDelay = 0;
+    _autoConnectLimitReachedLogged = false;
+    FLEXIFI_LOGD("Auto-connect backoff reset");
+}
+
+unsigned long Flexifi::getAutoConnectDelayRemaining() const {
+    unsigned long elapsed = millis() - _lastAutoConnectAttempt;
+    return (elapsed < _autoConnectDelay) ? (_autoConnectDelay - elapsed) : 0;
+}
+
 void Flexifi::setAutoConnectEnabled(bool enabled) {
     _autoConnectEnabled = enabled;
+    _touchStatus();
     FLEXIFI_LOGI("Auto-connect %s", enabled ? "enabled" : "disabled");
 }
 
@@ -497,6 +732,7 @@ bool Flexifi::isAutoConnectEnabled() const {
 }
 
 String Flexifi::getHighestPrioritySSID() const {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return "";
     }
@@ -518,6 +754,7 @@ String Flexifi::getHighestPrioritySSID() const {
 }
 
 bool Flexifi::updateProfileLastUsed(const String& ssid) {
+    ApiLock lock(_apiMutex);
     if (!_storage) {
         return false;
     }
@@ -526,56 +763,158 @@ bool Flexifi::updateProfileLastUsed(const String& ssid) {
 }
 
 // Custom parameters
-void Flexifi::addParameter(FlexifiParameter* parameter) {
-    if (_addParameterToArray(parameter)) {
-        FLEXIFI_LOGD("Parameter added: %s", parameter->getID().c_str());
-        
-        // Load saved value for this parameter (if any)
-        _loadParameterValue(parameter);
-    }
+bool Flexifi::addParameter(FlexifiParameter* parameter) {
+    ApiLock lock(_apiMutex);
+    return _registerParameter(parameter, ParameterOwnership::LIBRARY);
 }
 
-void Flexifi::addParameter(const String& id, const String& label, const String& defaultValue, int maxLength) {
-    FlexifiParameter* param = new FlexifiParameter(id, label, defaultValue, maxLength);
-    addParameter(param);
+bool Flexifi::addParameter(FlexifiParameter& parameter) {
+    ApiLock lock(_apiMutex);
+    return _registerParameter(&parameter, ParameterOwnership::CALLER);
+}
+
+bool Flexifi::addParameter(const String& id, const String& label, const String& defaultValue, int maxLength) {
+    ApiLock lock(_apiMutex);
+    return _registerParameter(new FlexifiParameter(id, label, defaultValue, maxLength), 
+                              ParameterOwnership::LIBRARY);
+}
+
+bool Flexifi::removeParameter(const String& id) {
+    ApiLock lock(_apiMutex);
+    if (!_parameters.remove(id)) {
+        return false;
+    }
+    FLEXIFI_LOGD("Parameter removed: %s", id.c_str());
+    return true;
 }
 
 FlexifiParameter* Flexifi::getParameter(const String& id) {
-    int index = _findParameterIndex(id);
-    return (index >= 0) ? _parameters[index] : nullptr;
+    ApiLock lock(_apiMutex);
+    return _parameters.find(id);
 }
 
 String Flexifi::getParameterValue(const String& id) const {
-    int index = _findParameterIndex(id);
-    return (index >= 0) ? _parameters[index]->getValue() : "";
+    ApiLock lock(_apiMutex);
+    FlexifiParameter* parameter = _parameters.find(id);
+    return parameter ? parameter->getValue() : "";
 }
 
 void Flexifi::setParameterValue(const String& id, const String& value) {
-    int index = _findParameterIndex(id);
-    if (index >= 0) {
-        _parameters[index]->setValue(value);
+    ApiLock lock(_apiMutex);
+    FlexifiParameter* parameter = _parameters.find(id);
+    if (parameter) {
+        parameter->setValue(value);
         FLEXIFI_LOGD("Parameter value set: %s = %s", id.c_str(), value.c_str());
     }
 }
 
 int Flexifi::getParameterCount() const {
-    return _parameterCount;
+    return _parameters.size();
 }
 
 String Flexifi::getParametersHTML() const {
-    String html = "";
-    for (int i = 0; i < _parameterCount; i++) {
-        if (_parameters[i]) {
-            html += _parameters[i]->generateHTML();
+    ApiLock lock(_apiMutex);
+    StreamString html;
+    writeParametersHTML(html);
+    return html;
+}
+
+void Flexifi::writeParametersHTML(Print& out) const {
+    ApiLock lock(_apiMutex);
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        _parameters.at(i)->renderHTML(out);
+    }
+}
+
+void Flexifi::writeParametersSchema(Print& out) const {
+    ApiLock lock(_apiMutex);
+    out.print("{\"parameters\":[");
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        if (i > 0) out.print(",");
+        _parameters.at(i)->renderSchema(out);
+    }
+    out.print("]}");
+}
+
+uint32_t Flexifi::getParametersRevision() const {
+    ApiLock lock(_apiMutex);
+    return _parameters.revision();
+}
+
+std::shared_ptr<const FlexifiParametersSchema> Flexifi::getParametersSchemaShared() const {
+    return std::atomic_load(&_parametersSchema);
+}
+
+void Flexifi::addValidationRule(const String& parameterId, FlexifiFormRule rule) {
+    ApiLock lock(_apiMutex);
+    if (rule) {
+        _validationRules.emplace_back(parameterId, rule);
+    }
+}
+
+bool Flexifi::validateParameters(const std::vector<std::pair<String, String>>& values, 
+                                 FlexifiFieldErrors& errors) const {
+    ApiLock lock(_apiMutex);
+    errors.clear();
+    
+    // Single pass over the submitted fields; unknown IDs are ignored, as when applying them
+    for (const auto& value : values) {
+        FlexifiParameter* parameter = _parameters.find(value.first);
+        if (!parameter) {
+            continue;
+        }
+        
+        String error;
+        if (!parameter->validateValue(value.second, error)) {
+            errors.emplace_back(value.first, error);
         }
     }
-    return html;
+    
+    // Browsers omit unchecked checkboxes, so required fields can be missing entirely.
+    // Check each by ID: counting submitted fields is fooled by duplicates (a=1&a=1)
+    FlexifiFormValues form(values);
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        FlexifiParameter* parameter = _parameters.at(i);
+        if (parameter->isRequired() && !form.has(parameter->getID())) {
+            errors.emplace_back(parameter->getID(), parameter->getLabel() + " is required");
+        }
+    }
+    
+    // Cross-field rules see the whole submission; skip fields that already failed
+    for (const auto& rule : _validationRules) {
+        bool failed = false;
+        for (const auto& error : errors) {
+            if (error.first == rule.first) {
+                failed = true;
+                break;
+            }
+        }
+        if (failed) {
+            continue;
+        }
+        
+        String error = rule.second(form);
+        if (!error.isEmpty()) {
+            errors.emplace_back(rule.first, error);
+        }
+    }
+    
+    if (!errors.empty()) {
+        FLEXIFI_LOGW("❌ Parameter validation failed for %d field(s)", (int)errors.size());
+    }
+    return errors.empty();
 }
 
 // Network management
 bool Flexifi::scanNetworks(bool bypassThrottle) {
+    ApiLock lock(_apiMutex);
     unsigned long now = millis();
     
+    if (_roamScanInProgress) {
+        FLEXIFI_LOGW("🚫 Scan deferred - roaming scan in progress");
+        return false;
+    }
+    
     // Check throttle limit unless bypassed
     if (!bypassThrottle && now - _lastScanTime < FLEXIFI_SCAN_THROTTLE_TIME) {
         FLEXIFI_LOGW("🚫 Scan throttled - too soon since last scan (%lu ms ago)", now - _lastScanTime);
@@ -593,18 +932,35 @@ bool Flexifi::scanNetworks(bool bypassThrottle) {
     FLEXIFI_LOGD("Current scan status before new scan: %d", WiFi.scanComplete());
     
     // Ensure clean WiFi state before scanning (workaround for ESP32 scan issues)
+    bool needsSettle = false;
     if (WiFi.status() == WL_CONNECTED || WiFi.status() == WL_CONNECT_FAILED) {
         FLEXIFI_LOGD("Disconnecting from WiFi before scan to ensure clean state");
         WiFi.disconnect();
-        delay(100);
+        needsSettle = true;
     }
     
     // Ensure WiFi is in the correct mode for scanning
     if (WiFi.getMode() == WIFI_OFF) {
         WiFi.mode(WIFI_AP_STA);
-        delay(100); // Give time for mode to change
+        needsSettle = true;
+    }
+    
+    _lastScanTime = now;
+    
+    if (needsSettle) {
+        // Let the driver settle; loop() starts the scan once the delay has passed
+        FLEXIFI_LOGD("Deferring scan start by %d ms", FLEXIFI_SCAN_SETTLE_TIME);
+        _scanPending = true;
+        _scanPendingSince = now;
+        return true;
     }
     
+    return _startScan();
+}
+
+bool Flexifi::_startScan() {
+    _scanPending = false;
+    
     FLEXIFI_LOGD("Current WiFi mode: %d", WiFi.getMode());
     
     // Delete any previous scan results
@@ -616,7 +972,7 @@ bool Flexifi::scanNetworks(bool bypassThrottle) {
     
     // Start new scan (async, don't show hidden networks)
     int result = WiFi.scanNetworks(true, false); // true = async, false = no hidden networks
-    FLEXIFI_LOGD("Scan initiation attempt 1 result: %d", result);
+    FLEXIFI_LOGD("Scan initiation result: %d", result);
     
     if (result == WIFI_SCAN_FAILED) {
         FLEXIFI_LOGW("WiFi scan failed to start");
@@ -624,13 +980,16 @@ bool Flexifi::scanNetworks(bool bypassThrottle) {
     }
     
     FLEXIFI_LOGI("WiFi scan started successfully");
-    _lastScanTime = now;
+    _lastScanTime = millis();
     _scanInProgress = true;
+    _touchStatus();
+    _publishEvent(FlexifiEventType::SCAN_START);
     return true;
 }
 
 String Flexifi::getNetworksJSON() const {
-    return _networksJSON;
+    // Lock-free for web handlers; replaced as a whole when a scan completes
+    return *std::atomic_load(&_networksJSON);
 }
 
 unsigned long Flexifi::getScanTimeRemaining() const {
@@ -640,14 +999,20 @@ unsigned long Flexifi::getScanTimeRemaining() const {
 }
 
 bool Flexifi::connectToWiFi(const String& ssid, const String& password) {
+    return connectAsync(ssid, password) != 0;
+}
+
+uint32_t Flexifi::connectAsync(const String& ssid, const String& password, unsigned long deadline,
+                               ConnectCallback callback) {
+    ApiLock lock(_apiMutex);
     if (ssid.isEmpty()) {
         FLEXIFI_LOGW("Cannot connect to empty SSID");
-        return false;
+        return 0;
     }
     
     if (_wifiState == WiFiState::CONNECTING) {
         FLEXIFI_LOGW("Already connecting to network");
-        return false;
+        return 0;
     }
     
     FLEXIFI_LOGI("Attempting to connect to: %s", ssid.c_str());
@@ -663,35 +1028,105 @@ bool Flexifi::connectToWiFi(const String& ssid, const String& password) {
     WiFi.mode(WIFI_STA);
     
     // Start connection
+    _connectAttempt++;
     WiFi.begin(ssid.c_str(), password.c_str());
     
+    _connectHandle = _nextConnectHandle++;
+    if (_nextConnectHandle == 0) {
+        _nextConnectHandle = 1;
+    }
+    _connectCallback = callback;
+    _connectDeadline = deadline ? deadline : _connectTimeout;
     _connectStartTime = millis();
+    _lastDisconnectReason = 0;
     _onWiFiStateChange(WiFiState::CONNECTING);
     
     // Trigger callback
     if (_onConnectStart) {
         _onConnectStart(ssid);
     }
+    _publishEvent(FlexifiEventType::CONNECT_START, ssid.c_str());
     
     // Notify via WebSocket
     if (_portalServer) {
         _portalServer->broadcastMessage("connect_start", "Connecting to " + ssid);
     }
     
+    return _connectHandle;
+}
+
+bool Flexifi::cancelConnect(uint32_t handle) {
+    ApiLock lock(_apiMutex);
+    if (handle == 0 && _autoConnectNextPending) {
+        // Between two profiles of an auto-connect round; nothing is associating yet
+        _autoConnectNextPending = false;
+        _autoConnectQueue.clear();
+        return true;
+    }
+    if (_connectHandle == 0 || (handle != 0 && handle != _connectHandle)) {
+        return false;
+    }
+    
+    FLEXIFI_LOGI("Connection attempt to %s cancelled", _currentSSID.c_str());
+    
+    // State changes first so the resulting disconnect event is ignored
+    _onWiFiStateChange(WiFiState::DISCONNECTED);
+    WiFi.disconnect();
+    
+    _completeConnect(ConnectResult::CANCELLED, 0);
     return true;
 }
 
+bool Flexifi::isConnectPending(uint32_t handle) const {
+    return _connectHandle != 0 && (handle == 0 || handle == _connectHandle);
+}
+
+const char* Flexifi::connectResultToString(ConnectResult result) {
+    switch (result) {
+        case ConnectResult::SUCCESS:     return "Connected";
+        case ConnectResult::AUTH_FAILED: return "Authentication failed";
+        case ConnectResult::NO_AP_FOUND: return "Network not found";
+        case ConnectResult::TIMEOUT:     return "Connection timeout";
+        case ConnectResult::CANCELLED:   return "Cancelled";
+        case ConnectResult::FAILED:      return "Connection failed";
+        default:                         return "Unknown";
+    }
+}
+
 WiFiState Flexifi::getWiFiState() const {
     return _wifiState;
 }
 
 String Flexifi::getConnectedSSID() const {
+    ApiLock lock(_apiMutex);
     if (_wifiState == WiFiState::CONNECTED) {
         return WiFi.SSID();
     }
     return "";
 }
 
+uint8_t Flexifi::getLastDisconnectReason() const {
+    return _lastDisconnectReason;
+}
+
+const char* Flexifi::disconnectReasonToString(uint8_t reason) {
+    switch (reason) {
+        case 0: return "None";
+        case WIFI_REASON_AUTH_EXPIRE: return "Authentication expired";
+        case WIFI_REASON_AUTH_LEAVE: return "Deauthenticated by AP";
+        case WIFI_REASON_ASSOC_LEAVE: return "Disassociated";
+        case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_HANDSHAKE_TIMEOUT: return "Handshake timeout (wrong password?)";
+        case WIFI_REASON_802_1X_AUTH_FAILED: return "802.1X authentication failed";
+        case WIFI_REASON_BEACON_TIMEOUT: return "Beacon timeout";
+        case WIFI_REASON_NO_AP_FOUND: return "Network not found";
+        case WIFI_REASON_AUTH_FAIL: return "Authentication failed";
+        case WIFI_REASON_ASSOC_FAIL: return "Association failed";
+        case WIFI_REASON_CONNECTION_FAIL: return "Connection failed";
+        default: return "Unspecified";
+    }
+}
+
 void Flexifi::setMinSignalQuality(int quality) {
     _minSignalQuality = quality;
     FLEXIFI_LOGD("Minimum signal quality set to: %d dBm", quality);
@@ -701,43 +1136,134 @@ int Flexifi::getMinSignalQuality() const {
     return _minSignalQuality;
 }
 
+// Roaming configuration
+void Flexifi::setRoamingEnabled(bool enabled) {
+    ApiLock lock(_apiMutex);
+    _roamingEnabled = enabled;
+    _roamWeakLink = false;
+    FLEXIFI_LOGI("Roaming %s", enabled ? "enabled" : "disabled");
+}
+
+bool Flexifi::isRoamingEnabled() const {
+    return _roamingEnabled;
+}
+
+void Flexifi::setRoamingThreshold(int rssiThreshold, int hysteresis) {
+    ApiLock lock(_apiMutex);
+    _roamRssiThreshold = rssiThreshold;
+    _roamHysteresis = hysteresis > 0 ? hysteresis : 1;
+    FLEXIFI_LOGD("Roaming threshold set to: %d dBm (hysteresis: %d dB)", rssiThreshold, _roamHysteresis);
+}
+
+void Flexifi::setRoamingIntervals(unsigned long scanInterval, unsigned long minRoamInterval) {
+    ApiLock lock(_apiMutex);
+    _roamScanInterval = scanInterval;
+    _roamMinInterval = minRoamInterval;
+    FLEXIFI_LOGD("Roaming intervals set to: scan %lu ms, roam %lu ms", scanInterval, minRoamInterval);
+}
+
+unsigned long Flexifi::getTimeBelowRoamThreshold() const {
+    return _roamTimeBelowThreshold;
+}
+
+int Flexifi::getRoamCount() const {
+    return _roamCount;
+}
+
 // Event callbacks
 void Flexifi::onPortalStart(std::function<void()> callback) {
+    ApiLock lock(_apiMutex);
     _onPortalStart = callback;
 }
 
 void Flexifi::onPortalStop(std::function<void()> callback) {
+    ApiLock lock(_apiMutex);
     _onPortalStop = callback;
 }
 
+void Flexifi::onPortalFailed(std::function<void()> callback) {
+    ApiLock lock(_apiMutex);
+    _onPortalFailed = callback;
+}
+
 void Flexifi::onWiFiConnect(std::function<void(const String&)> callback) {
+    ApiLock lock(_apiMutex);
     _onWiFiConnect = callback;
 }
 
 void Flexifi::onWiFiDisconnect(std::function<void()> callback) {
+    ApiLock lock(_apiMutex);
     _onWiFiDisconnect = callback;
 }
 
 void Flexifi::onConfigSave(std::function<void(const String&, const String&)> callback) {
+    ApiLock lock(_apiMutex);
     _onConfigSave = callback;
 }
 
 void Flexifi::onScanComplete(std::function<void(int)> callback) {
+    ApiLock lock(_apiMutex);
     _onScanComplete = callback;
 }
 
 void Flexifi::onConnectStart(std::function<void(const String&)> callback) {
+    ApiLock lock(_apiMutex);
     _onConnectStart = callback;
 }
 
 void Flexifi::onConnectFailed(std::function<void(const String&)> callback) {
+    ApiLock lock(_apiMutex);
     _onConnectFailed = callback;
 }
 
+void Flexifi::onRoamStart(std::function<void(const String&, const String&, int)> callback) {
+    ApiLock lock(_apiMutex);
+    _onRoamStart = callback;
+}
+
+void Flexifi::onRoamComplete(std::function<void(const String&, bool)> callback) {
+    ApiLock lock(_apiMutex);
+    _onRoamComplete = callback;
+}
+
 // Utility methods
 void Flexifi::loop() {
-    // Handle WiFi events
-    _handleWiFiEvents();
+    // The dedicated task drives everything in task mode
+    if (_taskHandle) {
+        return;
+    }
+    ApiLock lock(_apiMutex);
+    _runLoop();
+}
+
+void Flexifi::_runLoop() {
+    // Connection state only changes here, never on the WiFi event task
+    _drainWiFiEvents();
+    
+    // Next auto-connect profile, once the failed attempt's events are drained
+    if (_autoConnectNextPending) {
+        _advanceAutoConnect();
+    }
+    
+    // Deliver events queued for deferred subscribers
+    _eventBus.dispatchDeferred();
+    
+    // Rebuild the cached status and parameter views here so web handlers only copy a pointer
+    _refreshStatus();
+    _refreshParameterViews();
+    
+    // Execute web actions on this task rather than the AsyncTCP task
+    _processCommands();
+    
+    // Advance non-blocking portal bring-up
+    if (_startupStage != StartupStage::NONE) {
+        _advancePortalStartup();
+    }
+    
+    // Start a deferred scan once the driver has settled
+    if (_scanPending && millis() - _scanPendingSince >= FLEXIFI_SCAN_SETTLE_TIME) {
+        _startScan();
+    }
     
     // Check timeouts
     _checkTimeouts();
@@ -752,10 +1278,15 @@ void Flexifi::loop() {
     }
     
     // Only check scan status when we're actually scanning
-    if (_scanInProgress) {
+    if (_roamScanInProgress) {
+        _processRoamScan();
+    } else if (_scanInProgress) {
         _updateNetworksJSON();
     }
     
+    // Monitor link quality and roam to a stronger BSSID if needed
+    _handleRoaming();
+    
     // Periodically log generated password if portal is active and using generated password
     if (_useGeneratedPassword && _portalState == PortalState::ACTIVE && !_generatedPassword.isEmpty()) {
         static unsigned long lastPasswordLog = 0;
@@ -767,191 +1298,653 @@ void Flexifi::loop() {
     }
 }
 
-void Flexifi::reset() {
-    FLEXIFI_LOGI("Resetting Flexifi");
-    
-    // Stop portal
-    stopPortal();
-    
-    // Clear configuration
-    clearConfig();
-    clearAllWiFiProfiles();
-    
-    // Reset state
-    _wifiState = WiFiState::DISCONNECTED;
-    _currentSSID = "";
-    _currentPassword = "";
-    _autoConnectRetryCount = 0;
-    _lastAutoConnectAttempt = 0;
-    _autoConnectLimitReachedLogged = false;
-    
-    FLEXIFI_LOGI("Flexifi reset completed");
+int Flexifi::subscribe(FlexifiEventHandler handler, void* context, uint32_t eventMask, bool deferred) {
+    ApiLock lock(_apiMutex);
+    return _eventBus.subscribe(handler, context, eventMask, deferred);
 }
 
-String Flexifi::getStatusJSON() const {
-    DynamicJsonDocument doc(512);
-    doc["portal_state"] = static_cast<int>(_portalState);
-    doc["wifi_state"] = static_cast<int>(_wifiState);
-    doc["connected_ssid"] = getConnectedSSID();
-    doc["profile_count"] = getWiFiProfileCount();
-    doc["auto_connect"] = _autoConnectEnabled;
-    doc["scan_remaining"] = getScanTimeRemaining();
-    
-    // Check if scan is currently running
-    int scanStatus = WiFi.scanComplete();
-    doc["scan_in_progress"] = (scanStatus == WIFI_SCAN_RUNNING);
-    doc["scan_status"] = scanStatus;
-    doc["network_count"] = _networkCount;
-    
-    String json;
-    serializeJson(doc, json);
-    return json;
+bool Flexifi::unsubscribe(int subscriptionId) {
+    ApiLock lock(_apiMutex);
+    return _eventBus.unsubscribe(subscriptionId);
 }
 
-String Flexifi::getPortalHTML() const {
-    if (!_templateManager) {
-        return "<html><body><h1>Template Manager Not Available</h1></body></html>";
+void Flexifi::_publishEvent(FlexifiEventType type, const char* ssid, int32_t value, bool success,
+                            const char* bssid, const char* previousBssid) {
+    if (!_eventBus.hasSubscribers(type)) {
+        return;
     }
     
-    String customParams = getParametersHTML();
-    return _templateManager->getPortalHTML(customParams);
+    FlexifiEvent event;
+    event.type = type;
+    event.value = value;
+    event.success = success;
+    strlcpy(event.ssid, ssid ? ssid : "", sizeof(event.ssid));
+    strlcpy(event.bssid, bssid ? bssid : "", sizeof(event.bssid));
+    strlcpy(event.previousBssid, previousBssid ? previousBssid : "", sizeof(event.previousBssid));
+    _eventBus.publish(event);
+    
+    // A deferred subscriber may be waiting on the Flexifi task
+    _wakeTask();
 }
 
-// Private methods
-bool Flexifi::_setupAP() {
-    FLEXIFI_LOGD("Setting up access point");
-    
-    // Stop any existing WiFi connections
-    WiFi.disconnect();
-    
-    // Set WiFi mode to Access Point + Station
-    WiFi.mode(WIFI_AP_STA);
-    delay(100);
-    
-    // Configure and start access point
-    bool result;
-    if (_apPassword.isEmpty()) {
-        result = WiFi.softAP(_apName.c_str());
-    } else {
-        result = WiFi.softAP(_apName.c_str(), _apPassword.c_str());
+bool Flexifi::_postCommand(FlexifiCommand&& command) {
+    if (!_commandQueue.push(std::move(command))) {
+        FLEXIFI_LOGW("Command queue full, dropping request");
+        return false;
+    }
+    _wakeTask();
+    return true;
+}
+
+bool Flexifi::startTask(uint32_t stackSize, UBaseType_t priority, BaseType_t core) {
+    if (_taskHandle) {
+        FLEXIFI_LOGW("Flexifi task already running");
+        return false;
     }
     
-    if (!result) {
-        FLEXIFI_LOGE("Failed to start access point");
+    // Kept until destruction so a stopped task can be restarted
+    if (!_taskEvents) {
+        _taskEvents = xEventGroupCreate();
+    }
+    if (!_apiMutex || !_taskEvents) {
+        FLEXIFI_LOGE("Failed to allocate task resources");
         return false;
     }
     
-    FLEXIFI_LOGI("Access point started - IP: %s", WiFi.softAPIP().toString().c_str());
+    xEventGroupClearBits(_taskEvents, TASK_BIT_STOP | TASK_BIT_STOPPED);
     
-    // Start DNS server for captive portal
-    if (!_dnsServer) {
-        _dnsServer = new DNSServer();
+    if (xTaskCreatePinnedToCore(_taskMain, "flexifi", stackSize, this, priority, &_taskHandle, core) != pdPASS) {
+        FLEXIFI_LOGE("Failed to create Flexifi task");
+        _taskHandle = nullptr;
+        return false;
     }
-    _dnsServer->start(53, "*", WiFi.softAPIP());
-    FLEXIFI_LOGI("DNS server started for captive portal");
-    
-    // Start initial network scan
-    delay(500); // Give AP time to fully initialize
-    FLEXIFI_LOGI("Initiating first network scan after AP setup");
-    scanNetworks(); // This will start async scan
     
+    FLEXIFI_LOGI("Flexifi task started (stack: %u, priority: %u, core: %d)", 
+                 (unsigned)stackSize, (unsigned)priority, (int)core);
     return true;
 }
 
-void Flexifi::_stopAP() {
-    FLEXIFI_LOGD("Stopping access point");
+void Flexifi::stopTask() {
+    if (!_taskHandle) {
+        return;
+    }
     
-    if (_dnsServer) {
-        _dnsServer->stop();
-        delete _dnsServer;
-        _dnsServer = nullptr;
+    if (xTaskGetCurrentTaskHandle() == _taskHandle) {
+        FLEXIFI_LOGW("stopTask() cannot be called from a Flexifi callback");
+        return;
     }
     
-    WiFi.softAPdisconnect(true);
-    WiFi.mode(WIFI_STA);
+    xEventGroupSetBits(_taskEvents, TASK_BIT_STOP);
+    xEventGroupWaitBits(_taskEvents, TASK_BIT_STOPPED, pdTRUE, pdFALSE, portMAX_DELAY);
+    _taskHandle = nullptr;
     
-    FLEXIFI_LOGI("Access point stopped");
+    // Events queued while the task was shutting down are handled by the next loop()
+    FLEXIFI_LOGI("Flexifi task stopped");
 }
 
-void Flexifi::_handleWiFiEvents() {
-    // Handle connection
-    if (_wifiState == WiFiState::CONNECTING) {
-        unsigned long now = millis();
+bool Flexifi::isTaskRunning() const {
+    return _taskHandle != nullptr;
+}
+
+bool Flexifi::tryLockApi(unsigned long timeoutMs) const {
+    if (!_apiMutex) {
+        return true;
+    }
+    return xSemaphoreTakeRecursive(_apiMutex, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void Flexifi::unlockApi() const {
+    if (_apiMutex) {
+        xSemaphoreGiveRecursive(_apiMutex);
+    }
+}
+
+void Flexifi::_taskMain(void* arg) {
+    Flexifi* self = static_cast<Flexifi*>(arg);
+    
+    for (;;) {
+        TickType_t wait;
+        {
+            ApiLock lock(self->_apiMutex);
+            wait = self->_nextWakeTicks();
+        }
         
-        // Check for timeout
-        if (now - _connectStartTime > _connectTimeout) {
-            FLEXIFI_LOGW("WiFi connection timeout");
-            _onWiFiStateChange(WiFiState::FAILED);
-            
-            // Trigger callback
-            if (_onConnectFailed) {
-                _onConnectFailed(_currentSSID);
+        // Sleep until a command or WiFi event arrives, or the next deadline is due
+        EventBits_t bits = xEventGroupWaitBits(self->_taskEvents, TASK_BIT_WAKE | TASK_BIT_STOP, 
+                                               pdTRUE, pdFALSE, wait);
+        if (bits & TASK_BIT_STOP) {
+            break;
+        }
+        
+        ApiLock lock(self->_apiMutex);
+        self->_runLoop();
+    }
+    
+    xEventGroupSetBits(self->_taskEvents, TASK_BIT_STOPPED);
+    vTaskDelete(nullptr);
+}
+
+void Flexifi::_wakeTask() {
+    if (_taskHandle) {
+        xEventGroupSetBits(_taskEvents, TASK_BIT_WAKE);
+    }
+}
+
+void Flexifi::_drainWiFiEvents() {
+    if (!_wifiEventQueue) {
+        return;
+    }
+    
+    WiFiEventRecord record;
+    while (xQueueReceive(_wifiEventQueue, &record, 0) == pdTRUE) {
+        _handleWiFiEvent(record);
+    }
+}
+
+TickType_t Flexifi::_nextWakeTicks() const {
+    // Commands and WiFi events (AP started, scan done, connect/disconnect) set the wake bit,
+    // so only the settle delays and deadlines below need a timeout
+    if (!_commandQueue.empty() || _autoConnectNextPending) {
+        return 0;
+    }
+    
+    unsigned long wait = FLEXIFI_TASK_MAX_WAIT;
+    unsigned long now = millis();
+    
+    // Portal bring-up; AP_START usually ends the mode settle wait early
+    if (_startupStage != StartupStage::NONE) {
+        unsigned long delay = (_startupStage == StartupStage::WAIT_MODE) ? 
+            FLEXIFI_AP_SETTLE_TIME : FLEXIFI_INITIAL_SCAN_DELAY;
+        unsigned long elapsed = now - _startupStageTime;
+        wait = min(wait, (elapsed < delay) ? (delay - elapsed + 1) : 0);
+    }
+    
+    // Deferred scan start
+    if (_scanPending) {
+        unsigned long elapsed = now - _scanPendingSince;
+        unsigned long remaining = (elapsed < FLEXIFI_SCAN_SETTLE_TIME) ? (FLEXIFI_SCAN_SETTLE_TIME - elapsed + 1) : 0;
+        wait = min(wait, remaining);
+    }
+    
+    // Connection deadline
+    if (_wifiState == WiFiState::CONNECTING) {
+        unsigned long elapsed = now - _connectStartTime;
+        unsigned long remaining = (elapsed < _connectDeadline) ? (_connectDeadline - elapsed + 1) : 0;
+        wait = min(wait, remaining);
+    }
+    
+    // Portal timeout
+    if (_portalState == PortalState::ACTIVE && _portalTimeout > 0) {
+        unsigned long elapsed = now - _portalStartTime;
+        unsigned long remaining = (elapsed < _portalTimeout) ? (_portalTimeout - elapsed + 1) : 0;
+        wait = min(wait, remaining);
+    }
+    
+    // RSSI sampling for roaming
+    if (_roamingEnabled && _wifiState == WiFiState::CONNECTED) {
+        wait = min(wait, (unsigned long)FLEXIFI_ROAM_CHECK_INTERVAL);
+    }
+    
+    return pdMS_TO_TICKS(wait);
+}
+
+void Flexifi::_processCommands() {
+    FlexifiCommand command;
+    while (_commandQueue.pop(command)) {
+        switch (command.type) {
+            case FlexifiCommandType::SCAN: {
+                bool started = scanNetworks();
+                if (command.clientId && _portalServer) {
+                    if (started) {
+                        _portalServer->sendResponse(command.clientId, true, "Scan initiated");
+                    } else {
+                        _portalServer->sendResponse(command.clientId, false, 
+                            "Scan throttled. Please wait " + String(getScanTimeRemaining() / 1000) + " more seconds.");
+                    }
+                }
+                break;
             }
             
-            // Notify via WebSocket
-            if (_portalServer) {
-                _portalServer->broadcastMessage("connect_failed", "Connection timeout");
+            case FlexifiCommandType::CONNECT: {
+                for (const auto& parameter : command.parameters) {
+                    setParameterValue(parameter.first, parameter.second);
+                }
+                bool started = connectToWiFi(command.ssid, command.password);
+                if (command.clientId && _portalServer) {
+                    _portalServer->sendResponse(command.clientId, started, 
+                        started ? "Connection initiated" : "Failed to initiate connection");
+                }
+                break;
             }
-            return;
-        }
-        
-        // Check connection status
-        wl_status_t status = WiFi.status();
-        
-        if (status == WL_CONNECTED) {
-            FLEXIFI_LOGI("WiFi connected successfully");
-            _onWiFiStateChange(WiFiState::CONNECTED);
             
-            // Save configuration
-            saveConfig();
+            case FlexifiCommandType::RESET:
+                reset();
+                if (command.clientId && _portalServer) {
+                    _portalServer->sendResponse(command.clientId, true, "Configuration reset");
+                }
+                break;
             
-            // Start mDNS if enabled
-            _startMDNS();
+            case FlexifiCommandType::STATUS:
+                if (command.clientId && _portalServer) {
+                    _portalServer->sendToClient(command.clientId, getStatusJSON());
+                }
+                break;
             
-            // Trigger callback
-            if (_onWiFiConnect) {
-                _onWiFiConnect(_currentSSID);
+            default:
+                break;
+        }
+    }
+}
+
+void Flexifi::reset() {
+    ApiLock lock(_apiMutex);
+    FLEXIFI_LOGI("Resetting Flexifi");
+    
+    // Stop portal
+    stopPortal();
+    
+    // Clear configuration
+    clearConfig();
+    clearAllWiFiProfiles();
+    
+    // Reset state
+    cancelConnect();
+    _autoConnectQueue.clear();
+    _autoConnectHandle = 0;
+    _autoConnectNextPending = false;
+    _roamInProgress = false;
+    _roamRecovery = false;
+    _roamTargetBSSID = "";
+    _wifiState = WiFiState::DISCONNECTED;
+    _currentSSID = "";
+    _currentPassword = "";
+    _touchStatus();
+    resetAutoConnectBackoff();
+    
+    FLEXIFI_LOGI("Flexifi reset completed");
+}
+
+String Flexifi::getStatusJSON() const {
+    return *getStatusJSONShared();
+}
+
+std::shared_ptr<const String> Flexifi::getStatusJSONShared() const {
+    // Lock-free for web handlers; only loop() or the Flexifi task rebuilds the snapshot
+    std::shared_ptr<const String> json = std::atomic_load(&_statusJSON);
+    return json ? json : std::make_shared<const String>("{}");
+}
+
+FlexifiStatus Flexifi::getStatus() const {
+    ApiLock lock(_apiMutex);
+    return _status;
+}
+
+uint32_t Flexifi::getStatusVersion() const {
+    return _status.version;
+}
+
+void Flexifi::_touchStatus() {
+    _status.portalState = _portalState;
+    _status.wifiState = _wifiState;
+    _status.autoConnect = _autoConnectEnabled;
+    _status.scanInProgress = _scanInProgress || _scanPending;
+    _status.networkCount = _networkCount;
+    _status.version++;
+}
+
+void Flexifi::_refreshStatus() {
+    // The throttle countdown is reported with one-second resolution
+    unsigned long scanRemaining = getScanTimeRemaining();
+    unsigned long scanSeconds = (scanRemaining + 999) / 1000;
+    
+    if (_statusJSON && _statusJSONVersion == _status.version && _statusJSONScanSeconds == scanSeconds) {
+        return;
+    }
+    
+    // Expensive fields are only recomputed when the snapshot is rebuilt
+    if (_statusProfilesDirty && _storage) {
+        _status.profileCount = _storage->getProfileCount();
+        _statusProfilesDirty = false;
+    }
+    _status.connectedSSID = (_status.wifiState == WiFiState::CONNECTED) ? WiFi.SSID() : String("");
+    
+    DynamicJsonDocument doc(512);
+    doc["version"] = _status.version;
+    doc["portal_state"] = static_cast<int>(_status.portalState);
+    doc["wifi_state"] = static_cast<int>(_status.wifiState);
+    doc["connected_ssid"] = _status.connectedSSID;
+    doc["profile_count"] = _status.profileCount;
+    doc["auto_connect"] = _status.autoConnect;
+    doc["scan_remaining"] = scanRemaining;
+    doc["scan_in_progress"] = _status.scanInProgress;
+    doc["scan_status"] = _status.scanInProgress ? WIFI_SCAN_RUNNING : WIFI_SCAN_FAILED;
+    doc["network_count"] = _status.networkCount;
+    
+    String* json = new String();
+    serializeJson(doc, *json);
+    std::atomic_store(&_statusJSON, std::shared_ptr<const String>(json));
+    _statusJSONVersion = _status.version;
+    _statusJSONScanSeconds = scanSeconds;
+}
+
+String Flexifi::getPortalHTML() const {
+    ApiLock lock(_apiMutex);
+    std::shared_ptr<TemplateStream> stream = createPortalStream();
+    if (!stream) {
+        return "<html><body><h1>Template Manager Not Available</h1></body></html>";
+    }
+    
+    StreamString html;
+    stream->renderTo(html);
+    return html;
+}
+
+std::shared_ptr<TemplateStream> Flexifi::createPortalStream() const {
+    ApiLock lock(_apiMutex);
+    if (!_templateManager) {
+        return nullptr;
+    }
+    return _templateManager->createStream(std::make_shared<FlexifiTemplateData>(this));
+}
+
+const uint8_t* Flexifi::getPrerenderedPortalHTML(size_t& length) const {
+    // Flash data selected atomically by the template manager; no lock needed
+    length = 0;
+    return _templateManager ? _templateManager->getPrerenderedPage(length) : nullptr;
+}
+
+std::shared_ptr<const FlexifiRenderedPage> Flexifi::getRenderedPortalHTML() const {
+    ApiLock lock(_apiMutex);
+    if (!_templateManager) {
+        return nullptr;
+    }
+    // Templates render the scan table and the parameter views; nothing else they show changes.
+    // Both counters go into the key unchanged, so two different states never share it
+    uint64_t dataVersion = ((uint64_t)_scanGeneration << 32) | _parameterViewsRevision;
+    return _templateManager->getRenderedPage(dataVersion, std::make_shared<FlexifiTemplateData>(this));
+}
+
+bool Flexifi::getAsset(const String& path, FlexifiAsset& asset) const {
+    return _templateManager && _templateManager->getAsset(path, asset);
+}
+
+// Private methods
+void Flexifi::_beginAPSetup() {
+    FLEXIFI_LOGD("Setting up access point");
+    
+    // Stop any existing WiFi connections
+    WiFi.disconnect();
+    
+    // Set WiFi mode to Access Point + Station; the AP is started once the mode has settled
+    _apModeReady = false;
+    WiFi.mode(WIFI_AP_STA);
+    
+    _onPortalStateChange(PortalState::STARTING);
+    _startupStage = StartupStage::WAIT_MODE;
+    _startupStageTime = millis();
+}
+
+void Flexifi::_advancePortalStartup() {
+    unsigned long elapsed = millis() - _startupStageTime;
+    
+    switch (_startupStage) {
+        case StartupStage::WAIT_MODE:
+            if (!_apModeReady && elapsed < FLEXIFI_AP_SETTLE_TIME) {
+                return;
             }
             
-            // Notify via WebSocket
-            if (_portalServer) {
-                _portalServer->broadcastMessage("connect_success", "Connected to " + _currentSSID);
+            if (!_startAP()) {
+                FLEXIFI_LOGE("Failed to set up access point");
+                _startupStage = StartupStage::NONE;
+                _stopAP();
+                _onPortalStateChange(PortalState::STOPPED);
+                
+                // startPortal() already returned true, so this is the caller's only signal
+                if (_onPortalFailed) {
+                    _onPortalFailed();
+                }
+                _publishEvent(FlexifiEventType::PORTAL_FAILED);
+                return;
             }
             
-        } else if (status == WL_CONNECT_FAILED || status == WL_NO_SSID_AVAIL) {
-            FLEXIFI_LOGW("WiFi connection failed");
-            _onWiFiStateChange(WiFiState::FAILED);
+            _portalStartTime = millis();
+            _onPortalStateChange(PortalState::ACTIVE);
+            _startupStage = StartupStage::WAIT_SCAN;
+            _startupStageTime = millis();
             
-            // Trigger callback
-            if (_onConnectFailed) {
-                _onConnectFailed(_currentSSID);
+            // Trigger portal start callback
+            if (_onPortalStart) {
+                _onPortalStart();
             }
+            _publishEvent(FlexifiEventType::PORTAL_START);
             
-            // Notify via WebSocket
-            if (_portalServer) {
-                _portalServer->broadcastMessage("connect_failed", "Failed to connect to " + _currentSSID);
+            FLEXIFI_LOGI("Portal started successfully");
+            break;
+            
+        case StartupStage::WAIT_SCAN:
+            // Give the AP time to fully initialize before the first scan
+            if (elapsed < FLEXIFI_INITIAL_SCAN_DELAY) {
+                return;
             }
-        }
+            
+            _startupStage = StartupStage::NONE;
+            FLEXIFI_LOGI("Initiating first network scan after AP setup");
+            scanNetworks(); // This will start async scan
+            break;
+            
+        case StartupStage::NONE:
+            break;
+    }
+}
+
+bool Flexifi::_startAP() {
+    // Configure and start access point
+    bool result;
+    if (_apPassword.isEmpty()) {
+        result = WiFi.softAP(_apName.c_str());
+    } else {
+        result = WiFi.softAP(_apName.c_str(), _apPassword.c_str());
     }
     
-    // Handle disconnection
-    if (_wifiState == WiFiState::CONNECTED && WiFi.status() != WL_CONNECTED) {
-        FLEXIFI_LOGW("WiFi disconnected");
-        _onWiFiStateChange(WiFiState::DISCONNECTED);
-        
-        // Stop mDNS on disconnection
-        _stopMDNS();
-        
-        // Trigger callback
-        if (_onWiFiDisconnect) {
-            _onWiFiDisconnect();
-        }
+    if (!result) {
+        FLEXIFI_LOGE("Failed to start access point");
+        return false;
+    }
+    
+    FLEXIFI_LOGI("Access point started - IP: %s", WiFi.softAPIP().toString().c_str());
+    
+    // Start DNS server for captive portal
+    if (!_dnsServer) {
+        _dnsServer = new DNSServer();
+    }
+    _dnsServer->start(53, "*", WiFi.softAPIP());
+    FLEXIFI_LOGI("DNS server started for captive portal");
+    
+    return true;
+}
+
+void Flexifi::_stopAP() {
+    FLEXIFI_LOGD("Stopping access point");
+    
+    if (_dnsServer) {
+        _dnsServer->stop();
+        delete _dnsServer;
+        _dnsServer = nullptr;
+    }
+    
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(WIFI_STA);
+    
+    FLEXIFI_LOGI("Access point stopped");
+}
+
+void Flexifi::_handleConnectSuccess(bool newConnection) {
+    _lastDisconnectReason = 0;
+    _onWiFiStateChange(WiFiState::CONNECTED);
+    resetAutoConnectBackoff();
+    
+    if (_roamInProgress) {
+        _finishRoam(true);
+        return;
+    }
+    
+    if (_roamRecovery) {
+        // Back on the network we had before the roam; nothing to persist or announce
+        _roamRecovery = false;
+        FLEXIFI_LOGI("Reconnected to %s after failed roam (BSSID: %s)", 
+                     _currentSSID.c_str(), WiFi.BSSIDstr().c_str());
+        return;
+    }
+    
+    FLEXIFI_LOGI("WiFi connected successfully (IP: %s)", WiFi.localIP().toString().c_str());
+    
+    // Save configuration only for connections we initiated
+    if (newConnection) {
+        saveConfig();
+    }
+    
+    // Start mDNS if enabled
+    _startMDNS();
+    
+    // Trigger callback
+    if (_onWiFiConnect) {
+        _onWiFiConnect(_currentSSID);
+    }
+    _publishEvent(FlexifiEventType::WIFI_CONNECT, _currentSSID.c_str(), 0, true, WiFi.BSSIDstr().c_str());
+    
+    // Notify via WebSocket
+    if (_portalServer) {
+        _portalServer->broadcastMessage("connect_success", "Connected to " + _currentSSID);
+    }
+    
+    _completeConnect(ConnectResult::SUCCESS, 0);
+}
+
+void Flexifi::_handleConnectFailure(uint8_t reason) {
+    _lastDisconnectReason = reason;
+    
+    if (_roamInProgress) {
+        _finishRoam(false);
+        return;
+    }
+    
+    if (_roamRecovery) {
+        // The link from before the roam is gone; report it like any other drop
+        _roamRecovery = false;
+        _handleLinkLost(reason);
+        return;
+    }
+    
+    const char* reasonText = reason ? disconnectReasonToString(reason) : "Connection timeout";
+    FLEXIFI_LOGW("WiFi connection failed: %s (reason %d)", reasonText, reason);
+    _onWiFiStateChange(WiFiState::FAILED);
+    
+    // Trigger callback
+    if (_onConnectFailed) {
+        _onConnectFailed(_currentSSID);
+    }
+    _publishEvent(FlexifiEventType::CONNECT_FAILED, _currentSSID.c_str(), reason);
+    
+    // Notify via WebSocket
+    if (_portalServer) {
+        _portalServer->broadcastMessage("connect_failed", 
+            "Failed to connect to " + _currentSSID + ": " + reasonText);
+    }
+    
+    ConnectResult result;
+    switch (reason) {
+        case 0:
+            result = ConnectResult::TIMEOUT;
+            break;
+        case WIFI_REASON_NO_AP_FOUND:
+            result = ConnectResult::NO_AP_FOUND;
+            break;
+        case WIFI_REASON_AUTH_FAIL:
+        case WIFI_REASON_AUTH_EXPIRE:
+        case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_802_1X_AUTH_FAILED:
+            result = ConnectResult::AUTH_FAILED;
+            break;
+        default:
+            result = ConnectResult::FAILED;
+            break;
+    }
+    _completeConnect(result, reason);
+}
+
+void Flexifi::_completeConnect(ConnectResult result, uint8_t reason) {
+    if (_connectHandle == 0) {
+        return;
+    }
+    
+    ConnectOutcome outcome;
+    outcome.handle = _connectHandle;
+    outcome.result = result;
+    outcome.reason = reason;
+    outcome.elapsed = millis() - _connectStartTime;
+    outcome.ssid = _currentSSID;
+    outcome.bssid = (result == ConnectResult::SUCCESS) ? WiFi.BSSIDstr() : String("");
+    
+    // Clear before invoking so the callback may start the next attempt
+    ConnectCallback callback = _connectCallback;
+    _connectCallback = nullptr;
+    _connectHandle = 0;
+    
+    FLEXIFI_LOGD("Connect attempt %u finished: %s after %lu ms", 
+                 (unsigned)outcome.handle, connectResultToString(result), outcome.elapsed);
+    
+    if (callback) {
+        callback(outcome);
+    }
+}
+
+void Flexifi::_handleLinkLost(uint8_t reason) {
+    _lastDisconnectReason = reason;
+    FLEXIFI_LOGW("WiFi disconnected: %s (reason %d)", disconnectReasonToString(reason), reason);
+    _onWiFiStateChange(WiFiState::DISCONNECTED);
+    
+    // Start a fresh backoff cycle, but spread the first retry so a fleet losing
+    // the same AP does not reconnect in lockstep
+    resetAutoConnectBackoff();
+    _lastAutoConnectAttempt = millis();
+    _autoConnectDelay = _computeBackoffDelay(1);
+    
+    // Stop mDNS on disconnection
+    _stopMDNS();
+    
+    // Trigger callback
+    if (_onWiFiDisconnect) {
+        _onWiFiDisconnect();
+    }
+    _publishEvent(FlexifiEventType::WIFI_DISCONNECT, _currentSSID.c_str(), reason);
+}
+
+bool Flexifi::_isConnectFailureReason(uint8_t reason) {
+    // Reasons that will not resolve by waiting for the driver to retry
+    switch (reason) {
+        case WIFI_REASON_AUTH_EXPIRE:
+        case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_802_1X_AUTH_FAILED:
+        case WIFI_REASON_NO_AP_FOUND:
+        case WIFI_REASON_AUTH_FAIL:
+        case WIFI_REASON_ASSOC_FAIL:
+        case WIFI_REASON_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_CONNECTION_FAIL:
+            return true;
+        default:
+            return false;
     }
 }
 
 void Flexifi::_checkTimeouts() {
     unsigned long now = millis();
     
+    // Connection deadline; success and definitive failures arrive via WiFi events
+    if (_wifiState == WiFiState::CONNECTING && now - _connectStartTime > _connectDeadline) {
+        _handleConnectFailure(0);
+    }
+    
     // Check portal timeout
     if (_portalState == PortalState::ACTIVE && _portalTimeout > 0 && 
         now - _portalStartTime > _portalTimeout) {
@@ -1001,10 +1994,12 @@ void Flexifi::_updateNetworksJSON() {
         }
         FLEXIFI_LOGI("=== END ALL NETWORKS ===");
         
-        // Build JSON array with quality filtering - increased size for large network lists
-        DynamicJsonDocument doc(8192);
+        // Build JSON array with quality filtering, sized for the whole scan (SSIDs are at most 32 bytes)
+        DynamicJsonDocument doc(JSON_ARRAY_SIZE(scanResult) + scanResult * (JSON_OBJECT_SIZE(5) + 33 + 2));
         JsonArray networks = doc.to<JsonArray>();
         int filteredCount = 0;
+        std::vector<FlexifiNetwork> table;
+        table.reserve(scanResult);
         
         for (int i = 0; i < scanResult; i++) {
             int rssi = WiFi.RSSI(i);
@@ -1027,6 +2022,7 @@ void Flexifi::_updateNetworksJSON() {
             network["secure"] = (WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
             network["channel"] = WiFi.channel(i);
             network["signal_strength"] = _getSignalStrengthIcon(rssi);
+            table.push_back({ssid, rssi, (uint8_t)WiFi.channel(i), WiFi.encryptionType(i) != WIFI_AUTH_OPEN});
             filteredCount++;
             
             // Debug: Log networks that pass the filter
@@ -1036,8 +2032,14 @@ void Flexifi::_updateNetworksJSON() {
         _networkCount = filteredCount;
         
         // Clear and rebuild the JSON string
-        _networksJSON = "";
-        serializeJson(doc, _networksJSON);
+        String* json = new String();
+        serializeJson(doc, *json);
+        std::shared_ptr<const String> networksJSON(json);
+        std::atomic_store(&_networksJSON, networksJSON);
+        // Pages already streaming keep the table they started with
+        std::atomic_store(&_networks, std::shared_ptr<const std::vector<FlexifiNetwork>>(
+            new std::vector<FlexifiNetwork>(std::move(table))));
+        _scanGeneration++;
         
         // Clear scan results
         WiFi.scanDelete();
@@ -1046,17 +2048,19 @@ void Flexifi::_updateNetworksJSON() {
         if (_onScanComplete) {
             _onScanComplete(filteredCount);
         }
+        _publishEvent(FlexifiEventType::SCAN_COMPLETE, nullptr, filteredCount);
         
         FLEXIFI_LOGI("Network scan completed: %d total, %d after filtering", scanResult, filteredCount);
         
         // Reset scan time to prevent immediate re-scanning
         _lastScanTime = millis();
         _scanInProgress = false;
+        _touchStatus();
         
         // Notify via WebSocket
         if (_portalServer) {
-            FLEXIFI_LOGI("📡 Broadcasting networks via WebSocket: %s", _networksJSON.substring(0, 100).c_str());
-            _portalServer->broadcastNetworks(_networksJSON);
+            FLEXIFI_LOGI("📡 Broadcasting networks via WebSocket: %s", networksJSON->substring(0, 100).c_str());
+            _portalServer->broadcastNetworks(*networksJSON);
         } else {
             FLEXIFI_LOGW("⚠️ Portal server not available for WebSocket broadcast");
         }
@@ -1104,29 +2108,296 @@ bool Flexifi::_validateCredentials(const String& ssid, const String& password) {
 
 void Flexifi::_setupWiFiEvents() {
     FLEXIFI_LOGD("Setting up WiFi event handlers");
-    WiFi.onEvent(_onWiFiEvent);
+    
+    // Events are queued by the handler and processed by loop() or the Flexifi task
+    _wifiEventQueue = xQueueCreate(WIFI_EVENT_QUEUE_LENGTH, sizeof(WiFiEventRecord));
+    if (!_wifiEventQueue) {
+        FLEXIFI_LOGE("Failed to allocate WiFi event queue");
+        return;
+    }
+    
+    // Registered per instance; the id lets the destructor unregister it
+    _wifiEventId = WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+        _onWiFiEvent(event, info);
+    });
+    _wifiEventRegistered = true;
 }
 
 void Flexifi::_onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info) {
-    if (!_instance) return;
+    
+    WiFiEventRecord record;
+    record.event = event;
+    record.reason = 0;
+    record.channel = 0;
+    record.attempt = _connectAttempt;
     
     switch (event) {
+        case ARDUINO_EVENT_WIFI_SCAN_DONE:
+        case ARDUINO_EVENT_WIFI_AP_START:
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            break;
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            record.channel = info.wifi_sta_connected.channel;
+            break;
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            record.reason = info.wifi_sta_disconnected.reason;
+            break;
+        default:
+            return;
+    }
+    
+    // Runs on the WiFi event task; state is only touched by loop() or the Flexifi task
+    if (xQueueSend(_wifiEventQueue, &record, 0) != pdTRUE) {
+        FLEXIFI_LOGW("WiFi event queue full, dropping event %d", (int)event);
+    }
+    _wakeTask();
+}
+
+void Flexifi::_handleWiFiEvent(const WiFiEventRecord& record) {
+    switch (record.event) {
         case ARDUINO_EVENT_WIFI_SCAN_DONE:
             FLEXIFI_LOGD("WiFi scan completed event received");
-            _instance->_updateNetworksJSON();
+            if (_roamScanInProgress) {
+                _processRoamScan();
+                break;
+            }
+            _updateNetworksJSON();
             
             // Call internal scan completion callback if set
-            if (_instance->_onInternalScanComplete) {
-                _instance->_onInternalScanComplete(_instance->_networkCount);
+            if (_onInternalScanComplete) {
+                _onInternalScanComplete(_networkCount);
+            }
+            break;
+            
+        case ARDUINO_EVENT_WIFI_AP_START:
+            // Mode switch completed; loop() can bring up the portal AP without waiting
+            _apModeReady = true;
+            break;
+            
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            FLEXIFI_LOGD("WiFi associated, waiting for IP (channel %d)", record.channel);
+            break;
+            
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+            if (_wifiState == WiFiState::CONNECTING) {
+                _handleConnectSuccess(true);
+            } else if (_wifiState != WiFiState::CONNECTED) {
+                // Link restored by the driver's own reconnect
+                _handleConnectSuccess(false);
+            }
+            break;
+            
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED: {
+            uint8_t reason = record.reason;
+            FLEXIFI_LOGD("WiFi disconnected event (reason %d)", reason);
+            
+            if (_wifiState == WiFiState::CONNECTING) {
+                // The driver repeats NO_AP_FOUND/AUTH_FAIL; copies still queued from an
+                // earlier attempt must not fail the one that replaced it
+                if (record.attempt != _connectAttempt) {
+                    FLEXIFI_LOGD("Ignoring disconnect from a previous connection attempt");
+                } else if (_isConnectFailureReason(reason)) {
+                    _handleConnectFailure(reason);
+                } else {
+                    // Ignore transient drops (e.g. leaving the previous AP) until the deadline
+                    _lastDisconnectReason = reason;
+                }
+            } else if (_wifiState == WiFiState::CONNECTED) {
+                _handleLinkLost(reason);
+            }
+            break;
+        }
+            
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            if (_wifiState == WiFiState::CONNECTED) {
+                _handleLinkLost(0);
             }
             break;
             
         default:
-            // We only care about scan completion for now
             break;
     }
 }
 
+// Roaming implementation
+void Flexifi::_handleRoaming() {
+    if (!_roamingEnabled || _wifiState != WiFiState::CONNECTED || _roamInProgress) {
+        _lastRoamCheck = 0;
+        return;
+    }
+    
+    unsigned long now = millis();
+    if (_lastRoamCheck != 0 && now - _lastRoamCheck < FLEXIFI_ROAM_CHECK_INTERVAL) {
+        return;
+    }
+    
+    unsigned long elapsed = (_lastRoamCheck != 0) ? now - _lastRoamCheck : 0;
+    _lastRoamCheck = now;
+    
+    int rssi = WiFi.RSSI();
+    if (rssi == 0) {
+        return; // Not associated yet
+    }
+    
+    if (rssi < _roamRssiThreshold) {
+        _roamTimeBelowThreshold += elapsed;
+    }
+    
+    // Arm below the threshold, disarm only once the link recovers past the hysteresis band
+    bool weakLink = FlexifiRoamPolicy::weakLink(_roamWeakLink, rssi, _roamRssiThreshold, _roamHysteresis);
+    if (weakLink && !_roamWeakLink) {
+        FLEXIFI_LOGI("📉 Link RSSI %d dBm below roaming threshold %d dBm", rssi, _roamRssiThreshold);
+    } else if (!weakLink && _roamWeakLink) {
+        FLEXIFI_LOGI("📈 Link RSSI recovered to %d dBm", rssi);
+    }
+    _roamWeakLink = weakLink;
+    
+    if (!_roamWeakLink || _roamScanInProgress || _scanInProgress) {
+        return;
+    }
+    
+    if (FlexifiRoamPolicy::scanAllowed(now, _lastRoamScan, _roamScanInterval, _lastRoamTime, _roamMinInterval)) {
+        _startRoamScan();
+    }
+}
+
+bool Flexifi::_startRoamScan() {
+    String ssid = WiFi.SSID();
+    if (ssid.isEmpty()) {
+        return false;
+    }
+    
+    FLEXIFI_LOGI("🔍 Starting roaming scan for BSSIDs of: %s", ssid.c_str());
+    _lastRoamScan = millis();
+    
+    // Targeted async scan limited to the connected SSID
+    int16_t result = WiFi.scanNetworks(true, false, false, 120, 0, ssid.c_str());
+    if (result == WIFI_SCAN_FAILED) {
+        FLEXIFI_LOGW("Roaming scan failed to start");
+        return false;
+    }
+    
+    _roamScanInProgress = true;
+    return true;
+}
+
+void Flexifi::_processRoamScan() {
+    int16_t count = WiFi.scanComplete();
+    if (count == WIFI_SCAN_RUNNING) {
+        return;
+    }
+    
+    _roamScanInProgress = false;
+    
+    if (count < 0) {
+        FLEXIFI_LOGW("Roaming scan failed (result: %d)", count);
+        return;
+    }
+    
+    if (_wifiState != WiFiState::CONNECTED) {
+        WiFi.scanDelete();
+        return;
+    }
+    
+    String ssid = WiFi.SSID();
+    int currentRssi = WiFi.RSSI();
+    uint8_t current[6] = {0};
+    uint8_t* currentBSSID = WiFi.BSSID();
+    if (currentBSSID) {
+        memcpy(current, currentBSSID, sizeof(current));
+    }
+    
+    // Candidate must beat the current link by at least the hysteresis margin
+    int best = -1;
+    int bestRssi = 0;
+    for (int i = 0; i < count; i++) {
+        if (WiFi.SSID(i) != ssid) {
+            continue;
+        }
+        
+        uint8_t* bssid = WiFi.BSSID(i);
+        if (!bssid || memcmp(bssid, current, sizeof(current)) == 0) {
+            continue;
+        }
+        
+        int rssi = WiFi.RSSI(i);
+        if (FlexifiRoamPolicy::isBetterCandidate(rssi, currentRssi, _roamHysteresis) && 
+            (best < 0 || rssi > bestRssi)) {
+            best = i;
+            bestRssi = rssi;
+        }
+    }
+    
+    if (best < 0) {
+        FLEXIFI_LOGD("No stronger BSSID found for %s (current: %d dBm)", ssid.c_str(), currentRssi);
+        WiFi.scanDelete();
+        return;
+    }
+    
+    uint8_t target[6];
+    memcpy(target, WiFi.BSSID(best), sizeof(target));
+    int32_t channel = WiFi.channel(best);
+    WiFi.scanDelete();
+    
+    String fromBSSID = _formatBSSID(current);
+    _roamTargetBSSID = _formatBSSID(target);
+    
+    FLEXIFI_LOGI("📶 Roaming from %s (%d dBm) to %s (%d dBm, ch %d)", 
+                 fromBSSID.c_str(), currentRssi, _roamTargetBSSID.c_str(), bestRssi, (int)channel);
+    
+    _roamInProgress = true;
+    _lastRoamTime = millis();
+    
+    if (_onRoamStart) {
+        _onRoamStart(fromBSSID, _roamTargetBSSID, bestRssi);
+    }
+    _publishEvent(FlexifiEventType::ROAM_START, ssid.c_str(), bestRssi, false, 
+                  _roamTargetBSSID.c_str(), fromBSSID.c_str());
+    
+    // Reassociate pinned to the chosen BSSID; completion is detected like a normal connect
+    _connectStartTime = millis();
+    _connectDeadline = _connectTimeout;
+    _onWiFiStateChange(WiFiState::CONNECTING);
+    _connectAttempt++;
+    WiFi.begin(ssid.c_str(), _currentPassword.c_str(), channel, target);
+}
+
+void Flexifi::_finishRoam(bool success) {
+    String bssid = _roamTargetBSSID;
+    _roamInProgress = false;
+    _roamTargetBSSID = "";
+    
+    if (success) {
+        _roamCount++;
+        _roamWeakLink = false;
+        FLEXIFI_LOGI("✅ Roamed to %s (%d dBm)", WiFi.BSSIDstr().c_str(), WiFi.RSSI());
+    } else {
+        // Fall back to an unpinned association with the same SSID
+        FLEXIFI_LOGW("Roaming to %s failed, reconnecting to %s", bssid.c_str(), _currentSSID.c_str());
+        _roamRecovery = true;
+        _connectAttempt++;
+        WiFi.begin(_currentSSID.c_str(), _currentPassword.c_str());
+        _connectStartTime = millis();
+    }
+    
+    if (_onRoamComplete) {
+        _onRoamComplete(bssid, success);
+    }
+    _publishEvent(FlexifiEventType::ROAM_COMPLETE, _currentSSID.c_str(), 0, success, bssid.c_str());
+    
+    if (_portalServer) {
+        _portalServer->broadcastMessage(success ? "roam_success" : "roam_failed", bssid);
+    }
+}
+
+String Flexifi::_formatBSSID(const uint8_t* bssid) {
+    char buffer[18];
+    snprintf(buffer, sizeof(buffer), "%02X:%02X:%02X:%02X:%02X:%02X",
+             bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+    return String(buffer);
+}
+
 bool Flexifi::_tryConnectToProfiles() {
     FLEXIFI_LOGI("🔍 _tryConnectToProfiles() called");
     
@@ -1147,80 +2418,97 @@ bool Flexifi::_tryConnectToProfiles() {
     
     // Log network cache status
     FLEXIFI_LOGI("📡 Network cache status: JSON='%s', count=%d, lastScan=%lu, now=%lu", 
-                 _networksJSON.substring(0, 50).c_str(), _networkCount, _lastScanTime, millis());
+                 _networksJSON->substring(0, 50).c_str(), _networkCount, _lastScanTime, millis());
     
-    // Direct connection attempts without scanning
+    // Queue the enabled profiles (already sorted by priority) and try them one at a time
+    _autoConnectQueue.clear();
     for (const WiFiProfile& profile : profiles) {
-        if (!profile.autoConnect) continue;
+        if (profile.autoConnect) {
+            _autoConnectQueue.push_back(profile);
+        }
+    }
+    _autoConnectIndex = 0;
+    
+    if (!_connectNextProfile()) {
+        FLEXIFI_LOGD("No available WiFi profiles found for auto-connect");
+        return false;
+    }
+    return true;
+}
+
+bool Flexifi::_connectNextProfile() {
+    while (_autoConnectIndex < _autoConnectQueue.size()) {
+        const WiFiProfile& profile = _autoConnectQueue[_autoConnectIndex++];
         
         FLEXIFI_LOGI("🔌 Trying direct connection to: %s (priority: %d)", 
                     profile.ssid.c_str(), profile.priority);
         
-        if (connectToWiFi(profile.ssid, profile.password)) {
-            FLEXIFI_LOGI("✅ Successfully connected to: %s", profile.ssid.c_str());
+        _autoConnectHandle = connectAsync(profile.ssid, profile.password, 0,
+            [this](const ConnectOutcome& outcome) { _onProfileConnectComplete(outcome); });
+        if (_autoConnectHandle != 0) {
             return true;
         }
     }
     
-    FLEXIFI_LOGD("No available WiFi profiles found for auto-connect");
+    _autoConnectQueue.clear();
+    _autoConnectHandle = 0;
     return false;
 }
 
-// Parameter management methods
-void Flexifi::_initParameters() {
-    _parameters = new FlexifiParameter*[_maxParameters];
-    for (int i = 0; i < _maxParameters; i++) {
-        _parameters[i] = nullptr;
+void Flexifi::_onProfileConnectComplete(const ConnectOutcome& outcome) {
+    _autoConnectHandle = 0;
+    
+    if (outcome.result == ConnectResult::SUCCESS) {
+        FLEXIFI_LOGI("✅ Successfully connected to: %s", outcome.ssid.c_str());
+        _autoConnectQueue.clear();
+        return;
+    }
+    
+    if (outcome.result == ConnectResult::CANCELLED) {
+        _autoConnectQueue.clear();
+        return;
     }
-    _parameterCount = 0;
-    FLEXIFI_LOGD("Parameter system initialized (max: %d)", _maxParameters);
+    
+    FLEXIFI_LOGI("Profile %s failed: %s", outcome.ssid.c_str(), connectResultToString(outcome.result));
+    
+    // Runs inside the event drain; later events from this attempt may still be queued,
+    // so the next profile waits for the next loop pass
+    _autoConnectNextPending = true;
 }
 
-void Flexifi::_clearParameters() {
-    if (_parameters) {
-        for (int i = 0; i < _parameterCount; i++) {
-            if (_parameters[i]) {
-                delete _parameters[i];
-                _parameters[i] = nullptr;
-            }
-        }
-        delete[] _parameters;
-        _parameters = nullptr;
+void Flexifi::_advanceAutoConnect() {
+    _autoConnectNextPending = false;
+    
+    // An explicit connect started in the meantime takes over
+    if (_connectHandle != 0) {
+        _autoConnectQueue.clear();
+        return;
+    }
+    
+    if (!_connectNextProfile()) {
+        // Round exhausted; the backoff wait runs from here
+        FLEXIFI_LOGW("Auto-connect round %d failed, next attempt in %lu ms", 
+                     _autoConnectRetryCount, _autoConnectDelay);
+        _lastAutoConnectAttempt = millis();
     }
-    _parameterCount = 0;
-    FLEXIFI_LOGD("Parameters cleared");
 }
 
-int Flexifi::_findParameterIndex(const String& id) const {
-    for (int i = 0; i < _parameterCount; i++) {
-        if (_parameters[i] && _parameters[i]->getID() == id) {
-            return i;
-        }
-    }
-    return -1;
+unsigned long Flexifi::_computeBackoffDelay(int attempt) const {
+    return FlexifiBackoff::delay(attempt, _backoffInitial, _backoffMax, 
+                                 _backoffMultiplier, _backoffJitter, esp_random());
 }
 
-bool Flexifi::_addParameterToArray(FlexifiParameter* parameter) {
-    if (!parameter) {
-        return false;
-    }
-    
-    // Check if parameter already exists
-    if (_findParameterIndex(parameter->getID()) >= 0) {
-        FLEXIFI_LOGW("Parameter already exists: %s", parameter->getID().c_str());
-        return false;
-    }
-    
-    // Check if we have space
-    if (_parameterCount >= _maxParameters) {
-        FLEXIFI_LOGE("Maximum parameter count reached: %d", _maxParameters);
+// Parameter management methods
+bool Flexifi::_registerParameter(FlexifiParameter* parameter, ParameterOwnership ownership) {
+    if (!_parameters.add(parameter, ownership)) {
         return false;
     }
     
-    // Add to array
-    _parameters[_parameterCount] = parameter;
-    _parameterCount++;
+    FLEXIFI_LOGD("Parameter added: %s (%s-owned)", parameter->getID().c_str(), 
+                 ownership == ParameterOwnership::LIBRARY ? "library" : "caller");
     
+    // Load saved value for this parameter (if any)
+    _loadParameterValue(parameter);
     return true;
 }
 
@@ -1229,7 +2517,7 @@ bool Flexifi::_networkMeetsQuality(int rssi) const {
     return rssi >= _minSignalQuality;
 }
 
-String Flexifi::_getSignalStrengthIcon(int rssi) const {
+String Flexifi::_getSignalStrengthIcon(int rssi) {
     // Convert RSSI to 0-5 scale for CSS signal bars
     int strength = 0;
     if (rssi >= -30) strength = 5;
@@ -1246,6 +2534,7 @@ String Flexifi::_getSignalStrengthIcon(int rssi) const {
 void Flexifi::_onPortalStateChange(PortalState newState) {
     PortalState oldState = _portalState;
     _portalState = newState;
+    _touchStatus();
     
     FLEXIFI_LOGD("Portal state changed: %d -> %d", static_cast<int>(oldState), static_cast<int>(newState));
 }
@@ -1253,6 +2542,7 @@ void Flexifi::_onPortalStateChange(PortalState newState) {
 void Flexifi::_onWiFiStateChange(WiFiState newState) {
     WiFiState oldState = _wifiState;
     _wifiState = newState;
+    _touchStatus();
     
     FLEXIFI_LOGD("WiFi state changed: %d -> %d", static_cast<int>(oldState), static_cast<int>(newState));
 }
@@ -1280,29 +2570,54 @@ String Flexifi::_formatProfilesJSON(const std::vector<WiFiProfile>& profiles) co
 
 // Parameter persistence methods
 void Flexifi::_saveParameterValues() {
-    if (!_storage || !_parameters) {
+    if (!_storage) {
         return;
     }
     
-    FLEXIFI_LOGD("Saving %d parameter values", _parameterCount);
+    FLEXIFI_LOGD("Saving %d parameter values", (int)_parameters.size());
     
-    for (int i = 0; i < _parameterCount; i++) {
-        if (_parameters[i]) {
-            // Use shorter key format to avoid NVS 15-character limit
-            String key = "p_" + _parameters[i]->getID();
-            String value = _parameters[i]->getValue();
-            
-            if (_storage->saveConfig(key, value)) {
-                FLEXIFI_LOGD("Saved parameter: %s = %s", _parameters[i]->getID().c_str(), value.c_str());
-            } else {
-                FLEXIFI_LOGW("Failed to save parameter: %s", _parameters[i]->getID().c_str());
-            }
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        FlexifiParameter* parameter = _parameters.at(i);
+        
+        // Use shorter key format to avoid NVS 15-character limit
+        String key = "p_" + parameter->getID();
+        String value = parameter->getValue();
+        
+        if (_storage->saveConfig(key, value)) {
+            FLEXIFI_LOGD("Saved parameter: %s = %s", parameter->getID().c_str(), value.c_str());
+        } else {
+            FLEXIFI_LOGW("Failed to save parameter: %s", parameter->getID().c_str());
         }
     }
 }
 
+void Flexifi::_refreshParameterViews() {
+    uint32_t revision = _parameters.revision();
+    if (_parameterViews && _parameterViewsRevision == revision) {
+        return;
+    }
+    
+    std::vector<FlexifiParameterView>* views = new std::vector<FlexifiParameterView>();
+    views->reserve(_parameters.size());
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        const FlexifiParameter* parameter = _parameters.at(i);
+        StreamString html;
+        parameter->renderHTML(html);
+        views->push_back({parameter->getID(), parameter->getLabel(), parameter->getValue(), html});
+    }
+    std::atomic_store(&_parameterViews, std::shared_ptr<const std::vector<FlexifiParameterView>>(views));
+    
+    FlexifiParametersSchema* schema = new FlexifiParametersSchema();
+    schema->revision = revision;
+    StreamString json;
+    writeParametersSchema(json);
+    schema->json = json;
+    std::atomic_store(&_parametersSchema, std::shared_ptr<const FlexifiParametersSchema>(schema));
+    _parameterViewsRevision = revision;
+}
+
 void Flexifi::_loadParameterValues() {
-    if (!_storage || !_parameters) {
+    if (!_storage) {
         return;
     }
     
@@ -1312,12 +2627,10 @@ void Flexifi::_loadParameterValues() {
         return;
     }
     
-    FLEXIFI_LOGD("Loading parameter values for %d parameters", _parameterCount);
+    FLEXIFI_LOGD("Loading parameter values for %d parameters", (int)_parameters.size());
     
-    for (int i = 0; i < _parameterCount; i++) {
-        if (_parameters[i]) {
-            _loadParameterValue(_parameters[i]);
-        }
+    for (size_t i = 0; i < _parameters.size(); i++) {
+        _loadParameterValue(_parameters.at(i));
     }
 }
 
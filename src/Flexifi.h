@@ -4,8 +4,20 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <ESPAsyncWebServer.h>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
 #include "StorageManager.h"
+#include "FlexifiCommandQueue.h"
+#include "FlexifiEventBus.h"
+#include "FlexifiLinkPolicy.h"
+#include "FlexifiParameterRegistry.h"
+#include "FlexifiValidation.h"
 
 #ifdef FLEXIFI_MDNS
 #include <ESPmDNS.h>
@@ -15,6 +27,9 @@
 class PortalWebServer;
 class StorageManager;
 class TemplateManager;
+class TemplateStream;
+struct FlexifiAsset;
+struct FlexifiRenderedPage;
 class FlexifiParameter;
 class DNSServer;
 struct WiFiProfile;
@@ -48,6 +63,85 @@ struct WiFiProfile;
 #define FLEXIFI_PASSWORD_LOG_INTERVAL 30000
 #endif
 
+#ifndef FLEXIFI_AP_SETTLE_TIME
+#define FLEXIFI_AP_SETTLE_TIME 100        // Max wait for the AP+STA mode switch before starting the AP (ms)
+#endif
+
+#ifndef FLEXIFI_INITIAL_SCAN_DELAY
+#define FLEXIFI_INITIAL_SCAN_DELAY 500    // Delay between AP start and the first scan (ms)
+#endif
+
+#ifndef FLEXIFI_SCAN_SETTLE_TIME
+#define FLEXIFI_SCAN_SETTLE_TIME 100      // Driver settle time after disconnect/mode change before scanning (ms)
+#endif
+
+#ifndef FLEXIFI_COMMAND_QUEUE_SIZE
+#define FLEXIFI_COMMAND_QUEUE_SIZE 8      // Web command slots (power of two, holds size - 1)
+#endif
+
+// Task mode configuration
+#ifndef FLEXIFI_TASK_STACK_SIZE
+#define FLEXIFI_TASK_STACK_SIZE 6144      // Stack of the optional Flexifi task (bytes)
+#endif
+
+#ifndef FLEXIFI_TASK_PRIORITY
+#define FLEXIFI_TASK_PRIORITY 2
+#endif
+
+#ifndef FLEXIFI_TASK_CORE
+#define FLEXIFI_TASK_CORE tskNO_AFFINITY
+#endif
+
+#ifndef FLEXIFI_TASK_MAX_WAIT
+#define FLEXIFI_TASK_MAX_WAIT 1000        // Longest idle sleep of the task (ms)
+#endif
+
+#ifndef FLEXIFI_WEB_LOCK_TIMEOUT
+#define FLEXIFI_WEB_LOCK_TIMEOUT 100      // Longest wait of a web handler for the API lock before answering 503 (ms)
+#endif
+
+// Auto-connect backoff configuration
+#ifndef FLEXIFI_AUTOCONNECT_BACKOFF_INITIAL
+#define FLEXIFI_AUTOCONNECT_BACKOFF_INITIAL 5000      // Delay after the first failed attempt (ms)
+#endif
+
+#ifndef FLEXIFI_AUTOCONNECT_BACKOFF_MAX
+#define FLEXIFI_AUTOCONNECT_BACKOFF_MAX 300000        // Upper bound for the retry delay (ms)
+#endif
+
+#ifndef FLEXIFI_AUTOCONNECT_BACKOFF_MULTIPLIER
+#define FLEXIFI_AUTOCONNECT_BACKOFF_MULTIPLIER 2.0f   // Growth factor per failed attempt
+#endif
+
+#ifndef FLEXIFI_AUTOCONNECT_BACKOFF_JITTER
+#define FLEXIFI_AUTOCONNECT_BACKOFF_JITTER 0.5f       // Fraction of each delay that is randomized (0-1)
+#endif
+
+#ifndef FLEXIFI_AUTOCONNECT_MAX_RETRIES
+#define FLEXIFI_AUTOCONNECT_MAX_RETRIES 0             // 0 = keep retrying forever
+#endif
+
+// Roaming configuration
+#ifndef FLEXIFI_ROAM_RSSI_THRESHOLD
+#define FLEXIFI_ROAM_RSSI_THRESHOLD -75   // dBm below which roaming is considered
+#endif
+
+#ifndef FLEXIFI_ROAM_HYSTERESIS
+#define FLEXIFI_ROAM_HYSTERESIS 8         // dB margin to re-arm and minimum candidate gain
+#endif
+
+#ifndef FLEXIFI_ROAM_CHECK_INTERVAL
+#define FLEXIFI_ROAM_CHECK_INTERVAL 2000  // RSSI sampling interval (ms)
+#endif
+
+#ifndef FLEXIFI_ROAM_SCAN_INTERVAL
+#define FLEXIFI_ROAM_SCAN_INTERVAL 30000  // Minimum time between roaming scans (ms)
+#endif
+
+#ifndef FLEXIFI_ROAM_MIN_INTERVAL
+#define FLEXIFI_ROAM_MIN_INTERVAL 60000   // Minimum time between reassociations (ms)
+#endif
+
 // Logging macros
 #if FLEXIFI_DEBUG_LEVEL >= 1
 #include <esp_log.h>
@@ -88,7 +182,69 @@ enum class WiFiState {
     FAILED
 };
 
+enum class ConnectResult {
+    SUCCESS,
+    AUTH_FAILED,       // Wrong password or handshake failure
+    NO_AP_FOUND,       // SSID not in range
+    TIMEOUT,           // Deadline passed without a definitive answer
+    CANCELLED,         // cancelConnect() or superseded by a reset
+    FAILED             // Any other driver failure
+};
+
+// Outcome of a connectAsync() attempt
+struct ConnectOutcome {
+    uint32_t handle;
+    ConnectResult result;
+    uint8_t reason;            // Driver disconnect reason (0 if none)
+    unsigned long elapsed;     // ms from WiFi.begin() to completion
+    String ssid;
+    String bssid;              // Associated BSSID on success, empty otherwise
+};
+
+typedef std::function<void(const ConnectOutcome&)> ConnectCallback;
+
+// One network from the last scan that passed the quality filter
+struct FlexifiNetwork {
+    String ssid;
+    int32_t rssi;
+    uint8_t channel;
+    bool secure;
+};
+
+// Parameter fields as templates render them, captured by loop()
+struct FlexifiParameterView {
+    String id;
+    String label;
+    String value;
+    String html;
+};
+
+// /params/schema body and the registry revision it was built from (its ETag)
+struct FlexifiParametersSchema {
+    uint32_t revision;
+    String json;
+};
+
+// Status snapshot; version increases on every change
+struct FlexifiStatus {
+    uint32_t version;
+    PortalState portalState;
+    WiFiState wifiState;
+    bool autoConnect;
+    bool scanInProgress;
+    int networkCount;
+    int profileCount;
+    String connectedSSID;
+    
+    FlexifiStatus() : 
+        version(0), portalState(PortalState::STOPPED), wifiState(WiFiState::DISCONNECTED),
+        autoConnect(false), scanInProgress(false), networkCount(0), profileCount(0) {}
+};
+
 class Flexifi {
+    friend class FlexifiTemplateData;
+    friend class PortalWebServer;   // Sole producer of the command queue
+
 public:
     Flexifi(AsyncWebServer* server, bool generatePassword = false);
     ~Flexifi();
@@ -99,6 +255,8 @@ public:
     // Configuration methods
     void setTemplate(const String& templateName);
     void setCustomTemplate(const String& htmlTemplate);
+    bool setCustomTemplateFile(const String& path);  // LittleFS file, streamed from flash on each request
+    void setRenderCacheBudget(size_t bytes);         // Largest page kept between requests; 0 disables the cache
     void setCredentials(const String& ssid, const String& password);
     void setPortalTimeout(unsigned long timeout);
     void setConnectTimeout(unsigned long timeout);
@@ -109,6 +267,8 @@ public:
     bool isMDNSEnabled() const;
 
     // Portal management
+    // startPortal() returns once bring-up has begun; loop() completes it and fires
+    // onPortalStart, or onPortalFailed if the access point cannot be started
     bool startPortal(const String& apName, const String& apPassword = "");
     void stopPortal();
     bool isPortalActive() const;
@@ -134,44 +294,110 @@ public:
     bool autoConnect();
     void setAutoConnectEnabled(bool enabled);
     bool isAutoConnectEnabled() const;
+    void setAutoConnectBackoff(unsigned long initialDelay, unsigned long maxDelay,
+                               float multiplier = FLEXIFI_AUTOCONNECT_BACKOFF_MULTIPLIER,
+                               float jitter = FLEXIFI_AUTOCONNECT_BACKOFF_JITTER);
+    void setAutoConnectMaxRetries(int maxRetries);   // 0 = unlimited
+    void resetAutoConnectBackoff();
+    unsigned long getAutoConnectDelayRemaining() const;
     String getHighestPrioritySSID() const;
     bool updateProfileLastUsed(const String& ssid);
 
     // Custom parameters
-    void addParameter(FlexifiParameter* parameter);
-    void addParameter(const String& id, const String& label, const String& defaultValue = "", 
+    // Pointer overload: Flexifi takes ownership and deletes the parameter (also when rejected).
+    // Reference overload: the caller keeps ownership; the parameter must outlive this Flexifi
+    // or be removed with removeParameter() first.
+    bool addParameter(FlexifiParameter* parameter);
+    bool addParameter(FlexifiParameter& parameter);
+    bool addParameter(const String& id, const String& label, const String& defaultValue = "", 
                      int maxLength = 40);
+    bool removeParameter(const String& id);
     FlexifiParameter* getParameter(const String& id);
     String getParameterValue(const String& id) const;
     void setParameterValue(const String& id, const String& value);
     int getParameterCount() const;
     String getParametersHTML() const;
+    void writeParametersHTML(Print& out) const;  // Streams all parameters into out
+    void writeParametersSchema(Print& out) const; // Streams {"parameters":[...]} as compact JSON
+    uint32_t getParametersRevision() const;       // Changes with any parameter edit; the schema ETag
+    std::shared_ptr<const FlexifiParametersSchema> getParametersSchemaShared() const;  // Lock-free; rebuilt by loop()
+    
+    // Submission validation: per-parameter rules plus cross-field rules, checked before storing
+    void addValidationRule(const String& parameterId, FlexifiFormRule rule);  // Errors reported against parameterId
+    bool validateParameters(const std::vector<std::pair<String, String>>& values, 
+                            FlexifiFieldErrors& errors) const;
 
     // Network management
     bool scanNetworks(bool bypassThrottle = false); // Returns true if scan started, false if throttled
     String getNetworksJSON() const;
     unsigned long getScanTimeRemaining() const; // Returns ms until next scan allowed
     bool connectToWiFi(const String& ssid, const String& password);
+    // Returns a non-zero handle if the attempt started; callback fires exactly once.
+    // deadline = 0 uses the connect timeout.
+    uint32_t connectAsync(const String& ssid, const String& password, unsigned long deadline = 0,
+                          ConnectCallback callback = nullptr);
+    bool cancelConnect(uint32_t handle = 0);          // 0 = whichever attempt is active
+    bool isConnectPending(uint32_t handle = 0) const;
+    static const char* connectResultToString(ConnectResult result);
     WiFiState getWiFiState() const;
     String getConnectedSSID() const;
+    uint8_t getLastDisconnectReason() const;          // Driver reason code of the last failure/drop
+    static const char* disconnectReasonToString(uint8_t reason);
     void setMinSignalQuality(int quality);
     int getMinSignalQuality() const;
 
+    // Roaming between BSSIDs of the connected SSID
+    void setRoamingEnabled(bool enabled);
+    bool isRoamingEnabled() const;
+    void setRoamingThreshold(int rssiThreshold, int hysteresis = FLEXIFI_ROAM_HYSTERESIS);
+    void setRoamingIntervals(unsigned long scanInterval, unsigned long minRoamInterval);
+    unsigned long getTimeBelowRoamThreshold() const; // Cumulative ms spent below threshold while connected
+    int getRoamCount() const;
+
     // Event callbacks
     void onPortalStart(std::function<void()> callback);
     void onPortalStop(std::function<void()> callback);
+    void onPortalFailed(std::function<void()> callback);
     void onWiFiConnect(std::function<void(const String&)> callback);
     void onWiFiDisconnect(std::function<void()> callback);
     void onConfigSave(std::function<void(const String&, const String&)> callback);
     void onScanComplete(std::function<void(int)> callback);
     void onConnectStart(std::function<void(const String&)> callback);
     void onConnectFailed(std::function<void(const String&)> callback);
+    void onRoamStart(std::function<void(const String&, const String&, int)> callback);  // from BSSID, to BSSID, target RSSI
+    void onRoamComplete(std::function<void(const String&, bool)> callback);           // BSSID, success
+
+    // Event bus: any number of subscribers, up to FLEXIFI_MAX_SUBSCRIBERS.
+    // The onX() setters above keep working alongside it.
+    int subscribe(FlexifiEventHandler handler, void* context = nullptr,
+                  uint32_t eventMask = FLEXIFI_EVENT_ALL, bool deferred = false);
+    bool unsubscribe(int subscriptionId);
+
+    // Dedicated task mode: Flexifi runs in its own FreeRTOS task and loop() becomes a no-op.
+    // The public API may then be called from any task.
+    bool startTask(uint32_t stackSize = FLEXIFI_TASK_STACK_SIZE,
+                   UBaseType_t priority = FLEXIFI_TASK_PRIORITY,
+                   BaseType_t core = FLEXIFI_TASK_CORE);
+    void stopTask();
+    bool isTaskRunning() const;
+
+    // Bounded API lock for code on other tasks that must not stall, such as web handlers.
+    // loop() and the Flexifi task hold the lock while they run.
+    bool tryLockApi(unsigned long timeoutMs = FLEXIFI_WEB_LOCK_TIMEOUT) const;  // false if still busy
+    void unlockApi() const;
 
     // Utility methods
     void loop();
     void reset();
     String getStatusJSON() const;
+    std::shared_ptr<const String> getStatusJSONShared() const;  // Lock-free; rebuilt by loop() when the status changes
+    FlexifiStatus getStatus() const;
+    uint32_t getStatusVersion() const;
     String getPortalHTML() const;
+    std::shared_ptr<TemplateStream> createPortalStream() const;     // Incremental render for chunked responses
+    const uint8_t* getPrerenderedPortalHTML(size_t& length) const;  // Gzipped; nullptr for custom templates; lock-free
+    std::shared_ptr<const FlexifiRenderedPage> getRenderedPortalHTML() const;  // Render cache; nullptr if over budget
+    bool getAsset(const String& path, FlexifiAsset& asset) const;    // Embedded CSS/JS served by the portal; lock-free
 
 private:
     AsyncWebServer* _server;
@@ -192,11 +418,19 @@ private:
     
     // Profile management
     bool _autoConnectEnabled;
-    unsigned long _lastAutoConnectAttempt;
+    unsigned long _lastAutoConnectAttempt;  // Start of the current backoff wait
+    unsigned long _autoConnectDelay;        // Jittered delay before the next attempt
     int _autoConnectRetryCount;
     bool _autoConnectLimitReachedLogged;
-    static const int MAX_AUTO_CONNECT_RETRIES = 3;
-    static const unsigned long AUTO_CONNECT_RETRY_DELAY = 30000;
+    unsigned long _backoffInitial;
+    unsigned long _backoffMax;
+    float _backoffMultiplier;
+    float _backoffJitter;
+    int _autoConnectMaxRetries;
+    std::vector<WiFiProfile> _autoConnectQueue;  // Profiles left to try in the current round
+    size_t _autoConnectIndex;
+    uint32_t _autoConnectHandle;
+    bool _autoConnectNextPending;   // A profile failed; the next one starts on the next loop pass
     static const unsigned long STORAGE_RETRY_DELAY = 60000; // Retry storage every 60 seconds
 
     // Timing
@@ -204,12 +438,20 @@ private:
     unsigned long _connectTimeout;
     unsigned long _portalStartTime;
     unsigned long _connectStartTime;
+    unsigned long _connectDeadline;        // Timeout of the attempt in progress
+    std::atomic<uint32_t> _connectAttempt; // Bumped before each WiFi.begin(); stamped on queued events
+    uint32_t _connectHandle;               // Active connectAsync() handle, 0 if none
+    uint32_t _nextConnectHandle;
+    ConnectCallback _connectCallback;
+    uint8_t _lastDisconnectReason;
     unsigned long _lastScanTime;
     unsigned long _lastStorageRetry;
 
     // Network data
     int _networkCount;
-    String _networksJSON;
+    std::shared_ptr<const String> _networksJSON;   // Replaced with std::atomic_store
+    std::shared_ptr<const std::vector<FlexifiNetwork>> _networks;  // Scan table; replaced with std::atomic_store
+    uint32_t _scanGeneration;                // Bumped whenever _networks changes
     int _minSignalQuality;
 
     // mDNS configuration
@@ -218,50 +460,135 @@ private:
     
     // Scan tracking
     bool _scanInProgress;
+    bool _scanPending;             // Scan requested, waiting for the driver to settle
+    unsigned long _scanPendingSince;
+
+    // Non-blocking portal bring-up
+    enum class StartupStage : uint8_t {
+        NONE,
+        WAIT_MODE,                 // Mode switched to AP+STA, waiting to start the AP
+        WAIT_SCAN                  // AP running, waiting to kick off the first scan
+    };
+    StartupStage _startupStage;
+    unsigned long _startupStageTime;
+    volatile bool _apModeReady;
+
+    // Roaming state
+    bool _roamingEnabled;
+    int _roamRssiThreshold;
+    int _roamHysteresis;
+    unsigned long _roamScanInterval;
+    unsigned long _roamMinInterval;
+    bool _roamWeakLink;            // Armed below threshold until RSSI recovers past hysteresis
+    bool _roamScanInProgress;
+    bool _roamInProgress;
+    bool _roamRecovery;            // Unpinned reconnect after a failed roam, not a new connection
+    unsigned long _lastRoamCheck;
+    unsigned long _lastRoamScan;
+    unsigned long _lastRoamTime;
+    unsigned long _roamTimeBelowThreshold;
+    int _roamCount;
+    String _roamTargetBSSID;
+
+    // Status snapshot, rebuilt by loop() or the Flexifi task only
+    FlexifiStatus _status;
+    bool _statusProfilesDirty;                      // Profile count must be reloaded from storage
+    std::shared_ptr<const String> _statusJSON;      // Accessed with std::atomic_load/store
+    uint32_t _statusJSONVersion;
+    unsigned long _statusJSONScanSeconds;           // Throttle countdown baked into _statusJSON
 
     // Custom parameters
-    FlexifiParameter** _parameters;
-    int _parameterCount;
-    int _maxParameters;
+    FlexifiParameterRegistry _parameters;
+    std::shared_ptr<const std::vector<FlexifiParameterView>> _parameterViews;  // Replaced with std::atomic_store
+    std::shared_ptr<const FlexifiParametersSchema> _parametersSchema;  // Replaced with std::atomic_store
+    uint32_t _parameterViewsRevision;        // Registry revision _parameterViews was built from
+    std::vector<std::pair<String, FlexifiFormRule>> _validationRules;
 
     // Callback functions
     std::function<void()> _onPortalStart;
     std::function<void()> _onPortalStop;
+    std::function<void()> _onPortalFailed;
     std::function<void(const String&)> _onWiFiConnect;
     std::function<void()> _onWiFiDisconnect;
     std::function<void(const String&, const String&)> _onConfigSave;
     std::function<void(int)> _onScanComplete;
     std::function<void(const String&)> _onConnectStart;
     std::function<void(const String&)> _onConnectFailed;
+    std::function<void(const String&, const String&, int)> _onRoamStart;
+    std::function<void(const String&, bool)> _onRoamComplete;
     
+    // Commands posted by web handlers, drained by loop()
+    FlexifiSpscQueue<FlexifiCommand, FLEXIFI_COMMAND_QUEUE_SIZE> _commandQueue;
+
+    // Task mode
+    struct WiFiEventRecord {
+        WiFiEvent_t event;
+        uint8_t reason;            // STA_DISCONNECTED reason
+        uint8_t channel;           // STA_CONNECTED channel
+        uint32_t attempt;          // _connectAttempt when the event arrived
+    };
+    TaskHandle_t _taskHandle;
+    EventGroupHandle_t _taskEvents;
+    QueueHandle_t _wifiEventQueue;  // WiFi events handed from the event task to loop() or the Flexifi task
+    SemaphoreHandle_t _apiMutex;    // Recursive; created with the instance
+
+    FlexifiEventBus _eventBus;
+
     // Internal scan completion callback
     std::function<void(int)> _onInternalScanComplete;
     
-    // Static instance for WiFi event callbacks
-    static Flexifi* _instance;
+    // WiFi event registration owned by this instance
+    wifi_event_id_t _wifiEventId;
+    bool _wifiEventRegistered;
 
     // Private methods
-    bool _setupAP();
+    void _beginAPSetup();
+    void _advancePortalStartup();
+    bool _startAP();
     void _stopAP();
-    void _handleWiFiEvents();
+    bool _startScan();
     void _checkTimeouts();
+    bool _postCommand(FlexifiCommand&& command);  // AsyncTCP task only (single producer); false if full
+    void _processCommands();
     void _updateNetworksJSON();
     bool _validateCredentials(const String& ssid, const String& password);
     void _setupWiFiEvents();
-    static void _onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info);
+    void _onWiFiEvent(WiFiEvent_t event, WiFiEventInfo_t info);
+    void _handleWiFiEvent(const WiFiEventRecord& record);
+    void _drainWiFiEvents();
+    
+    // Task mode helpers
+    static void _taskMain(void* arg);
+    void _runLoop();
+    void _wakeTask();
+    TickType_t _nextWakeTicks() const;
+    
+    // Connection state machine (driven by WiFi events)
+    void _handleConnectSuccess(bool newConnection);
+    void _handleConnectFailure(uint8_t reason);  // reason 0 = timeout
+    void _handleLinkLost(uint8_t reason);
+    static bool _isConnectFailureReason(uint8_t reason);
+    void _completeConnect(ConnectResult result, uint8_t reason);
     
     // Parameter management
-    void _initParameters();
-    void _clearParameters();
-    int _findParameterIndex(const String& id) const;
-    bool _addParameterToArray(FlexifiParameter* parameter);
+    bool _registerParameter(FlexifiParameter* parameter, ParameterOwnership ownership);
     void _saveParameterValues();
     void _loadParameterValues();
     void _loadParameterValue(FlexifiParameter* parameter);
+    void _refreshParameterViews();
     
     // Network filtering
     bool _networkMeetsQuality(int rssi) const;
-    String _getSignalStrengthIcon(int rssi) const;
+    static String _getSignalStrengthIcon(int rssi);
+    
+    // Event bus helpers
+    void _publishEvent(FlexifiEventType type, const char* ssid = nullptr, int32_t value = 0,
+                       bool success = false, const char* bssid = nullptr,
+                       const char* previousBssid = nullptr);
+    
+    // Status snapshot helpers
+    void _touchStatus();
+    void _refreshStatus();
     
     // State change handlers
     void _onPortalStateChange(PortalState newState);
@@ -269,11 +596,22 @@ private:
     
     // Profile management helpers
     bool _tryConnectToProfiles();
+    bool _connectNextProfile();
+    void _onProfileConnectComplete(const ConnectOutcome& outcome);
+    void _advanceAutoConnect();
+    unsigned long _computeBackoffDelay(int attempt) const;
     bool _tryConnectWithProfiles(const std::vector<WiFiProfile>& profiles);
     bool _connectToHighestPriorityNetwork();
     void _updateProfilePriorities();
     String _formatProfilesJSON(const std::vector<WiFiProfile>& profiles) const;
 
+    // Roaming helpers
+    void _handleRoaming();
+    bool _startRoamScan();
+    void _processRoamScan();
+    void _finishRoam(bool success);
+    static String _formatBSSID(const uint8_t* bssid);
+
     // mDNS helpers
     bool _startMDNS();
     void _stopMDNS();
@@ -0,0 +1,75 @@
+#ifndef FLEXIFICOMMANDQUEUE_H
+#define FLEXIFICOMMANDQUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// Actions requested by the web server, executed by Flexifi::loop()
+enum class FlexifiCommandType : uint8_t {
+    NONE,
+    SCAN,
+    CONNECT,
+    RESET,
+    STATUS
+};
+
+struct FlexifiCommand {
+    FlexifiCommandType type;
+    uint32_t clientId;      // WebSocket client awaiting a reply, 0 = none
+    String ssid;
+    String password;
+    std::vector<std::pair<String, String>> parameters;  // Custom parameter id/value pairs
+
+    FlexifiCommand(FlexifiCommandType t = FlexifiCommandType::NONE, uint32_t client = 0) :
+        type(t), clientId(client) {}
+};
+
+// Lock-free single-producer/single-consumer ring buffer.
+// The producer is the AsyncTCP task, the consumer is the task calling Flexifi::loop().
+// Holds N - 1 items; N must be a power of two.
+template <typename T, size_t N>
+class FlexifiSpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Queue size must be a power of two");
+
+public:
+    FlexifiSpscQueue() : _head(0), _tail(0) {}
+
+    // Producer side. Returns false if the queue is full.
+    bool push(T&& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) & (N - 1);
+        if (next == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        _items[tail] = std::move(item);
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool pop(T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(_items[head]);
+        _items[head] = T();  // Release any heap held by the slot
+        _head.store((head + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return N - 1; }
+
+private:
+    T _items[N];
+    std::atomic<size_t> _head;
+    std::atomic<size_t> _tail;
+};
+
+#endif // FLEXIFICOMMANDQUEUE_H
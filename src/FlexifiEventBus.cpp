@@ -0,0 +1,108 @@
+#include "FlexifiEventBus.h"
+#include "Flexifi.h"
+
+FlexifiEventBus::FlexifiEventBus() : _deferredQueue(nullptr) {
+    for (size_t i = 0; i < FLEXIFI_MAX_SUBSCRIBERS; i++) {
+        _subscribers[i] = Subscriber{nullptr, nullptr, 0, false};
+    }
+}
+
+FlexifiEventBus::~FlexifiEventBus() {
+    if (_deferredQueue) {
+        vQueueDelete(_deferredQueue);
+        _deferredQueue = nullptr;
+    }
+}
+
+int FlexifiEventBus::subscribe(FlexifiEventHandler handler, void* context, uint32_t mask, bool deferred) {
+    if (!handler) {
+        return -1;
+    }
+    
+    if (deferred && !_deferredQueue) {
+        _deferredQueue = xQueueCreate(FLEXIFI_EVENT_QUEUE_SIZE, sizeof(FlexifiEvent));
+        if (!_deferredQueue) {
+            FLEXIFI_LOGE("Failed to allocate deferred event queue");
+            return -1;
+        }
+    }
+    
+    for (size_t i = 0; i < FLEXIFI_MAX_SUBSCRIBERS; i++) {
+        Subscriber& slot = _subscribers[i];
+        if (slot.handler) {
+            continue;
+        }
+        slot.context = context;
+        slot.mask = mask;
+        slot.deferred = deferred;
+        slot.handler = handler;  // Set last: a non-null handler marks the slot live
+        FLEXIFI_LOGD("Event subscriber %d added (mask 0x%08lx%s)", (int)i, 
+                     (unsigned long)mask, deferred ? ", deferred" : "");
+        return (int)i;
+    }
+    
+    FLEXIFI_LOGW("No free event subscriber slots (max %d)", FLEXIFI_MAX_SUBSCRIBERS);
+    return -1;
+}
+
+bool FlexifiEventBus::unsubscribe(int id) {
+    if (id < 0 || id >= FLEXIFI_MAX_SUBSCRIBERS || !_subscribers[id].handler) {
+        return false;
+    }
+    _subscribers[id].handler = nullptr;
+    return true;
+}
+
+bool FlexifiEventBus::hasSubscribers(FlexifiEventType type) const {
+    uint32_t bit = flexifiEventMask(type);
+    for (size_t i = 0; i < FLEXIFI_MAX_SUBSCRIBERS; i++) {
+        if (_subscribers[i].handler && (_subscribers[i].mask & bit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void FlexifiEventBus::publish(const FlexifiEvent& event) {
+    uint32_t bit = flexifiEventMask(event.type);
+    bool queued = false;
+    
+    for (size_t i = 0; i < FLEXIFI_MAX_SUBSCRIBERS; i++) {
+        const Subscriber& subscriber = _subscribers[i];
+        FlexifiEventHandler handler = subscriber.handler;
+        if (!handler || !(subscriber.mask & bit)) {
+            continue;
+        }
+        
+        if (subscriber.deferred) {
+            // One copy serves every deferred subscriber
+            if (!queued && _deferredQueue) {
+                if (xQueueSend(_deferredQueue, &event, 0) != pdTRUE) {
+                    FLEXIFI_LOGW("Deferred event queue full, dropping event %d", (int)event.type);
+                }
+                queued = true;
+            }
+            continue;
+        }
+        
+        handler(event, subscriber.context);
+    }
+}
+
+void FlexifiEventBus::dispatchDeferred() {
+    if (!_deferredQueue) {
+        return;
+    }
+    
+    FlexifiEvent event;
+    while (xQueueReceive(_deferredQueue, &event, 0) == pdTRUE) {
+        uint32_t bit = flexifiEventMask(event.type);
+        for (size_t i = 0; i < FLEXIFI_MAX_SUBSCRIBERS; i++) {
+            const Subscriber& subscriber = _subscribers[i];
+            FlexifiEventHandler handler = subscriber.handler;
+            if (handler && subscriber.deferred && (subscriber.mask & bit)) {
+                handler(event, subscriber.context);
+            }
+        }
+    }
+}
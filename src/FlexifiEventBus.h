@@ -0,0 +1,79 @@
+#ifndef FLEXIFIEVENTBUS_H
+#define FLEXIFIEVENTBUS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#ifndef FLEXIFI_MAX_SUBSCRIBERS
+#define FLEXIFI_MAX_SUBSCRIBERS 8         // Event bus subscriber slots
+#endif
+
+#ifndef FLEXIFI_EVENT_QUEUE_SIZE
+#define FLEXIFI_EVENT_QUEUE_SIZE 8        // Events buffered for deferred subscribers
+#endif
+
+enum class FlexifiEventType : uint8_t {
+    PORTAL_START,
+    PORTAL_STOP,
+    CONNECT_START,      // ssid
+    CONNECT_FAILED,     // ssid, value = disconnect reason (0 = timeout)
+    WIFI_CONNECT,       // ssid, bssid
+    WIFI_DISCONNECT,    // value = disconnect reason
+    CONFIG_SAVE,        // ssid, success
+    SCAN_START,
+    SCAN_COMPLETE,      // value = networks after filtering
+    ROAM_START,         // previousBssid -> bssid, value = target RSSI
+    ROAM_COMPLETE,      // bssid, success
+    STORAGE_ERROR,      // Storage init or write failure
+    PORTAL_FAILED,      // Access point could not be started after startPortal() returned true
+    COUNT
+};
+
+#define FLEXIFI_EVENT_ALL 0xFFFFFFFFUL
+
+constexpr uint32_t flexifiEventMask(FlexifiEventType type) {
+    return 1UL << static_cast<uint8_t>(type);
+}
+
+// Fixed-size event payload; copied by value so no allocation on dispatch
+struct FlexifiEvent {
+    FlexifiEventType type;
+    int32_t value;
+    bool success;
+    char ssid[33];
+    char bssid[18];
+    char previousBssid[18];
+};
+
+typedef void (*FlexifiEventHandler)(const FlexifiEvent& event, void* context);
+
+class FlexifiEventBus {
+public:
+    FlexifiEventBus();
+    ~FlexifiEventBus();
+
+    // Returns a subscription id, or -1 if all slots are taken.
+    // Deferred subscribers are called from Flexifi::loop() (or the Flexifi task)
+    // instead of the publishing context.
+    int subscribe(FlexifiEventHandler handler, void* context = nullptr,
+                  uint32_t mask = FLEXIFI_EVENT_ALL, bool deferred = false);
+    bool unsubscribe(int id);
+
+    bool hasSubscribers(FlexifiEventType type) const;
+    void publish(const FlexifiEvent& event);
+    void dispatchDeferred();
+
+private:
+    struct Subscriber {
+        FlexifiEventHandler handler;
+        void* context;
+        uint32_t mask;
+        bool deferred;
+    };
+
+    Subscriber _subscribers[FLEXIFI_MAX_SUBSCRIBERS];
+    QueueHandle_t _deferredQueue;    // Created on the first deferred subscription
+};
+
+#endif // FLEXIFIEVENTBUS_H
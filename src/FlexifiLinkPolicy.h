@@ -0,0 +1,59 @@
+#ifndef FLEXIFILINKPOLICY_H
+#define FLEXIFILINKPOLICY_H
+
+#include <Arduino.h>
+
+// Decisions behind reconnecting and roaming, kept free of WiFi and timer calls so they
+// depend only on their arguments and can be checked off-target.
+
+// Auto-connect retry schedule: exponential growth from `initial` by `multiplier`,
+// capped at `max`. The lower `jitter` fraction of the window is taken from
+// `random` so devices that lost the same AP do not retry in lockstep.
+class FlexifiBackoff {
+public:
+    static unsigned long delay(int attempt, unsigned long initial, unsigned long max,
+                               float multiplier, float jitter, uint32_t random) {
+        // A flat schedule (x1) never grows, so the loop stays bounded however
+        // high the attempt count climbs with unlimited retries
+        float delayMs = (float)initial;
+        for (int i = 1; i < attempt && multiplier > 1.0f && delayMs < max; i++) {
+            delayMs *= multiplier;
+        }
+        unsigned long base = (delayMs < max) ? (unsigned long)delayMs : max;
+
+        unsigned long spread = (unsigned long)(base * jitter);
+        if (spread == 0) {
+            return base;
+        }
+        return base - (random % (spread + 1));
+    }
+};
+
+// Roaming decisions. A link arms below the threshold and disarms only once it
+// recovers to threshold + hysteresis, so RSSI hovering at the threshold does
+// not toggle it; a candidate AP must beat the current link by the same margin.
+class FlexifiRoamPolicy {
+public:
+    // Armed state after one RSSI sample
+    static bool weakLink(bool armed, int rssi, int threshold, int hysteresis) {
+        if (rssi < threshold) {
+            return true;
+        }
+        return rssi >= threshold + hysteresis ? false : armed;
+    }
+
+    static bool isBetterCandidate(int candidateRssi, int currentRssi, int hysteresis) {
+        return candidateRssi >= currentRssi + hysteresis;
+    }
+
+    // Rate limits for roaming scans and reassociations; a last time of 0 means never
+    static bool scanAllowed(unsigned long now, unsigned long lastScan, unsigned long scanInterval,
+                            unsigned long lastRoam, unsigned long minRoamInterval) {
+        if (lastScan != 0 && now - lastScan < scanInterval) {
+            return false;
+        }
+        return lastRoam == 0 || now - lastRoam >= minRoamInterval;
+    }
+};
+
+#endif // FLEXIFILINKPOLICY_H
@@ -1,4 +1,6 @@
 #include "FlexifiParameter.h"
+#include <StreamString.h>
+#include <math.h>
 
 FlexifiParameter::FlexifiParameter(const String& id, const String& label, const String& defaultValue, 
                                   int maxLength, ParameterType type) :
@@ -12,7 +14,12 @@ FlexifiParameter::FlexifiParameter(const String& id, const String& label, const
     _maxLength(maxLength),
     _optionCount(0),
     _type(type),
-    _required(false) {
+    _required(false),
+    _hasRange(false),
+    _min(0),
+    _max(0),
+    _revision(0) {
+    _parseValue();
 }
 
 FlexifiParameter::FlexifiParameter(const String& id, const String& label, const String& defaultValue, 
@@ -27,7 +34,12 @@ FlexifiParameter::FlexifiParameter(const String& id, const String& label, const
     _maxLength(maxLength),
     _optionCount(0),
     _type(ParameterType::TEXT),
-    _required(false) {
+    _required(false),
+    _hasRange(false),
+    _min(0),
+    _max(0),
+    _revision(0) {
+    _parseValue();
 }
 
 FlexifiParameter::FlexifiParameter(const String& id, const String& label, const String& defaultValue,
@@ -42,11 +54,16 @@ FlexifiParameter::FlexifiParameter(const String& id, const String& label, const
     _maxLength(100),
     _optionCount(optionCount),
     _type(ParameterType::SELECT),
-    _required(false) {
+    _required(false),
+    _hasRange(false),
+    _min(0),
+    _max(0),
+    _revision(0) {
     
     if (options && optionCount > 0) {
         _copyOptions(options, optionCount);
     }
+    _parseValue();
 }
 
 FlexifiParameter::FlexifiParameter(const FlexifiParameter& other) :
@@ -60,11 +77,18 @@ FlexifiParameter::FlexifiParameter(const FlexifiParameter& other) :
     _maxLength(other._maxLength),
     _optionCount(other._optionCount),
     _type(other._type),
-    _required(other._required) {
+    _required(other._required),
+    _hasRange(other._hasRange),
+    _min(other._min),
+    _max(other._max),
+    _pattern(other._pattern),
+    _revision(0),
+    _onChange(other._onChange) {
     
     if (other._options && other._optionCount > 0) {
         _copyOptions(other._options, other._optionCount);
     }
+    _parseValue();
 }
 
 FlexifiParameter& FlexifiParameter::operator=(const FlexifiParameter& other) {
@@ -81,10 +105,17 @@ FlexifiParameter& FlexifiParameter::operator=(const FlexifiParameter& other) {
         _optionCount = other._optionCount;
         _type = other._type;
         _required = other._required;
+        _hasRange = other._hasRange;
+        _min = other._min;
+        _max = other._max;
+        _pattern = other._pattern;
+        _onChange = other._onChange;
+        _revision++;
         
         if (other._options && other._optionCount > 0) {
             _copyOptions(other._options, other._optionCount);
         }
+        _parseValue();
     }
     return *this;
 }
@@ -93,7 +124,7 @@ FlexifiParameter::~FlexifiParameter() {
     _clearOptions();
 }
 
-String FlexifiParameter::getID() const {
+const String& FlexifiParameter::getID() const {
     return _id;
 }
 
@@ -138,121 +169,247 @@ bool FlexifiParameter::isRequired() const {
 }
 
 void FlexifiParameter::setValue(const String& value) {
+    if (value == _value) {
+        return;
+    }
+    
     _value = value;
+    _parseValue();
+    _revision++;
+    
+    if (_onChange) {
+        _onChange(*this);
+    }
+}
+
+void FlexifiParameter::onChange(std::function<void(const FlexifiParameter&)> callback) {
+    _onChange = callback;
 }
 
 void FlexifiParameter::setPlaceholder(const String& placeholder) {
     _placeholder = placeholder;
+    _revision++;
 }
 
 void FlexifiParameter::setRequired(bool required) {
     _required = required;
+    _revision++;
+}
+
+bool FlexifiParameter::setRange(float min, float max) {
+    // NaN would never fail a comparison, and neither NaN nor infinity is valid JSON
+    if (!isfinite(min) || !isfinite(max) || min > max) {
+        return false;
+    }
+    _hasRange = true;
+    _min = min;
+    _max = max;
+    _revision++;
+    return true;
+}
+
+bool FlexifiParameter::setPattern(const String& pattern) {
+    bool compiled = _pattern.compile(pattern);
+    _revision++;
+    return compiled;
 }
 
 void FlexifiParameter::setCustomHTML(const String& html) {
     _customHTML = html;
+    _revision++;
 }
 
-String FlexifiParameter::generateHTML() const {
+void FlexifiParameter::renderHTML(Print& out) const {
     if (!_customHTML.isEmpty()) {
-        return _customHTML;
+        out.print(_customHTML);
+        return;
     }
     
-    String html = "<div class=\"form-group\">";
-    html += generateLabel();
-    html += generateInput();
-    html += "</div>";
-    
+    out.print("<div class=\"form-group\">");
+    _renderLabel(out);
+    _renderInput(out);
+    out.print("</div>");
+}
+
+String FlexifiParameter::generateHTML() const {
+    StreamString html;
+    renderHTML(html);
     return html;
 }
 
 String FlexifiParameter::generateLabel() const {
-    String html = "<label for=\"" + _id + "\">" + _escapeHTML(_label);
-    if (_required) {
-        html += " <span class=\"required\">*</span>";
-    }
-    html += "</label>";
+    StreamString html;
+    _renderLabel(html);
     return html;
 }
 
 String FlexifiParameter::generateInput() const {
-    switch (_type) {
-        case ParameterType::SELECT:
-            return _generateSelectHTML();
-        case ParameterType::TEXTAREA:
-            return _generateTextareaHTML();
-        case ParameterType::CHECKBOX:
-            return _generateCheckboxHTML();
-        default:
-            return _generateTextHTML();
-    }
+    StreamString html;
+    _renderInput(html);
+    return html;
 }
 
-bool FlexifiParameter::validate() const {
-    if (_required && _value.isEmpty()) {
-        return false;
-    }
+void FlexifiParameter::renderSchema(Print& out) const {
+    out.print("{\"id\":");
+    _writeJSONString(out, _id);
+    out.print(",\"label\":");
+    _writeJSONString(out, _label);
     
-    if (_value.length() > _maxLength) {
-        return false;
+    if (!_customHTML.isEmpty()) {
+        // The client inserts custom markup verbatim, as the server-side renderer does
+        out.print(",\"html\":");
+        _writeJSONString(out, _customHTML);
+        out.print("}");
+        return;
     }
     
-    // Type-specific validation
+    out.print(",\"type\":\"");
     switch (_type) {
-        case ParameterType::EMAIL:
-            return _value.isEmpty() || _value.indexOf("@") > 0;
-        case ParameterType::NUMBER:
-            for (unsigned int i = 0; i < _value.length(); i++) {
-                if (!isdigit(_value[i]) && _value[i] != '.' && _value[i] != '-') {
-                    return false;
-                }
-            }
-            break;
-        case ParameterType::URL:
-            return _value.isEmpty() || _value.startsWith("http://") || _value.startsWith("https://");
-        default:
-            break;
+        case ParameterType::TEXTAREA: out.print("textarea"); break;
+        case ParameterType::SELECT:   out.print("select"); break;
+        case ParameterType::CHECKBOX: out.print("checkbox"); break;
+        default:                      out.print(_getTypeString()); break;
+    }
+    out.print("\",\"value\":");
+    if (_type == ParameterType::CHECKBOX) {
+        out.print(_boolValue ? "true" : "false");
+    } else {
+        _writeJSONString(out, _value);
     }
     
-    return true;
+    if (_maxLength > 0) {
+        out.print(",\"maxLength\":");
+        out.print(_maxLength);
+    }
+    if (_required) {
+        out.print(",\"required\":true");
+    }
+    if (!_placeholder.isEmpty()) {
+        out.print(",\"placeholder\":");
+        _writeJSONString(out, _placeholder);
+    }
+    if (_hasRange) {
+        out.print(",\"min\":");
+        out.print(_formatNumber(_min));
+        out.print(",\"max\":");
+        out.print(_formatNumber(_max));
+    }
+    if (!_pattern.isEmpty()) {
+        out.print(",\"pattern\":");
+        _writeJSONString(out, _pattern.getSource());
+    }
+    
+    if (_type == ParameterType::SELECT) {
+        out.print(",\"options\":[");
+        for (int i = 0; i < _optionCount; i++) {
+            if (i > 0) out.print(",");
+            _writeJSONString(out, _options[i]);
+        }
+        out.print("]");
+    }
+    
+    out.print("}");
+}
+
+bool FlexifiParameter::validate() const {
+    String error;
+    return validateValue(_value, error);
 }
 
 String FlexifiParameter::getValidationError() const {
-    if (_required && _value.isEmpty()) {
-        return _label + " is required";
+    String error;
+    validateValue(_value, error);
+    return error;
+}
+
+bool FlexifiParameter::validateValue(const String& value, String& error) const {
+    if (value.isEmpty()) {
+        if (_required) {
+            error = _label + " is required";
+            return false;
+        }
+        return true;
     }
     
-    if (_value.length() > _maxLength) {
-        return _label + " must be " + String(_maxLength) + " characters or less";
+    if (_maxLength > 0 && value.length() > (unsigned int)_maxLength) {
+        error = _label + " must be " + String(_maxLength) + " characters or less";
+        return false;
+    }
+    
+    bool needsNumber = _type == ParameterType::NUMBER || _hasRange;
+    float number = 0;
+    if (needsNumber) {
+        // strtof alone would also take " 5", "0x1A", "inf" and "nan"
+        number = _isDecimal(value.c_str()) ? strtof(value.c_str(), nullptr) : NAN;
+        if (!isfinite(number)) {
+            error = _label + " must be a valid number";
+            return false;
+        }
     }
     
     switch (_type) {
         case ParameterType::EMAIL:
-            if (!_value.isEmpty() && _value.indexOf("@") <= 0) {
-                return _label + " must be a valid email address";
+            if (value.indexOf("@") <= 0) {
+                error = _label + " must be a valid email address";
+                return false;
             }
             break;
-        case ParameterType::NUMBER:
-            for (unsigned int i = 0; i < _value.length(); i++) {
-                if (!isdigit(_value[i]) && _value[i] != '.' && _value[i] != '-') {
-                    return _label + " must be a valid number";
-                }
+        case ParameterType::URL:
+            if (!value.startsWith("http://") && !value.startsWith("https://")) {
+                error = _label + " must be a valid URL";
+                return false;
             }
             break;
-        case ParameterType::URL:
-            if (!_value.isEmpty() && !_value.startsWith("http://") && !_value.startsWith("https://")) {
-                return _label + " must be a valid URL";
+        case ParameterType::SELECT: {
+            bool known = false;
+            for (int i = 0; i < _optionCount && !known; i++) {
+                known = _options[i] == value;
+            }
+            if (!known) {
+                error = _label + " must be one of the listed options";
+                return false;
             }
             break;
+        }
         default:
             break;
     }
     
-    return "";
+    if (_hasRange && (number < _min || number > _max)) {
+        error = _label + " must be between " + _formatNumber(_min) + " and " + _formatNumber(_max);
+        return false;
+    }
+    
+    if (!_pattern.isEmpty() && !_pattern.matches(value.c_str())) {
+        error = _label + " has an invalid format";
+        return false;
+    }
+    
+    return true;
 }
 
 // Private methods
 
+void FlexifiParameter::_parseValue() {
+    const char* text = _value.c_str();
+    char* end = nullptr;
+    
+    _intValue = strtol(text, &end, 10);
+    _floatValue = strtof(text, &end);
+    _numeric = !_value.isEmpty() && end && *end == '\0';
+    
+    _boolValue = _value == "1" || _value.equalsIgnoreCase("true") || 
+                 _value.equalsIgnoreCase("yes") || _value.equalsIgnoreCase("on");
+    
+    _optionIndex = -1;
+    for (int i = 0; i < _optionCount; i++) {
+        if (_options[i] == _value) {
+            _optionIndex = i;
+            break;
+        }
+    }
+}
+
 void FlexifiParameter::_copyOptions(const String* options, int count) {
     _clearOptions();
     if (options && count > 0) {
@@ -272,17 +429,115 @@ void FlexifiParameter::_clearOptions() {
     }
 }
 
-String FlexifiParameter::_escapeHTML(const String& text) const {
-    String escaped = text;
-    escaped.replace("&", "&amp;");
-    escaped.replace("<", "&lt;");
-    escaped.replace(">", "&gt;");
-    escaped.replace("\"", "&quot;");
-    escaped.replace("'", "&#39;");
-    return escaped;
+void FlexifiParameter::_writeEscaped(Print& out, const String& text) {
+    // Single pass: copy runs of safe characters, substitute the rest
+    const char* start = text.c_str();
+    const char* p = start;
+    
+    for (; *p; p++) {
+        const char* entity;
+        switch (*p) {
+            case '&':  entity = "&amp;"; break;
+            case '<':  entity = "&lt;"; break;
+            case '>':  entity = "&gt;"; break;
+            case '"':  entity = "&quot;"; break;
+            case '\'': entity = "&#39;"; break;
+            default:   continue;
+        }
+        if (p > start) {
+            out.write((const uint8_t*)start, p - start);
+        }
+        out.print(entity);
+        start = p + 1;
+    }
+    
+    if (p > start) {
+        out.write((const uint8_t*)start, p - start);
+    }
+}
+
+String FlexifiParameter::_formatNumber(float value) {
+    // Shortest decimal that parses back to the same float, e.g. 0.1 rather than 0.10
+    // or 0.100000001; Print::print(float) would round to two places
+    char buffer[24];
+    for (int precision = 6; precision <= 9; precision++) {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (strtof(buffer, nullptr) == value) {
+            break;
+        }
+    }
+    return String(buffer);
+}
+
+bool FlexifiParameter::_isDecimal(const char* text) {
+    // Same grammar as an HTML number input: [-+]digits[.digits][e[-+]digits]
+    if (*text == '-' || *text == '+') {
+        text++;
+    }
+    bool digits = false;
+    while (isdigit((unsigned char)*text)) {
+        text++;
+        digits = true;
+    }
+    if (*text == '.') {
+        text++;
+        while (isdigit((unsigned char)*text)) {
+            text++;
+            digits = true;
+        }
+    }
+    if (!digits) {
+        return false;
+    }
+    if (*text == 'e' || *text == 'E') {
+        text++;
+        if (*text == '-' || *text == '+') {
+            text++;
+        }
+        if (!isdigit((unsigned char)*text)) {
+            return false;
+        }
+        while (isdigit((unsigned char)*text)) {
+            text++;
+        }
+    }
+    return *text == '\0';
+}
+
+void FlexifiParameter::_writeJSONString(Print& out, const String& text) {
+    out.print('"');
+    
+    const char* start = text.c_str();
+    const char* p = start;
+    
+    for (; *p; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            continue;
+        }
+        if (p > start) {
+            out.write((const uint8_t*)start, p - start);
+        }
+        switch (c) {
+            case '"':  out.print("\\\""); break;
+            case '\\': out.print("\\\\"); break;
+            case '\n': out.print("\\n"); break;
+            case '\r': out.print("\\r"); break;
+            case '\t': out.print("\\t"); break;
+            default:
+                out.printf("\\u%04x", c);
+                break;
+        }
+        start = p + 1;
+    }
+    
+    if (p > start) {
+        out.write((const uint8_t*)start, p - start);
+    }
+    out.print('"');
 }
 
-String FlexifiParameter::_getTypeString() const {
+const char* FlexifiParameter::_getTypeString() const {
     switch (_type) {
         case ParameterType::PASSWORD: return "password";
         case ParameterType::NUMBER: return "number";
@@ -293,73 +548,117 @@ String FlexifiParameter::_getTypeString() const {
     }
 }
 
-String FlexifiParameter::_generateSelectHTML() const {
-    String html = "<select id=\"" + _id + "\" name=\"" + _id + "\"";
-    if (_required) html += " required";
-    html += ">";
-    
-    if (!_required) {
-        html += "<option value=\"\">-- Select --</option>";
+void FlexifiParameter::_renderLabel(Print& out) const {
+    out.print("<label for=\"");
+    out.print(_id);
+    out.print("\">");
+    _writeEscaped(out, _label);
+    if (_required) {
+        out.print(" <span class=\"required\">*</span>");
     }
-    
-    for (int i = 0; i < _optionCount; i++) {
-        html += "<option value=\"" + _escapeHTML(_options[i]) + "\"";
-        if (_value == _options[i]) {
-            html += " selected";
-        }
-        html += ">" + _escapeHTML(_options[i]) + "</option>";
+    out.print("</label>");
+}
+
+void FlexifiParameter::_renderInput(Print& out) const {
+    switch (_type) {
+        case ParameterType::SELECT:
+            _renderSelect(out);
+            break;
+        case ParameterType::TEXTAREA:
+            _renderTextarea(out);
+            break;
+        case ParameterType::CHECKBOX:
+            _renderCheckbox(out);
+            break;
+        default:
+            _renderText(out);
+            break;
     }
-    
-    html += "</select>";
-    return html;
 }
 
-String FlexifiParameter::_generateTextHTML() const {
-    String html = "<input type=\"" + _getTypeString() + "\" id=\"" + _id + "\" name=\"" + _id + "\"";
-    html += " value=\"" + _escapeHTML(_value) + "\"";
-    
+void FlexifiParameter::_renderCommonAttributes(Print& out) const {
     if (_maxLength > 0) {
-        html += " maxlength=\"" + String(_maxLength) + "\"";
+        out.print(" maxlength=\"");
+        out.print(_maxLength);
+        out.print("\"");
     }
     
     if (!_placeholder.isEmpty()) {
-        html += " placeholder=\"" + _escapeHTML(_placeholder) + "\"";
+        out.print(" placeholder=\"");
+        _writeEscaped(out, _placeholder);
+        out.print("\"");
     }
     
     if (_required) {
-        html += " required";
+        out.print(" required");
     }
-    
-    html += ">";
-    return html;
 }
 
-String FlexifiParameter::_generateCheckboxHTML() const {
-    String html = "<input type=\"checkbox\" id=\"" + _id + "\" name=\"" + _id + "\" value=\"1\"";
+void FlexifiParameter::_renderSelect(Print& out) const {
+    out.print("<select id=\"");
+    out.print(_id);
+    out.print("\" name=\"");
+    out.print(_id);
+    out.print("\"");
+    if (_required) out.print(" required");
+    out.print(">");
     
-    if (_value == "1" || _value.equalsIgnoreCase("true") || _value.equalsIgnoreCase("yes")) {
-        html += " checked";
+    if (!_required) {
+        out.print("<option value=\"\">-- Select --</option>");
     }
     
-    html += "> " + _escapeHTML(_label);
-    return html;
-}
-
-String FlexifiParameter::_generateTextareaHTML() const {
-    String html = "<textarea id=\"" + _id + "\" name=\"" + _id + "\"";
-    
-    if (_maxLength > 0) {
-        html += " maxlength=\"" + String(_maxLength) + "\"";
+    for (int i = 0; i < _optionCount; i++) {
+        out.print("<option value=\"");
+        _writeEscaped(out, _options[i]);
+        out.print("\"");
+        if (i == _optionIndex) {
+            out.print(" selected");
+        }
+        out.print(">");
+        _writeEscaped(out, _options[i]);
+        out.print("</option>");
     }
     
-    if (!_placeholder.isEmpty()) {
-        html += " placeholder=\"" + _escapeHTML(_placeholder) + "\"";
-    }
+    out.print("</select>");
+}
+
+void FlexifiParameter::_renderText(Print& out) const {
+    out.print("<input type=\"");
+    out.print(_getTypeString());
+    out.print("\" id=\"");
+    out.print(_id);
+    out.print("\" name=\"");
+    out.print(_id);
+    out.print("\" value=\"");
+    _writeEscaped(out, _value);
+    out.print("\"");
+    _renderCommonAttributes(out);
+    out.print(">");
+}
+
+void FlexifiParameter::_renderCheckbox(Print& out) const {
+    out.print("<input type=\"checkbox\" id=\"");
+    out.print(_id);
+    out.print("\" name=\"");
+    out.print(_id);
+    out.print("\" value=\"1\"");
     
-    if (_required) {
-        html += " required";
+    if (_boolValue) {
+        out.print(" checked");
     }
     
-    html += " rows=\"3\">" + _escapeHTML(_value) + "</textarea>";
-    return html;
-}
\ No newline at end of file
+    out.print("> ");
+    _writeEscaped(out, _label);
+}
+
+void FlexifiParameter::_renderTextarea(Print& out) const {
+    out.print("<textarea id=\"");
+    out.print(_id);
+    out.print("\" name=\"");
+    out.print(_id);
+    out.print("\"");
+    _renderCommonAttributes(out);
+    out.print(" rows=\"3\">");
+    _writeEscaped(out, _value);
+    out.print("</textarea>");
+}
@@ -2,6 +2,8 @@
 #define FLEXIFIPARAMETER_H
 
 #include <Arduino.h>
+#include <functional>
+#include "FlexifiPattern.h"
 
 enum class ParameterType {
     TEXT,
@@ -36,7 +38,7 @@ public:
     ~FlexifiParameter();
 
     // Getters
-    String getID() const;
+    const String& getID() const;
     String getLabel() const;
     String getValue() const;
     String getDefaultValue() const;
@@ -47,6 +49,14 @@ public:
     int getOptionCount() const;
     String getPlaceholder() const;
     bool isRequired() const;
+    
+    // Typed values, parsed once when the value is set
+    long getInt() const { return _intValue; }
+    float getFloat() const { return _floatValue; }
+    bool getBool() const { return _boolValue; }        // "1", "true", "yes" or "on"
+    int getOptionIndex() const { return _optionIndex; } // -1 if the value is not one of the options
+    bool isNumeric() const { return _numeric; }         // Whole value parsed as a number
+    uint32_t getRevision() const { return _revision; }  // Bumped whenever the rendered form changes
 
     // Setters
     void setValue(const String& value);
@@ -54,14 +64,28 @@ public:
     void setRequired(bool required);
     void setCustomHTML(const String& html);
     
+    // Validation rules, compiled when set and checked before submitted values are stored
+    bool setRange(float min, float max);       // Numeric value must lie within [min, max]; false if not finite or min > max
+    bool setPattern(const String& pattern);    // Regex subset, see FlexifiPattern; false if unsupported
+    bool hasRange() const { return _hasRange; }
+    float getMin() const { return _min; }
+    float getMax() const { return _max; }
+    const String& getPattern() const { return _pattern.getSource(); }
+    
+    // Called after setValue() changes the value
+    void onChange(std::function<void(const FlexifiParameter&)> callback);
+    
     // HTML generation
+    void renderHTML(Print& out) const;   // Streams the form group without intermediate Strings
     String generateHTML() const;
     String generateLabel() const;
     String generateInput() const;
+    void renderSchema(Print& out) const; // Compact JSON description for client-side rendering
     
     // Validation
     bool validate() const;
     String getValidationError() const;
+    bool validateValue(const String& value, String& error) const;  // Checks a candidate value
 
 private:
     String _id;
@@ -75,16 +99,37 @@ private:
     int _optionCount;
     ParameterType _type;
     bool _required;
+    bool _hasRange;
+    float _min;
+    float _max;
+    FlexifiPattern _pattern;
+    
+    // Parsed representations of _value
+    long _intValue;
+    float _floatValue;
+    int _optionIndex;
+    bool _boolValue;
+    bool _numeric;
+    uint32_t _revision;
+    
+    std::function<void(const FlexifiParameter&)> _onChange;
     
     // Helper methods
+    void _parseValue();
     void _copyOptions(const String* options, int count);
     void _clearOptions();
-    String _escapeHTML(const String& text) const;
-    String _getTypeString() const;
-    String _generateSelectHTML() const;
-    String _generateTextHTML() const;
-    String _generateCheckboxHTML() const;
-    String _generateTextareaHTML() const;
+    static void _writeEscaped(Print& out, const String& text);
+    static void _writeJSONString(Print& out, const String& text);
+    static String _formatNumber(float value);
+    static bool _isDecimal(const char* text);
+    const char* _getTypeString() const;
+    void _renderLabel(Print& out) const;
+    void _renderInput(Print& out) const;
+    void _renderSelect(Print& out) const;
+    void _renderText(Print& out) const;
+    void _renderCheckbox(Print& out) const;
+    void _renderTextarea(Print& out) const;
+    void _renderCommonAttributes(Print& out) const;
 };
 
 #endif // FLEXIFIPARAMETER_H
\ No newline at end of file
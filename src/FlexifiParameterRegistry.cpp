@@ -0,0 +1,149 @@
+#include "FlexifiParameterRegistry.h"
+#include "FlexifiParameter.h"
+#include "Flexifi.h"
+
+namespace {
+const size_t INITIAL_INDEX_SIZE = 16;
+}
+
+FlexifiParameterRegistry::FlexifiParameterRegistry() :
+    _generation(esp_random()) {
+    _index.assign(INITIAL_INDEX_SIZE, -1);
+}
+
+FlexifiParameterRegistry::~FlexifiParameterRegistry() {
+    clear();
+}
+
+bool FlexifiParameterRegistry::add(FlexifiParameter* parameter, ParameterOwnership ownership) {
+    if (!parameter) {
+        return false;
+    }
+    
+    const String& id = parameter->getID();
+    uint32_t hash = _hash(id.c_str(), id.length());
+    int existing = _lookup(id.c_str(), id.length(), hash);
+    if (existing >= 0) {
+        FLEXIFI_LOGW("Parameter already exists: %s", id.c_str());
+        if (ownership == ParameterOwnership::LIBRARY && _entries[existing].parameter != parameter) {
+            delete parameter;
+        }
+        return false;
+    }
+    
+    if (_entries.size() >= INT16_MAX) {
+        FLEXIFI_LOGE("Parameter registry full");
+        if (ownership == ParameterOwnership::LIBRARY) {
+            delete parameter;
+        }
+        return false;
+    }
+    
+    _entries.push_back(Entry{parameter, hash, ownership});
+    
+    // Keep the load factor at or below one half
+    if (_entries.size() * 2 > _index.size()) {
+        _rebuildIndex(_index.size() * 2);
+    } else {
+        size_t mask = _index.size() - 1;
+        size_t slot = hash & mask;
+        while (_index[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        _index[slot] = (int16_t)(_entries.size() - 1);
+    }
+    _generation++;
+    return true;
+}
+
+bool FlexifiParameterRegistry::remove(const String& id) {
+    int position = _lookup(id.c_str(), id.length(), _hash(id.c_str(), id.length()));
+    if (position < 0) {
+        return false;
+    }
+    
+    _release(_entries[position]);
+    _entries.erase(_entries.begin() + position);
+    
+    // Positions after the removed entry shift, so re-index (removal is rare)
+    _rebuildIndex(_index.size());
+    _generation++;
+    return true;
+}
+
+void FlexifiParameterRegistry::clear() {
+    for (const Entry& entry : _entries) {
+        _release(entry);
+    }
+    _entries.clear();
+    _index.assign(INITIAL_INDEX_SIZE, -1);
+    _generation++;
+}
+
+uint32_t FlexifiParameterRegistry::revision() const {
+    // Mix in each parameter's own revision so value edits made through a
+    // retained pointer are seen too
+    uint32_t revision = _generation;
+    for (const Entry& entry : _entries) {
+        revision = (revision ^ entry.parameter->getRevision()) * 16777619u;
+    }
+    return revision;
+}
+
+FlexifiParameter* FlexifiParameterRegistry::find(const String& id) const {
+    return find(id.c_str(), id.length());
+}
+
+FlexifiParameter* FlexifiParameterRegistry::find(const char* id, size_t length) const {
+    int position = _lookup(id, length, _hash(id, length));
+    return (position >= 0) ? _entries[position].parameter : nullptr;
+}
+
+uint32_t FlexifiParameterRegistry::_hash(const char* data, size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t)data[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+int FlexifiParameterRegistry::_lookup(const char* id, size_t length, uint32_t hash) const {
+    size_t mask = _index.size() - 1;
+    size_t slot = hash & mask;
+    
+    while (_index[slot] >= 0) {
+        const Entry& entry = _entries[_index[slot]];
+        if (entry.hash == hash) {
+            const String& candidate = entry.parameter->getID();
+            if (candidate.length() == length && memcmp(candidate.c_str(), id, length) == 0) {
+                return _index[slot];
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+void FlexifiParameterRegistry::_rebuildIndex(size_t capacity) {
+    while (capacity < _entries.size() * 2) {
+        capacity *= 2;
+    }
+    
+    _index.assign(capacity, -1);
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < _entries.size(); i++) {
+        size_t slot = _entries[i].hash & mask;
+        while (_index[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        _index[slot] = (int16_t)i;
+    }
+}
+
+void FlexifiParameterRegistry::_release(const Entry& entry) {
+    if (entry.ownership == ParameterOwnership::LIBRARY) {
+        delete entry.parameter;
+    }
+}
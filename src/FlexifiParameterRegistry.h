@@ -0,0 +1,57 @@
+#ifndef FLEXIFIPARAMETERREGISTRY_H
+#define FLEXIFIPARAMETERREGISTRY_H
+
+#include <Arduino.h>
+#include <vector>
+
+class FlexifiParameter;
+
+// Who deletes a registered parameter
+enum class ParameterOwnership : uint8_t {
+    LIBRARY,    // Deleted by the registry on removal or destruction
+    CALLER      // Lifetime managed by the caller; must outlive its registration
+};
+
+// Growable parameter list kept in insertion order, with an open-addressing
+// hash index on the parameter ID for O(1) lookups.
+class FlexifiParameterRegistry {
+public:
+    FlexifiParameterRegistry();
+    ~FlexifiParameterRegistry();
+
+    FlexifiParameterRegistry(const FlexifiParameterRegistry&) = delete;
+    FlexifiParameterRegistry& operator=(const FlexifiParameterRegistry&) = delete;
+
+    // Fails on null or duplicate IDs. A LIBRARY-owned parameter that is rejected
+    // is deleted, unless that same pointer is already registered.
+    bool add(FlexifiParameter* parameter, ParameterOwnership ownership);
+    bool remove(const String& id);
+    void clear();
+
+    FlexifiParameter* find(const String& id) const;
+    FlexifiParameter* find(const char* id, size_t length) const;
+
+    size_t size() const { return _entries.size(); }
+    FlexifiParameter* at(size_t index) const { return _entries[index].parameter; }
+
+    // Changes whenever a parameter is added, removed or modified; used as an ETag
+    uint32_t revision() const;
+
+private:
+    struct Entry {
+        FlexifiParameter* parameter;
+        uint32_t hash;
+        ParameterOwnership ownership;
+    };
+
+    std::vector<Entry> _entries;   // Insertion order
+    std::vector<int16_t> _index;   // Entry positions, -1 = empty; size is a power of two
+    uint32_t _generation;          // Bumped on add/remove; random start so it differs per boot
+
+    static uint32_t _hash(const char* data, size_t length);
+    int _lookup(const char* id, size_t length, uint32_t hash) const;
+    void _rebuildIndex(size_t capacity);
+    static void _release(const Entry& entry);
+};
+
+#endif // FLEXIFIPARAMETERREGISTRY_H
@@ -0,0 +1,245 @@
+#include "FlexifiPattern.h"
+#include "Flexifi.h"
+
+namespace {
+const uint16_t REPEAT_UNBOUNDED = 0xFFFF;
+const uint16_t REPEAT_LIMIT = 1024;
+}
+
+FlexifiPattern::FlexifiPattern() {
+}
+
+bool FlexifiPattern::compile(const String& pattern) {
+    clear();
+
+    const char* p = pattern.c_str();
+
+    // Matching is always anchored; accept explicit anchors for familiarity
+    if (*p == '^') {
+        p++;
+    }
+
+    while (*p) {
+        if (*p == '$' && p[1] == '\0') {
+            break;
+        }
+
+        Token token;
+        memset(&token, 0, sizeof(token));
+        token.minRepeat = 1;
+        token.maxRepeat = 1;
+
+        bool ok = true;
+        char c = *p++;
+        switch (c) {
+            case '.':
+                _addRange(token, 1, 255);
+                break;
+            case '[':
+                ok = _parseClass(p, token);
+                break;
+            case '\\':
+                ok = *p && _addEscape(token, *p++);
+                break;
+            case '(': case ')': case '|':
+            case '*': case '+': case '?': case '{':
+                ok = false;
+                break;
+            default:
+                _addRange(token, (uint8_t)c, (uint8_t)c);
+                break;
+        }
+
+        if (!ok || !_parseQuantifier(p, token)) {
+            FLEXIFI_LOGW("Unsupported validation pattern: %s", pattern.c_str());
+            clear();
+            return false;
+        }
+        _tokens.push_back(token);
+    }
+
+    _source = pattern;
+    return true;
+}
+
+void FlexifiPattern::clear() {
+    _source = "";
+    _tokens.clear();
+}
+
+bool FlexifiPattern::matches(const char* text) const {
+    return _match(0, text ? text : "");
+}
+
+// Private methods
+
+void FlexifiPattern::_addRange(Token& token, uint8_t first, uint8_t last) {
+    for (unsigned c = first; c <= last; c++) {
+        token.set[c >> 5] |= 1UL << (c & 31);
+    }
+}
+
+bool FlexifiPattern::_addEscape(Token& token, char escape) {
+    Token shorthand;
+    memset(&shorthand, 0, sizeof(shorthand));
+
+    switch (escape) {
+        case 'd': case 'D':
+            _addRange(shorthand, '0', '9');
+            break;
+        case 'w': case 'W':
+            _addRange(shorthand, 'a', 'z');
+            _addRange(shorthand, 'A', 'Z');
+            _addRange(shorthand, '0', '9');
+            _addRange(shorthand, '_', '_');
+            break;
+        case 's': case 'S':
+            _addRange(shorthand, ' ', ' ');
+            _addRange(shorthand, '\t', '\r');   // \t \n \v \f \r
+            break;
+        default:
+            // Only punctuation may be escaped; anything else is a class we don't know
+            if (!ispunct((unsigned char)escape)) {
+                return false;
+            }
+            _addRange(token, (uint8_t)escape, (uint8_t)escape);
+            return true;
+    }
+
+    bool negate = escape == 'D' || escape == 'W' || escape == 'S';
+    for (int i = 0; i < 8; i++) {
+        token.set[i] |= negate ? ~shorthand.set[i] : shorthand.set[i];
+    }
+    token.set[0] &= ~1UL;   // Never match the terminator
+    return true;
+}
+
+bool FlexifiPattern::_parseClass(const char*& p, Token& token) {
+    bool negate = false;
+    if (*p == '^') {
+        negate = true;
+        p++;
+    }
+
+    bool first = true;
+    while (*p && (*p != ']' || first)) {
+        first = false;
+        uint8_t low = (uint8_t)*p++;
+
+        if (low == '\\') {
+            if (!*p) {
+                return false;
+            }
+            char escape = *p++;
+            if (!ispunct((unsigned char)escape)) {
+                if (!_addEscape(token, escape)) {
+                    return false;
+                }
+                continue;
+            }
+            low = (uint8_t)escape;
+        }
+
+        uint8_t high = low;
+        if (p[0] == '-' && p[1] && p[1] != ']') {
+            high = (uint8_t)p[1];
+            p += 2;
+            if (high == '\\') {
+                if (!*p || !ispunct((unsigned char)*p)) {
+                    return false;
+                }
+                high = (uint8_t)*p++;
+            }
+            if (high < low) {
+                return false;
+            }
+        }
+        _addRange(token, low, high);
+    }
+
+    if (*p != ']') {
+        return false;
+    }
+    p++;
+
+    if (negate) {
+        for (int i = 0; i < 8; i++) {
+            token.set[i] = ~token.set[i];
+        }
+        token.set[0] &= ~1UL;
+    }
+    return true;
+}
+
+bool FlexifiPattern::_parseQuantifier(const char*& p, Token& token) {
+    switch (*p) {
+        case '*':
+            token.minRepeat = 0;
+            token.maxRepeat = REPEAT_UNBOUNDED;
+            p++;
+            break;
+        case '+':
+            token.maxRepeat = REPEAT_UNBOUNDED;
+            p++;
+            break;
+        case '?':
+            token.minRepeat = 0;
+            p++;
+            break;
+        case '{': {
+            char* end = nullptr;
+            long low = strtol(p + 1, &end, 10);
+            if (end == p + 1 || low < 0 || low > REPEAT_LIMIT) {
+                return false;
+            }
+            long high = low;
+            if (*end == ',') {
+                const char* start = end + 1;
+                high = strtol(start, &end, 10);
+                if (end == start) {
+                    high = REPEAT_UNBOUNDED;
+                } else if (high < low || high > REPEAT_LIMIT) {
+                    return false;
+                }
+            }
+            if (*end != '}') {
+                return false;
+            }
+            token.minRepeat = (uint16_t)low;
+            token.maxRepeat = (uint16_t)high;
+            p = end + 1;
+            break;
+        }
+        default:
+            return true;
+    }
+
+    // Lazy or stacked quantifiers are not supported
+    return *p != '*' && *p != '+' && *p != '?' && *p != '{';
+}
+
+bool FlexifiPattern::_match(size_t tokenIndex, const char* text) const {
+    if (tokenIndex == _tokens.size()) {
+        return *text == '\0';
+    }
+
+    // Greedy, then backtrack; values are bounded by maxLength so this stays cheap
+    const Token& token = _tokens[tokenIndex];
+    size_t count = 0;
+    while (count < token.maxRepeat && text[count] && _test(token, (uint8_t)text[count])) {
+        count++;
+    }
+    if (count < token.minRepeat) {
+        return false;
+    }
+
+    for (;;) {
+        if (_match(tokenIndex + 1, text + count)) {
+            return true;
+        }
+        if (count == token.minRepeat) {
+            return false;
+        }
+        count--;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef FLEXIFIPATTERN_H
+#define FLEXIFIPATTERN_H
+
+#include <Arduino.h>
+#include <vector>
+
+// Small regular expression subset for parameter validation, compiled once
+// into a token list. The whole value must match, as with the HTML pattern
+// attribute, so the same string can be handed to the browser.
+//
+// Supported: literals, '.', [abc], [a-z], [^...], \d \w \s (and \D \W \S),
+// escaped metacharacters, and the quantifiers * + ? {n} {n,} {n,m}.
+// Groups and alternation are not supported.
+class FlexifiPattern {
+public:
+    FlexifiPattern();
+
+    bool compile(const String& pattern);   // False (and empty) if the pattern is unsupported
+    void clear();
+
+    bool isEmpty() const { return _tokens.empty(); }
+    const String& getSource() const { return _source; }
+    bool matches(const char* text) const;
+
+private:
+    struct Token {
+        uint32_t set[8];    // 256-bit character class
+        uint16_t minRepeat;
+        uint16_t maxRepeat;
+    };
+
+    String _source;
+    std::vector<Token> _tokens;
+
+    static void _addRange(Token& token, uint8_t first, uint8_t last);
+    static bool _addEscape(Token& token, char escape);
+    static bool _parseClass(const char*& p, Token& token);
+    static bool _parseQuantifier(const char*& p, Token& token);
+    static bool _test(const Token& token, uint8_t c) {
+        return token.set[c >> 5] & (1UL << (c & 31));
+    }
+    bool _match(size_t tokenIndex, const char* text) const;
+};
+
+#endif // FLEXIFIPATTERN_H
@@ -0,0 +1,42 @@
+#ifndef FLEXIFIVALIDATION_H
+#define FLEXIFIVALIDATION_H
+
+#include <Arduino.h>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Parameter id/message pairs for every field that failed validation
+typedef std::vector<std::pair<String, String>> FlexifiFieldErrors;
+
+// Read-only view of one form submission, handed to cross-field rules
+class FlexifiFormValues {
+public:
+    explicit FlexifiFormValues(const std::vector<std::pair<String, String>>& values) :
+        _values(values) {}
+
+    const String* find(const String& id) const {
+        for (const auto& value : _values) {
+            if (value.first == id) {
+                return &value.second;
+            }
+        }
+        return nullptr;
+    }
+
+    bool has(const String& id) const { return find(id) != nullptr; }
+    String get(const String& id) const {   // Empty when the field was not submitted
+        const String* value = find(id);
+        return value ? *value : String();
+    }
+    long getInt(const String& id) const { return strtol(get(id).c_str(), nullptr, 10); }
+    float getFloat(const String& id) const { return strtof(get(id).c_str(), nullptr); }
+
+private:
+    const std::vector<std::pair<String, String>>& _values;
+};
+
+// Cross-field rule: returns an error message, or an empty string if the submission is valid
+typedef std::function<String(const FlexifiFormValues& values)> FlexifiFormRule;
+
+#endif // FLEXIFIVALIDATION_H
@@ -1,7 +1,30 @@
 #include "PortalWebServer.h"
 #include "Flexifi.h"
+#include "TemplateManager.h"
 #include <ArduinoJson.h>
 
+namespace {
+
+// Holds the Flexifi API lock for one request. Handlers that cannot be served from a
+// published snapshot wait at most FLEXIFI_WEB_LOCK_TIMEOUT and answer 503 otherwise,
+// so the AsyncTCP task never blocks behind flash writes or WiFi.begin() in loop().
+class RequestLock {
+public:
+    explicit RequestLock(const Flexifi* portal) : _portal(portal), _locked(portal->tryLockApi()) {}
+    ~RequestLock() {
+        if (_locked) {
+            _portal->unlockApi();
+        }
+    }
+    bool locked() const { return _locked; }
+
+private:
+    const Flexifi* _portal;
+    bool _locked;
+};
+
+} // namespace
+
 PortalWebServer::PortalWebServer(AsyncWebServer* server, Flexifi* portal) :
     _server(server),
     _ws(nullptr),
@@ -86,6 +109,24 @@ void PortalWebServer::setupRoutes() {
         handleNetworksJSON(request);
     });
 
+    _server->on("/params/schema", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleParamsSchema(request);
+    });
+
+    // Stylesheet and script, referenced by the page with a ?v=<etag> query
+    _server->on("/flexifi.css", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleAsset(request);
+    });
+
+    _server->on("/flexifi.js", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleAsset(request);
+    });
+
+    // Any other embedded CSS/JS by its path under src/web, e.g. /assets/css/minimal.css
+    _server->on("/assets/*", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        handleAsset(request);
+    });
+
     // Handle 404
     _server->onNotFound([this](AsyncWebServerRequest* request) {
         handleNotFound(request);
@@ -178,6 +219,18 @@ size_t PortalWebServer::getWebSocketClientCount() const {
     return _clientCount;
 }
 
+void PortalWebServer::sendToClient(uint32_t clientId, const String& message) {
+#ifndef FLEXIFI_DISABLE_WEBSOCKET
+    if (_ws) {
+        _ws->text(clientId, message);
+    }
+#endif
+}
+
+void PortalWebServer::sendResponse(uint32_t clientId, bool success, const String& message) {
+    sendToClient(clientId, _createJSONResponse(success, message));
+}
+
 void PortalWebServer::handleRoot(AsyncWebServerRequest* request) {
     FLEXIFI_LOGD("Handling root request from %s", request->client()->remoteIP().toString().c_str());
     
@@ -186,15 +239,60 @@ void PortalWebServer::handleRoot(AsyncWebServerRequest* request) {
         return;
     }
 
-    // Get HTML from template manager
-    String html = _portal->getPortalHTML();
+    // Built-in templates are pre-rendered at build time: serve the gzipped page
+    // straight from flash; the page fetches status, networks and parameters itself.
+    // It needs no lock, so the captive portal landing page never answers 503.
+    size_t pageLength = 0;
+    const uint8_t* page = _portal->getPrerenderedPortalHTML(pageLength);
+    if (page && _acceptsGzip(request)) {
+        AsyncWebServerResponse* response = request->beginResponse(200, "text/html", page, pageLength);
+        response->addHeader("Content-Encoding", "gzip");
+        response->addHeader("Vary", "Accept-Encoding");
+        _setSecurityHeaders(response);
+        _setCORSHeaders(response);
+        request->send(response);
+        return;
+    }
+
+    RequestLock lock(_portal);
+    if (!lock.locked()) {
+        _sendError(request, 503, "Busy, try again");
+        return;
+    }
+
+    // Otherwise the last render is reused until the template, scan or parameters change
+    std::shared_ptr<const FlexifiRenderedPage> cached = _portal->getRenderedPortalHTML();
+    if (cached && (!cached->gzip || _acceptsGzip(request))) {
+        AsyncWebServerResponse* response = request->beginResponse("text/html", cached->length,
+            [cached](uint8_t* buffer, size_t maxLength, size_t index) -> size_t {
+                size_t remaining = cached->length - index;
+                size_t length = remaining < maxLength ? remaining : maxLength;
+                memcpy(buffer, cached->data + index, length);
+                return length;
+            });
+        if (cached->gzip) {
+            response->addHeader("Content-Encoding", "gzip");
+            response->addHeader("Vary", "Accept-Encoding");
+        }
+        _setSecurityHeaders(response);
+        _setCORSHeaders(response);
+        request->send(response);
+        return;
+    }
+
+    // Pages over the cache budget are rendered per request, one chunk at a
+    // time, so the page is never held in RAM as a whole
+    std::shared_ptr<TemplateStream> stream = _portal->createPortalStream();
     
-    if (html.isEmpty()) {
+    if (!stream) {
         _sendError(request, 500, "Failed to generate portal HTML");
         return;
     }
 
-    AsyncWebServerResponse* response = request->beginResponse(200, "text/html", html);
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/html",
+        [stream](uint8_t* buffer, size_t maxLength, size_t /*index*/) -> size_t {
+            return stream->read(buffer, maxLength);
+        });
     _setSecurityHeaders(response);
     _setCORSHeaders(response);
     request->send(response);
@@ -208,14 +306,14 @@ void PortalWebServer::handleScan(AsyncWebServerRequest* request) {
         return;
     }
 
-    // Trigger network scan
-    bool scanStarted = _portal->scanNetworks();
+    // Report throttling up front; the scan itself runs from Flexifi::loop()
+    unsigned long timeRemaining = _portal->getScanTimeRemaining();
     
-    if (!scanStarted) {
-        // Scan was throttled, calculate remaining time
-        unsigned long timeRemaining = _portal->getScanTimeRemaining();
+    if (timeRemaining > 0) {
         String throttleMessage = "Scan throttled. Please wait " + String(timeRemaining / 1000) + " more seconds.";
         _sendJSON(request, _createJSONResponse(false, throttleMessage));
+    } else if (!_portal->_postCommand(FlexifiCommand(FlexifiCommandType::SCAN))) {
+        _sendError(request, 503, "Busy, try again");
     } else {
         // Return current networks (may be empty if scan just started)
         String networksJSON = _portal->getNetworksJSON();
@@ -251,27 +349,43 @@ void PortalWebServer::handleConnect(AsyncWebServerRequest* request) {
         return;
     }
 
+    FlexifiCommand command(FlexifiCommandType::CONNECT);
+    command.ssid = ssid;
+    command.password = password;
+
     // Process custom parameters - iterate through all request parameters
     for (int i = 0; i < request->params(); i++) {
         const AsyncWebParameter* param = request->getParam(i);
         if (param && param->isPost() && param->name() != "ssid" && param->name() != "password") {
-            // This is a custom parameter
+            // This is a custom parameter, applied by loop() before connecting
             String paramName = param->name();
             String paramValue = _sanitizeInput(param->value());
-            _portal->setParameterValue(paramName, paramValue);
+            command.parameters.emplace_back(paramName, paramValue);
             FLEXIFI_LOGD("Custom parameter %s = %s", paramName.c_str(), paramValue.c_str());
         }
     }
 
+    // Reject bad values here so they are never applied or persisted
+    {
+        RequestLock lock(_portal);
+        if (!lock.locked()) {
+            _sendError(request, 503, "Busy, try again");
+            return;
+        }
+        FlexifiFieldErrors errors;
+        if (!_portal->validateParameters(command.parameters, errors)) {
+            _sendValidationErrors(request, errors);
+            return;
+        }
+    }
+
     FLEXIFI_LOGI("Connection request for SSID: %s", ssid.c_str());
 
-    // Attempt connection
-    bool success = _portal->connectToWiFi(ssid, password);
-    
-    if (success) {
+    // Hand the attempt to loop(); progress is reported over the WebSocket
+    if (_portal->_postCommand(std::move(command))) {
         _sendJSON(request, _createJSONResponse(true, "Connection initiated"));
     } else {
-        _sendJSON(request, _createJSONResponse(false, "Failed to initiate connection"));
+        _sendError(request, 503, "Busy, try again");
     }
 }
 
@@ -283,8 +397,8 @@ void PortalWebServer::handleStatus(AsyncWebServerRequest* request) {
         return;
     }
 
-    String statusJSON = _portal->getStatusJSON();
-    _sendJSON(request, statusJSON);
+    std::shared_ptr<const String> statusJSON = _portal->getStatusJSONShared();
+    _sendJSON(request, *statusJSON);
 }
 
 void PortalWebServer::handleReset(AsyncWebServerRequest* request) {
@@ -295,8 +409,11 @@ void PortalWebServer::handleReset(AsyncWebServerRequest* request) {
         return;
     }
 
-    _portal->reset();
-    _sendJSON(request, _createJSONResponse(true, "Configuration reset"));
+    if (_portal->_postCommand(FlexifiCommand(FlexifiCommandType::RESET))) {
+        _sendJSON(request, _createJSONResponse(true, "Configuration reset"));
+    } else {
+        _sendError(request, 503, "Busy, try again");
+    }
 }
 
 void PortalWebServer::handleNetworksJSON(AsyncWebServerRequest* request) {
@@ -310,16 +427,79 @@ void PortalWebServer::handleNetworksJSON(AsyncWebServerRequest* request) {
     String networksArray = _portal->getNetworksJSON();
     FLEXIFI_LOGD("📡 networks.json request - raw networks: %s", networksArray.substring(0, 100).c_str());
     
-    // Wrap the networks array in the expected format {networks: [...]}
-    DynamicJsonDocument doc(8192);
-    doc["networks"] = serialized(networksArray);
-    
+    // Wrap the already serialized array as {"networks":[...]}; a document around it
+    // would need a fixed capacity, and a large scan would not fit
     String response;
-    serializeJson(doc, response);
+    response.reserve(networksArray.length() + 14);
+    response += "{\"networks\":";
+    response += networksArray;
+    response += "}";
     FLEXIFI_LOGD("📡 networks.json response: %s", response.substring(0, 150).c_str());
     _sendJSON(request, response);
 }
 
+void PortalWebServer::handleParamsSchema(AsyncWebServerRequest* request) {
+    FLEXIFI_LOGD("Handling params/schema request");
+    
+    if (!_validateRequest(request)) {
+        _sendError(request, 400, "Invalid request");
+        return;
+    }
+
+    // Snapshot published by loop(); null only before its first pass
+    std::shared_ptr<const FlexifiParametersSchema> schema = _portal->getParametersSchemaShared();
+    if (!schema) {
+        _sendError(request, 503, "Busy, try again");
+        return;
+    }
+
+    String etag = "\"" + String(schema->revision, HEX) + "\"";
+    
+    // Browsers keep the schema and revalidate it; unchanged parameters cost one empty response
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", "no-cache");
+        request->send(response);
+        return;
+    }
+
+    AsyncWebServerResponse* response = request->beginResponse(200, "application/json", schema->json);
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");
+    _setSecurityHeaders(response);
+    _setCORSHeaders(response);
+    request->send(response);
+}
+
+void PortalWebServer::handleAsset(AsyncWebServerRequest* request) {
+    // Flash data only, no lock
+    FlexifiAsset asset;
+    if (!_portal->getAsset(request->url(), asset)) {
+        handleNotFound(request);
+        return;
+    }
+
+    String etag = "\"" + String(asset.etag) + "\"";
+    AsyncWebServerResponse* response;
+    
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+        response = request->beginResponse(304);
+    } else if (asset.gzip && _acceptsGzip(request)) {
+        response = request->beginResponse(200, asset.mimeType, asset.gzip, asset.gzipLength);
+        response->addHeader("Content-Encoding", "gzip");
+    } else {
+        response = request->beginResponse(200, asset.mimeType, asset.data, asset.length);
+    }
+
+    // The page links ?v=<etag>, so a changed asset always arrives under a new URL;
+    // unversioned URLs are revalidated against the ETag instead
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", request->hasParam("v") ? "public, max-age=31536000, immutable" : "no-cache");
+    response->addHeader("Vary", "Accept-Encoding");
+    request->send(response);
+}
+
 void PortalWebServer::handleNotFound(AsyncWebServerRequest* request) {
     FLEXIFI_LOGD("Handling 404 for: %s (Host: %s)", request->url().c_str(), request->host().c_str());
     
@@ -382,10 +562,10 @@ void PortalWebServer::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCli
                 }
                 
                 // Also send current status
-                String statusJSON = _portal->getStatusJSON();
+                std::shared_ptr<const String> statusJSON = _portal->getStatusJSONShared();
                 DynamicJsonDocument statusDoc(512);
                 statusDoc["type"] = "status_update";
-                statusDoc["data"] = serialized(statusJSON);
+                statusDoc["data"] = serialized(*statusJSON);
                 
                 String statusMessage;
                 serializeJson(statusDoc, statusMessage);
@@ -445,37 +625,31 @@ void PortalWebServer::_handleWebSocketMessage(AsyncWebSocketClient* client, cons
     
     String action = doc["action"];
     
+    // Actions run from Flexifi::loop(), which replies to this client by id
+    FlexifiCommand command(FlexifiCommandType::NONE, client->id());
+    
     if (action == "scan") {
-        bool scanStarted = _portal->scanNetworks();
-        
-        if (!scanStarted) {
-            // Scan was throttled, calculate remaining time
-            unsigned long timeRemaining = _portal->getScanTimeRemaining();
-            String throttleMessage = "Scan throttled. Please wait " + String(timeRemaining / 1000) + " more seconds.";
-            _sendWebSocketMessage(client, _createJSONResponse(false, throttleMessage));
-        } else {
-            _sendWebSocketMessage(client, _createJSONResponse(true, "Scan initiated"));
-        }
+        command.type = FlexifiCommandType::SCAN;
     } else if (action == "connect") {
-        String ssid = doc["ssid"];
-        String password = doc["password"];
+        command.type = FlexifiCommandType::CONNECT;
+        command.ssid = doc["ssid"].as<String>();
+        command.password = doc["password"].as<String>();
         
-        if (ssid.isEmpty()) {
+        if (command.ssid.isEmpty()) {
             _sendWebSocketMessage(client, _createJSONResponse(false, "SSID required"));
             return;
         }
-        
-        bool success = _portal->connectToWiFi(ssid, password);
-        _sendWebSocketMessage(client, _createJSONResponse(success, 
-            success ? "Connection initiated" : "Failed to initiate connection"));
     } else if (action == "status") {
-        String statusJSON = _portal->getStatusJSON();
-        _sendWebSocketMessage(client, statusJSON);
+        command.type = FlexifiCommandType::STATUS;
     } else if (action == "reset") {
-        _portal->reset();
-        _sendWebSocketMessage(client, _createJSONResponse(true, "Configuration reset"));
+        command.type = FlexifiCommandType::RESET;
     } else {
         _sendWebSocketMessage(client, _createJSONResponse(false, "Unknown action"));
+        return;
+    }
+    
+    if (!_portal->_postCommand(std::move(command))) {
+        _sendWebSocketMessage(client, _createJSONResponse(false, "Busy, try again"));
     }
 #endif
 }
@@ -552,6 +726,11 @@ bool PortalWebServer::_validateConnectRequest(AsyncWebServerRequest* request) {
     return true;
 }
 
+bool PortalWebServer::_acceptsGzip(AsyncWebServerRequest* request) {
+    return request->hasHeader("Accept-Encoding") && 
+           request->header("Accept-Encoding").indexOf("gzip") >= 0;
+}
+
 String PortalWebServer::_sanitizeInput(const String& input) {
     String sanitized = input;
     
@@ -597,6 +776,24 @@ void PortalWebServer::_sendJSON(AsyncWebServerRequest* request, const String& js
     request->send(response);
 }
 
+void PortalWebServer::_sendValidationErrors(AsyncWebServerRequest* request, const FlexifiFieldErrors& errors) {
+    DynamicJsonDocument doc(512 + errors.size() * 128);
+    doc["success"] = false;
+    doc["message"] = errors.size() == 1 ? errors[0].second : String("Please correct the highlighted fields");
+    
+    JsonObject fields = doc.createNestedObject("errors");
+    for (const auto& error : errors) {
+        fields[error.first] = error.second;
+    }
+    
+    String json;
+    serializeJson(doc, json);
+    AsyncWebServerResponse* response = request->beginResponse(422, "application/json", json);
+    _setSecurityHeaders(response);
+    _setCORSHeaders(response);
+    request->send(response);
+}
+
 void PortalWebServer::_sendHTML(AsyncWebServerRequest* request, const String& html) {
     AsyncWebServerResponse* response = request->beginResponse(200, "text/html", html);
     _setSecurityHeaders(response);
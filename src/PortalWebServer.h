@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
 #include <AsyncWebSocket.h>
+#include "FlexifiValidation.h"
 
 // Forward declaration
 class Flexifi;
@@ -24,6 +25,8 @@ public:
     void broadcastNetworks(const String& networksJSON);
     void broadcastMessage(const String& type, const String& data);
     size_t getWebSocketClientCount() const;
+    void sendToClient(uint32_t clientId, const String& message);
+    void sendResponse(uint32_t clientId, bool success, const String& message);
 
     // Route handlers
     void handleRoot(AsyncWebServerRequest* request);
@@ -32,6 +35,8 @@ public:
     void handleStatus(AsyncWebServerRequest* request);
     void handleReset(AsyncWebServerRequest* request);
     void handleNetworksJSON(AsyncWebServerRequest* request);
+    void handleParamsSchema(AsyncWebServerRequest* request);
+    void handleAsset(AsyncWebServerRequest* request);
     void handleNotFound(AsyncWebServerRequest* request);
     // handleCaptivePortalDetect removed - using 404 handler approach instead
 
@@ -67,6 +72,7 @@ private:
     // Request validation
     bool _validateRequest(AsyncWebServerRequest* request);
     bool _validateConnectRequest(AsyncWebServerRequest* request);
+    bool _acceptsGzip(AsyncWebServerRequest* request);
     String _sanitizeInput(const String& input);
 
     // CORS and security headers
@@ -79,6 +85,7 @@ private:
     void _sendError(AsyncWebServerRequest* request, int code, 
                    const String& message);
     void _sendJSON(AsyncWebServerRequest* request, const String& json);
+    void _sendValidationErrors(AsyncWebServerRequest* request, const FlexifiFieldErrors& errors);
     void _sendHTML(AsyncWebServerRequest* request, const String& html);
 };
 
@@ -2,11 +2,551 @@
 #include "Flexifi.h"
 #include "generated/web_assets.h"
 #include <ArduinoJson.h>
+#include <StreamString.h>
+#include <vector>
+#include <esp_heap_caps.h>
+#ifdef FLEXIFI_RENDER_CACHE_GZIP
+#include <esp_rom_crc.h>
+#include <rom/miniz.h>
+#endif
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+#include <LittleFS.h>
+#endif
+
+namespace {
+const char* const DEFAULT_TITLE = "Flexifi Setup";
+const char* const TEMPLATE_VERSION = "1.0.0";
+const char* const DEVICE_NAME = "Flexifi Device";
+const size_t MAX_TAG_LENGTH = 64;        // Longer "{{...}}" runs are literal text
+const size_t READER_WINDOW = 128;        // Lookahead buffered from a template file
+
+// Print over one chunk buffer. The first `skip` bytes of a segment are dropped
+// so an expansion split across chunks can be regenerated and resumed.
+class ChunkSink : public Print {
+public:
+    ChunkSink(uint8_t* buffer, size_t capacity) :
+        _buffer(buffer), _capacity(capacity), _length(0), _skip(0), _segmentBytes(0), _overflow(false) {}
+
+    void beginSegment(size_t skip) {
+        _skip = skip;
+        _segmentBytes = 0;
+        _overflow = false;
+    }
+
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override {
+        size_t skipped = size < _skip ? size : _skip;
+        _skip -= skipped;
+        data += skipped;
+        size -= skipped;
+
+        size_t room = _capacity - _length;
+        size_t copied = size < room ? size : room;
+        memcpy(_buffer + _length, data, copied);
+        _length += copied;
+        _segmentBytes += skipped + copied;
+        if (copied < size) {
+            _overflow = true;
+        }
+        return skipped + copied;
+    }
+
+    bool full() const { return _length == _capacity; }
+    bool overflowed() const { return _overflow; }
+    size_t length() const { return _length; }
+    size_t segmentBytes() const { return _segmentBytes; }
+
+private:
+    uint8_t* _buffer;
+    size_t _capacity;
+    size_t _length;
+    size_t _skip;
+    size_t _segmentBytes;
+    bool _overflow;
+};
+
+// Print that only records whether the output is truthy: non-empty, and not "0" or "false"
+class TruthSink : public Print {
+public:
+    TruthSink() : _length(0) {}
+
+    size_t write(uint8_t c) override {
+        if (_length < sizeof(_head)) {
+            _head[_length] = c;
+        }
+        _length++;
+        return 1;
+    }
+
+    bool truthy() const {
+        return _length > 0 &&
+               !(_length == 1 && _head[0] == '0') &&
+               !(_length == 5 && memcmp(_head, "false", 5) == 0);
+    }
+
+private:
+    char _head[5];
+    size_t _length;
+};
+
+// Network list read back from the JSON the scan published, for the String API
+class JsonNetworkData : public TemplateData {
+public:
+    explicit JsonNetworkData(JsonArray networks) : _networks(networks) {}
+
+    size_t count(uint8_t collection) const override {
+        return collection == FlexifiAssets::VAR_NETWORKS ? _networks.size() : 0;
+    }
+
+    bool write(uint8_t variable, uint8_t collection, size_t index, Print& out) const override {
+        if (collection != FlexifiAssets::VAR_NETWORKS || index >= _networks.size()) {
+            return false;
+        }
+        JsonObject network = _networks[index];
+        switch (variable) {
+            case FlexifiAssets::VAR_SSID:
+                TemplateManager::writeEscaped(out, network["ssid"] | "");
+                return true;
+            case FlexifiAssets::VAR_RSSI:
+                out.print(network["rssi"].as<int>());
+                return true;
+            case FlexifiAssets::VAR_CHANNEL:
+                out.print(network["channel"].as<int>());
+                return true;
+            case FlexifiAssets::VAR_SECURE:
+                out.print(network["secure"].as<bool>() ? "true" : "false");
+                return true;
+            case FlexifiAssets::VAR_SIGNAL: {
+                const char* signal = network["signal_strength"] | "";
+                if (*signal) {
+                    TemplateManager::writeEscaped(out, signal);
+                    return true;
+                }
+                // Fallback signal strength calculation if not provided
+                int rssi = network["rssi"].as<int>();
+                if (rssi > -50) {
+                    out.print("📶📶📶📶");
+                } else if (rssi > -60) {
+                    out.print("📶📶📶");
+                } else if (rssi > -70) {
+                    out.print("📶📶");
+                } else if (rssi > -80) {
+                    out.print("📶");
+                } else {
+                    out.print("📵");
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    JsonArray _networks;
+};
+
+const char NO_NETWORKS_HTML[] =
+    "<p>No networks found. Click 'Scan Networks' to search for available WiFi networks.</p>";
+
+#ifdef FLEXIFI_RENDER_CACHE_GZIP
+// Replaces a cached page with its gzip encoding, if that is smaller. Uses the
+// deflate compressor in the ESP32 ROM; its working memory is large, so this
+// is skipped when it can't be allocated (in practice, without PSRAM).
+void compressPage(FlexifiRenderedPage& page, uint32_t caps) {
+    static const uint8_t GZIP_HEADER[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+    const size_t GZIP_TRAILER = 8;   // CRC-32 and input size, little-endian
+    if (page.length <= sizeof(GZIP_HEADER) + GZIP_TRAILER) {
+        return;
+    }
+
+    tdefl_compressor* compressor = (tdefl_compressor*)heap_caps_malloc(sizeof(tdefl_compressor), caps);
+    uint8_t* gzip = (uint8_t*)heap_caps_malloc(page.length, caps);
+    if (!compressor || !gzip) {
+        FLEXIFI_LOGW("Not enough memory to gzip the cached page");
+        free(compressor);
+        free(gzip);
+        return;
+    }
+
+    size_t inLength = page.length;
+    size_t outLength = page.length - sizeof(GZIP_HEADER) - GZIP_TRAILER;
+    tdefl_init(compressor, nullptr, nullptr, TDEFL_DEFAULT_MAX_PROBES);
+    tdefl_status status = tdefl_compress(compressor, page.data, &inLength,
+                                         gzip + sizeof(GZIP_HEADER), &outLength, TDEFL_FINISH);
+    free(compressor);
+    if (status != TDEFL_STATUS_DONE) {
+        free(gzip);   // Would not have been smaller
+        return;
+    }
+
+    memcpy(gzip, GZIP_HEADER, sizeof(GZIP_HEADER));
+    uint32_t crc = esp_rom_crc32_le(0, page.data, page.length);
+    uint8_t* trailer = gzip + sizeof(GZIP_HEADER) + outLength;
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = (uint8_t)(crc >> (8 * i));
+        trailer[4 + i] = (uint8_t)(page.length >> (8 * i));
+    }
+
+    size_t length = sizeof(GZIP_HEADER) + outLength + GZIP_TRAILER;
+    uint8_t* shrunk = (uint8_t*)heap_caps_realloc(gzip, length, caps);
+    free(page.data);
+    page.data = shrunk ? shrunk : gzip;
+    page.length = length;
+    page.gzip = true;
+}
+#endif
+
+enum class TagKind : uint8_t { PLACEHOLDER, IF, EACH, ELSE, END_IF, END_EACH };
+
+// One {{...}} tag: a placeholder or a control tag
+struct Tag {
+    TagKind kind;
+    const char* name;      // Placeholder name or the #if/#each subject
+    size_t nameLength;
+    size_t length;         // Whole tag including braces
+};
+
+// Parses the tag starting at open; false if it is not one (so it is literal text)
+bool parseTag(const char* open, Tag& tag) {
+    const char* p = open + 2;
+    tag.kind = TagKind::PLACEHOLDER;
+    if (strncmp(p, "#if ", 4) == 0) {
+        tag.kind = TagKind::IF;
+        p += 4;
+    } else if (strncmp(p, "#each ", 6) == 0) {
+        tag.kind = TagKind::EACH;
+        p += 6;
+    } else if (strncmp(p, "else}}", 6) == 0) {
+        tag.kind = TagKind::ELSE;
+    } else if (strncmp(p, "/if}}", 5) == 0) {
+        tag.kind = TagKind::END_IF;
+    } else if (strncmp(p, "/each}}", 7) == 0) {
+        tag.kind = TagKind::END_EACH;
+    }
+
+    if (tag.kind == TagKind::ELSE || tag.kind == TagKind::END_IF || tag.kind == TagKind::END_EACH) {
+        tag.name = nullptr;
+        tag.nameLength = 0;
+        tag.length = strstr(p, "}}") + 2 - open;
+        return true;
+    }
+
+    tag.name = p;
+    while (isalnum((unsigned char)*p) || *p == '_') {
+        p++;
+    }
+    tag.nameLength = p - tag.name;
+    tag.length = p + 2 - open;
+    return tag.nameLength > 0 && p[0] == '}' && p[1] == '}';
+}
+
+
+// TemplateVariable for a placeholder name, or VAR_NONE if it is unknown
+uint8_t variableFromName(const char* name, size_t length) {
+    if (length == 9 && strncmp(name, "JS_PORTAL", 9) == 0) {
+        return FlexifiAssets::VAR_JS;   // Alias kept for older templates
+    }
+    for (uint8_t variable = 1; variable < FlexifiAssets::VAR_COUNT; variable++) {
+        const char* candidate = FlexifiAssets::template_variable_names[variable];
+        if (strlen(candidate) == length && strncmp(name, candidate, length) == 0) {
+            return variable;
+        }
+    }
+    return FlexifiAssets::VAR_NONE;
+}
+
+// Forward-only reader over a template in RAM or on LittleFS. Files are read
+// through a small window, so compiling a large template needs no copy of it.
+class TemplateReader {
+public:
+    TemplateReader(const char* text, size_t length) :
+        _text(text), _length(length), _position(0), _line(1)
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+        , _file(nullptr), _windowStart(0), _windowLength(0)
+#endif
+    {}
+
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    explicit TemplateReader(File& file) :
+        _text(nullptr), _length(file.size()), _position(0), _line(1),
+        _file(&file), _windowStart(0), _windowLength(0) {
+        _file->seek(0);
+    }
+#endif
+
+    size_t position() const { return _position; }
+    size_t length() const { return _length; }
+    int line() const { return _line; }
+    bool atEnd() const { return _position >= _length; }
+
+    // Byte `ahead` of the cursor, or -1 past the end (or beyond the file window)
+    int peek(size_t ahead = 0) {
+        size_t at = _position + ahead;
+        if (at >= _length) {
+            return -1;
+        }
+        if (_text) {
+            return (uint8_t)_text[at];
+        }
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+        if (at >= _windowStart + _windowLength) {
+            _fill();
+        }
+        if (at < _windowStart + _windowLength) {
+            return _window[at - _windowStart];
+        }
+#endif
+        return -1;
+    }
+
+    bool matches(const char* text) {
+        for (size_t i = 0; text[i]; i++) {
+            if (peek(i) != (uint8_t)text[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Up to size - 1 bytes from the cursor, NUL terminated
+    void copy(char* out, size_t size) {
+        size_t i = 0;
+        for (int c; i + 1 < size && (c = peek(i)) >= 0; i++) {
+            out[i] = (char)c;
+        }
+        out[i] = '\0';
+    }
+
+    void advance(size_t count = 1) {
+        for (; count > 0 && !atEnd(); count--) {
+            _line += peek() == '\n';
+            _position++;
+        }
+    }
+
+    void rewind() {
+        _position = 0;
+        _line = 1;
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+        _windowStart = 0;
+        _windowLength = 0;
+        if (_file) {
+            _file->seek(0);
+        }
+#endif
+    }
+
+private:
+    const char* _text;
+    size_t _length;
+    size_t _position;
+    int _line;
+
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    File* _file;
+    uint8_t _window[READER_WINDOW];
+    size_t _windowStart;
+    size_t _windowLength;
+
+    void _fill() {
+        // Restart the window at the cursor, keeping what is still ahead of it
+        size_t keep = 0;
+        if (_position >= _windowStart && _position < _windowStart + _windowLength) {
+            keep = _windowStart + _windowLength - _position;
+            memmove(_window, _window + (_position - _windowStart), keep);
+        } else {
+            _file->seek(_position);
+        }
+        _windowStart = _position;
+        _windowLength = keep + _file->read(_window + keep, READER_WINDOW - keep);
+    }
+#endif
+};
+
+typedef std::pair<size_t, size_t> ByteRange;
+
+// Script elements the portal strips from custom templates; only our own
+// portal script (or one pulling in {{JS}}/{{JS_URL}}) is kept
+void findStrippedElements(TemplateReader& reader, std::vector<ByteRange>& ranges) {
+    while (!reader.atEnd()) {
+        if (!reader.matches("<script")) {
+            reader.advance();
+            continue;
+        }
+
+        size_t start = reader.position();
+        bool keep = false;
+        while (!reader.atEnd() && !reader.matches("</script>")) {
+            keep = keep || reader.matches("portal.js") || reader.matches("scanNetworks") || reader.matches("{{JS");
+            reader.advance();
+        }
+        if (reader.atEnd()) {
+            break;   // Unterminated: left alone
+        }
+        reader.advance(9);
+        if (!keep) {
+            ranges.push_back(ByteRange(start, reader.position()));
+        }
+    }
+    reader.rewind();
+}
+
+// Runtime counterpart of tokenize_template() in tools/embed_assets.py.
+// Stripped ranges are left out of the literal text.
+bool compileTemplate(TemplateReader& reader, const std::vector<ByteRange>& stripped,
+                     std::vector<FlexifiAssets::TemplateSegment>& segments, bool control) {
+    segments.clear();
+    size_t start = 0;      // Literal text not yet in a segment
+    size_t range = 0;      // Next stripped range
+
+    struct Block {
+        bool each;
+        size_t opening;    // Segment holding OP_IF / OP_EACH
+        int otherwise;     // Segment holding OP_ELSE, -1 if none
+    };
+    std::vector<Block> blocks;
+    uint8_t loops = 0;
+
+    auto add = [&](size_t end, uint8_t variable, uint8_t op, uint16_t jump) -> size_t {
+        // Lengths are 16-bit; split any longer literal run
+        size_t offset = start;
+        size_t length = end - start;
+        while (length > 0xFFFF) {
+            segments.push_back({(uint32_t)offset, 0xFFFF, FlexifiAssets::VAR_NONE, FlexifiAssets::OP_EMIT, 0});
+            offset += 0xFFFF;
+            length -= 0xFFFF;
+        }
+        segments.push_back({(uint32_t)offset, (uint16_t)length, variable, op, jump});
+        return segments.size() - 1;
+    };
+    auto fail = [&](const char* message) {
+        FLEXIFI_LOGW("Template error on line %d: %s", reader.line(), message);
+        segments.clear();
+        return false;
+    };
+
+    char text[MAX_TAG_LENGTH + 1];
+    Tag tag;
+    while (!reader.atEnd()) {
+        size_t here = reader.position();
+        if (range < stripped.size() && here == stripped[range].first) {
+            add(here, FlexifiAssets::VAR_NONE, FlexifiAssets::OP_EMIT, 0);
+            reader.advance(stripped[range].second - here);
+            start = reader.position();
+            range++;
+            continue;
+        }
+        if (reader.peek() != '{' || reader.peek(1) != '{') {
+            reader.advance();
+            continue;
+        }
+        reader.copy(text, sizeof(text));
+        if (!parseTag(text, tag)) {
+            reader.advance();
+            continue;
+        }
+
+        uint8_t variable = tag.name ? (uint8_t)variableFromName(tag.name, tag.nameLength) : (uint8_t)FlexifiAssets::VAR_NONE;
+        if (tag.kind == TagKind::PLACEHOLDER || !control) {
+            if (tag.kind != TagKind::PLACEHOLDER || variable == FlexifiAssets::VAR_NONE) {
+                reader.advance();   // Unknown names stay in the literal text
+                continue;
+            }
+            add(here, variable, FlexifiAssets::OP_EMIT, 0);
+        } else if (tag.kind == TagKind::IF) {
+            if (variable == FlexifiAssets::VAR_NONE) {
+                return fail("unknown variable in {{#if}}");
+            }
+            blocks.push_back({false, add(here, variable, FlexifiAssets::OP_IF, 0), -1});
+        } else if (tag.kind == TagKind::EACH) {
+            if (variable != FlexifiAssets::VAR_NETWORKS && variable != FlexifiAssets::VAR_PARAMETERS) {
+                return fail("{{#each}} needs NETWORKS or PARAMETERS");
+            }
+            if (loops >= TemplateStream::MAX_LOOP_DEPTH) {
+                return fail("{{#each}} nested too deeply");
+            }
+            loops++;
+            blocks.push_back({true, add(here, variable, FlexifiAssets::OP_EACH, 0), -1});
+        } else if (tag.kind == TagKind::ELSE) {
+            if (blocks.empty() || blocks.back().each || blocks.back().otherwise >= 0) {
+                return fail("{{else}} outside {{#if}}");
+            }
+            blocks.back().otherwise = add(here, FlexifiAssets::VAR_NONE, FlexifiAssets::OP_ELSE, 0);
+            segments[blocks.back().opening].jump = blocks.back().otherwise + 1;
+        } else if (tag.kind == TagKind::END_IF) {
+            if (blocks.empty() || blocks.back().each) {
+                return fail("{{/if}} without {{#if}}");
+            }
+            Block block = blocks.back();
+            blocks.pop_back();
+            size_t index = add(here, FlexifiAssets::VAR_NONE, FlexifiAssets::OP_EMIT, 0);
+            segments[block.otherwise >= 0 ? block.otherwise : block.opening].jump = index + 1;
+        } else {
+            if (blocks.empty() || !blocks.back().each) {
+                return fail("{{/each}} without {{#each}}");
+            }
+            Block block = blocks.back();
+            blocks.pop_back();
+            loops--;
+            size_t index = add(here, FlexifiAssets::VAR_NONE, FlexifiAssets::OP_END_EACH, block.opening + 1);
+            segments[block.opening].jump = index + 1;
+        }
+        reader.advance(tag.length);
+        start = reader.position();
+    }
+
+    if (!blocks.empty()) {
+        return fail(blocks.back().each ? "unclosed {{#each}}" : "unclosed {{#if}}");
+    }
+    add(reader.length(), FlexifiAssets::VAR_NONE, FlexifiAssets::OP_EMIT, 0);
+    if (segments.size() > 0xFFFF) {
+        return fail("too many segments");
+    }
+    return true;
+}
+
+// Supplies {{CUSTOM_PARAMETERS}} for the String-based getPortalHTML()
+class StaticParameters : public TemplateData {
+public:
+    explicit StaticParameters(const String& html) : _html(html) {}
+
+    bool write(uint8_t variable, uint8_t /*collection*/, size_t /*index*/, Print& out) const override {
+        if (variable != FlexifiAssets::VAR_CUSTOM_PARAMETERS) {
+            return false;
+        }
+        out.print(_html);
+        return true;
+    }
+
+private:
+    String _html;
+};
+}
+
+struct TemplateManager::CompiledTemplate {
+    String source;          // Template text; empty when it streams from a file
+    String path;            // LittleFS path, or empty
+    size_t size;            // File size when it was compiled
+    time_t modified;        // File timestamp when it was compiled
+    std::vector<FlexifiAssets::TemplateSegment> segments;
+
+    CompiledTemplate() : size(0), modified(0) {}
+};
 
 TemplateManager::TemplateManager() :
     _currentTemplate("modern"),
-    _customTemplate(""),
-    _usingCustomTemplate(false) {
+    _usingCustomTemplate(false),
+    _templateVersion(0),
+    _page(nullptr),
+    _stylesheet(nullptr),
+    _renderCacheBudget(FLEXIFI_RENDER_CACHE_BUDGET),
+    _renderCacheTemplate(0),
+    _renderCacheData(0),
+    _renderCacheValid(false) {
+    _selectAssets();
 }
 
 TemplateManager::~TemplateManager() {
@@ -14,6 +554,7 @@ TemplateManager::~TemplateManager() {
 
 void TemplateManager::setTemplate(const String& templateName) {
     FLEXIFI_LOGD("Setting template to: %s", templateName.c_str());
+    _templateVersion++;
 
     if (isValidTemplate(templateName)) {
         _currentTemplate = templateName;
@@ -24,20 +565,52 @@ void TemplateManager::setTemplate(const String& templateName) {
         _currentTemplate = "modern";
         _usingCustomTemplate = false;
     }
+    _selectAssets();
 }
 
 void TemplateManager::setCustomTemplate(const String& htmlTemplate) {
     FLEXIFI_LOGD("Setting custom template (%d chars)", htmlTemplate.length());
+    _templateVersion++;
 
     if (htmlTemplate.isEmpty()) {
         FLEXIFI_LOGW("Custom template is empty, reverting to default");
         _usingCustomTemplate = false;
+        _selectAssets();
         return;
     }
 
-    _customTemplate = _sanitizeTemplate(htmlTemplate);
+    // Compile once here; renders then walk the segment table
+    std::shared_ptr<CompiledTemplate> compiled = std::make_shared<CompiledTemplate>();
+    compiled->source = htmlTemplate;
+    _compile(*compiled);
+    _customTemplate = compiled;
     _usingCustomTemplate = true;
-    FLEXIFI_LOGI("Custom template set successfully");
+    _selectAssets();
+    FLEXIFI_LOGI("Custom template set successfully (%d segments)", compiled->segments.size());
+}
+
+bool TemplateManager::setCustomTemplateFile(const String& path) {
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    FLEXIFI_LOGD("Setting custom template file: %s", path.c_str());
+
+    // Only the segment table stays in RAM; the text streams from flash
+    std::shared_ptr<CompiledTemplate> compiled = std::make_shared<CompiledTemplate>();
+    compiled->path = path;
+    if (!_compile(*compiled)) {
+        FLEXIFI_LOGW("Custom template file unavailable: %s", path.c_str());
+        return false;
+    }
+    _customTemplate = compiled;
+    _usingCustomTemplate = true;
+    _selectAssets();
+    _templateVersion++;
+    FLEXIFI_LOGI("Custom template file set: %s (%d bytes, %d segments)", 
+                 path.c_str(), compiled->size, compiled->segments.size());
+    return true;
+#else
+    FLEXIFI_LOGW("Template files need LittleFS (FLEXIFI_DISABLE_LITTLEFS is set)");
+    return false;
+#endif
 }
 
 String TemplateManager::getCurrentTemplate() const {
@@ -47,18 +620,132 @@ String TemplateManager::getCurrentTemplate() const {
 String TemplateManager::getPortalHTML(const String& customParameters) const {
     FLEXIFI_LOGD("Generating portal HTML");
 
-    String html;
+    StreamString html;
+    createStream(std::make_shared<StaticParameters>(customParameters))->renderTo(html);
+    return html;
+}
 
-    if (_usingCustomTemplate) {
-        html = _customTemplate;
+const uint8_t* TemplateManager::getPrerenderedPage(size_t& length) const {
+    const FlexifiAssets::Asset* page = _page.load();
+    length = page ? page->gzipLength : 0;
+    return page ? page->gzip : nullptr;
+}
+
+bool TemplateManager::getAsset(const String& path, FlexifiAsset& asset) const {
+    if (path == "/flexifi.css") {
+        const FlexifiAssets::Asset* entry = _stylesheet.load();
+        if (!entry) {
+            return false;
+        }
+        asset.data = (const uint8_t*)entry->data;
+        asset.length = entry->length;
+        asset.gzip = entry->gzip;
+        asset.gzipLength = entry->gzipLength;
+        asset.etag = entry->etag;
+        asset.mimeType = entry->mimeType;
+    } else if (path == "/flexifi.js") {
+        asset.data = (const uint8_t*)FlexifiAssets::getJS("portal");
+        asset.length = FlexifiAssets::getJSSize("portal");
+        asset.gzip = FlexifiAssets::getJSGzip("portal");
+        asset.gzipLength = FlexifiAssets::getJSGzipSize("portal");
+        asset.etag = FlexifiAssets::getJSETag("portal");
+        asset.mimeType = "application/javascript";
+    } else if (path.startsWith("/assets/")) {
+        // Any embedded file by its path under src/web; templates and pages have no ETag and stay internal
+        const FlexifiAssets::Asset* entry = FlexifiAssets::findAsset(path.c_str() + strlen("/assets/"));
+        if (!entry) {
+            return false;
+        }
+        asset.data = (const uint8_t*)entry->data;
+        asset.length = entry->length;
+        asset.gzip = entry->gzip;
+        asset.gzipLength = entry->gzipLength;
+        asset.etag = entry->etag;
+        asset.mimeType = entry->mimeType;
     } else {
-        html = _getBuiltinTemplate(_currentTemplate);
+        return false;
     }
+    return asset.data && asset.etag;
+}
 
-    // Basic variable replacement for static content
-    html = replaceVariables(html, "[]", "ready", "Flexifi Setup", customParameters);
+std::shared_ptr<TemplateStream> TemplateManager::createStream(std::shared_ptr<const TemplateData> data) const {
+    _reloadChangedTemplate();
+    return _createStream(data);
+}
 
-    return html;
+std::shared_ptr<const FlexifiRenderedPage> TemplateManager::getRenderedPage(
+        uint64_t dataVersion, std::shared_ptr<const TemplateData> data) const {
+    if (_renderCacheBudget == 0) {
+        return nullptr;
+    }
+
+    _reloadChangedTemplate();
+    if (_renderCacheValid && _renderCacheTemplate == _templateVersion && _renderCacheData == dataVersion) {
+        return _renderCache;
+    }
+
+    // Render into a buffer that grows up to the budget; a page that doesn't
+    // fit is remembered as such, so it streams without another attempt
+    std::shared_ptr<FlexifiRenderedPage> page = std::make_shared<FlexifiRenderedPage>();
+    uint32_t caps = psramFound() ? MALLOC_CAP_SPIRAM : MALLOC_CAP_8BIT;
+    size_t capacity = 0;
+    std::shared_ptr<TemplateStream> stream = _createStream(data);
+
+    while (!stream->isDone()) {
+        if (page->length == capacity) {
+            if (capacity == _renderCacheBudget) {
+                page.reset();
+                break;
+            }
+            size_t grown = capacity ? capacity * 2 : 1024;
+            grown = grown < _renderCacheBudget ? grown : _renderCacheBudget;
+            uint8_t* buffer = (uint8_t*)heap_caps_realloc(page->data, grown, caps);
+            if (!buffer) {
+                page.reset();
+                break;
+            }
+            page->data = buffer;
+            capacity = grown;
+        }
+        size_t length = stream->read(page->data + page->length, capacity - page->length);
+        if (length == 0) {
+            break;
+        }
+        page->length += length;
+    }
+
+    if (page && page->length && page->length < capacity) {
+        uint8_t* buffer = (uint8_t*)heap_caps_realloc(page->data, page->length, caps);
+        if (buffer) {
+            page->data = buffer;
+        }
+    }
+#ifdef FLEXIFI_RENDER_CACHE_GZIP
+    if (page) {
+        compressPage(*page, caps);
+    }
+#endif
+
+    if (page) {
+        FLEXIFI_LOGD("Render cache filled: %d bytes%s", page->length, page->gzip ? " (gzip)" : "");
+    } else {
+        FLEXIFI_LOGD("Page exceeds the render cache budget (%d bytes), streaming instead", _renderCacheBudget);
+    }
+    _renderCache = page;
+    _renderCacheTemplate = _templateVersion;
+    _renderCacheData = dataVersion;
+    _renderCacheValid = true;
+    return _renderCache;
+}
+
+void TemplateManager::setRenderCacheBudget(size_t bytes) {
+    _renderCacheBudget = bytes;
+    clearRenderCache();
+}
+
+void TemplateManager::clearRenderCache() {
+    _renderCache.reset();
+    _renderCacheValid = false;
 }
 
 String TemplateManager::processTemplate(const String& templateStr, const String& networks,
@@ -84,6 +771,17 @@ String TemplateManager::getAvailableTemplates() const {
     return "modern,classic,minimal,default";
 }
 
+bool TemplateManager::hasParametersPlaceholder() const {
+    size_t count = 0;
+    const FlexifiAssets::TemplateSegment* segments = _getSegments(count);
+    for (size_t i = 0; i < count; i++) {
+        if (segments[i].variable == FlexifiAssets::VAR_CUSTOM_PARAMETERS) {
+            return true;
+        }
+    }
+    return false;
+}
+
 String TemplateManager::replaceVariables(const String& html, const String& networks,
                                        const String& status, const String& title,
                                        const String& customParameters) const {
@@ -102,12 +800,39 @@ String TemplateManager::replaceVariables(const String& html, const String& netwo
     result.replace("{{CUSTOM_PARAMETERS}}", customParameters);
 
     // Replace other common variables
-    result.replace("{{VERSION}}", "1.0.0");
-    result.replace("{{DEVICE_NAME}}", "Flexifi Device");
+    result.replace("{{VERSION}}", TEMPLATE_VERSION);
+    result.replace("{{DEVICE_NAME}}", DEVICE_NAME);
 
     return result;
 }
 
+void TemplateManager::writeEscaped(Print& out, const char* text) {
+    // Single pass: copy runs of safe characters, substitute the rest
+    const char* start = text;
+    const char* p = start;
+
+    for (; *p; p++) {
+        const char* entity;
+        switch (*p) {
+            case '&':  entity = "&amp;"; break;
+            case '<':  entity = "&lt;"; break;
+            case '>':  entity = "&gt;"; break;
+            case '"':  entity = "&quot;"; break;
+            case '\'': entity = "&#39;"; break;
+            default:   continue;
+        }
+        if (p > start) {
+            out.write((const uint8_t*)start, p - start);
+        }
+        out.print(entity);
+        start = p + 1;
+    }
+
+    if (p > start) {
+        out.write((const uint8_t*)start, p - start);
+    }
+}
+
 // Private methods
 
 String TemplateManager::_getBuiltinTemplate(const String& name) const {
@@ -129,24 +854,33 @@ String TemplateManager::_getBuiltinTemplate(const String& name) const {
 String TemplateManager::_injectEmbeddedAssets(const String& html, const String& templateName) const {
     String result = html;
 
-    // Inject CSS based on template name
+    // Inject CSS based on template name; linked assets avoid copying it at all
     const char* cssData = FlexifiAssets::getCSS(templateName.c_str());
     if (cssData) {
-        String cssContent = String(cssData);
+        result.replace("{{CSS_URL}}", String("/flexifi.css?v=") + FlexifiAssets::getCSSETag(templateName.c_str()));
+
         String upperTemplateName = templateName;
         upperTemplateName.toUpperCase();
-        result.replace("{{CSS_" + upperTemplateName + "}}", cssContent);
+        String namedPlaceholder = "{{CSS_" + upperTemplateName + "}}";
+        if (result.indexOf(namedPlaceholder) >= 0 || result.indexOf("{{CSS}}") >= 0) {
+            String cssContent = String(cssData);
+            result.replace(namedPlaceholder, cssContent);
 
-        // Also handle generic CSS placeholder
-        result.replace("{{CSS}}", cssContent);
+            // Also handle generic CSS placeholder
+            result.replace("{{CSS}}", cssContent);
+        }
     }
 
     // Inject JavaScript
     const char* jsData = FlexifiAssets::getJS("portal");
     if (jsData) {
-        String jsContent = String(jsData);
-        result.replace("{{JS_PORTAL}}", jsContent);
-        result.replace("{{JS}}", jsContent);
+        result.replace("{{JS_URL}}", String("/flexifi.js?v=") + FlexifiAssets::getJSETag("portal"));
+
+        if (result.indexOf("{{JS_PORTAL}}") >= 0 || result.indexOf("{{JS}}") >= 0) {
+            String jsContent = String(jsData);
+            result.replace("{{JS_PORTAL}}", jsContent);
+            result.replace("{{JS}}", jsContent);
+        }
     }
 
     return result;
@@ -158,6 +892,171 @@ String TemplateManager::_getDefaultTemplate() const {
     return _getBuiltinTemplate("modern");
 }
 
+const FlexifiAssets::TemplateSegment* TemplateManager::_getSegments(size_t& count) const {
+    if (_usingCustomTemplate) {
+        count = _customTemplate->segments.size();
+        return _customTemplate->segments.data();
+    }
+
+    // Unknown names fall back to modern, as _getBuiltinTemplate() does
+    const char* name = FlexifiAssets::getTemplate(_currentTemplate.c_str()) ? _currentTemplate.c_str() : "modern";
+    count = FlexifiAssets::getTemplateSegmentCount(name);
+    return FlexifiAssets::getTemplateSegments(name);
+}
+
+void TemplateManager::_reloadChangedTemplate() const {
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    if (_usingCustomTemplate && !_customTemplate->path.isEmpty()) {
+        // Offsets are only valid for the file they were compiled from
+        File file = LittleFS.open(_customTemplate->path, FILE_READ);
+        if (file && (file.size() != _customTemplate->size || file.getLastWrite() != _customTemplate->modified)) {
+            file.close();
+            FLEXIFI_LOGI("Custom template file changed, recompiling: %s", _customTemplate->path.c_str());
+            std::shared_ptr<CompiledTemplate> compiled = std::make_shared<CompiledTemplate>();
+            compiled->path = _customTemplate->path;
+            if (_compile(*compiled)) {
+                _customTemplate = compiled;
+                _templateVersion++;
+            }
+        }
+    }
+#endif
+}
+
+std::shared_ptr<TemplateStream> TemplateManager::_createStream(std::shared_ptr<const TemplateData> data) const {
+    if (_usingCustomTemplate) {
+        const char* source = _customTemplate->path.isEmpty() ? _customTemplate->source.c_str() : nullptr;
+        return std::make_shared<TemplateStream>(source, _customTemplate->segments.data(),
+                                                _customTemplate->segments.size(), _customTemplate, data,
+                                                _stylesheet.load());
+    }
+
+    size_t count = 0;
+    const FlexifiAssets::TemplateSegment* segments = _getSegments(count);
+    const char* source = FlexifiAssets::getTemplate(_currentTemplate.c_str());
+    if (!source) {
+        source = FlexifiAssets::getTemplate("modern");  // Same fallback as _getDefaultTemplate()
+    }
+    return std::make_shared<TemplateStream>(source, segments, source ? count : 0, nullptr, data, _stylesheet.load());
+}
+
+bool TemplateManager::_compile(CompiledTemplate& compiled) {
+    std::vector<ByteRange> stripped;
+    auto build = [&](TemplateReader& reader) {
+        findStrippedElements(reader, stripped);
+        if (!compileTemplate(reader, stripped, compiled.segments, true)) {
+            FLEXIFI_LOGW("Custom template blocks ignored, rendering variables only");
+            reader.rewind();
+            compileTemplate(reader, stripped, compiled.segments, false);
+        }
+        if (!stripped.empty()) {
+            FLEXIFI_LOGW("Removed %d script element(s) from custom template", stripped.size());
+        }
+    };
+
+    if (compiled.path.isEmpty()) {
+        TemplateReader reader(compiled.source.c_str(), compiled.source.length());
+        build(reader);
+        return true;
+    }
+
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    File file = LittleFS.open(compiled.path, FILE_READ);
+    if (!file || file.isDirectory()) {
+        return false;
+    }
+    compiled.size = file.size();
+    compiled.modified = file.getLastWrite();
+    TemplateReader reader(file);
+    build(reader);
+    file.close();
+    return true;
+#else
+    return false;
+#endif
+}
+
+void TemplateManager::_writeVariable(uint8_t variable, uint8_t collection, size_t index, Print& out,
+                                     const TemplateData* data, const FlexifiAssets::Asset* stylesheet) {
+    if (data && data->write(variable, collection, index, out)) {
+        return;
+    }
+
+    // Same values replaceVariables() substitutes
+    switch (variable) {
+        case FlexifiAssets::VAR_NONE:
+            break;
+        case FlexifiAssets::VAR_TITLE:
+            out.print(DEFAULT_TITLE);
+            break;
+        case FlexifiAssets::VAR_NETWORKS:
+            _writeNetworkList(out, data);
+            break;
+        case FlexifiAssets::VAR_STATUS:
+            out.print(_generateStatusHTML("ready"));
+            break;
+        case FlexifiAssets::VAR_VERSION:
+            out.print(TEMPLATE_VERSION);
+            break;
+        case FlexifiAssets::VAR_DEVICE_NAME:
+            out.print(DEVICE_NAME);
+            break;
+        case FlexifiAssets::VAR_CSS_URL:
+            out.print("/flexifi.css?v=");
+            if (stylesheet) {
+                out.print(stylesheet->etag);
+            }
+            break;
+        case FlexifiAssets::VAR_CSS:
+            if (stylesheet) {
+                out.write((const uint8_t*)stylesheet->data, stylesheet->length);
+            }
+            break;
+        case FlexifiAssets::VAR_JS_URL:
+            out.print("/flexifi.js?v=");
+            out.print(FlexifiAssets::getJSETag("portal"));
+            break;
+        case FlexifiAssets::VAR_JS:
+            out.write((const uint8_t*)FlexifiAssets::getJS("portal"), FlexifiAssets::getJSSize("portal"));
+            break;
+        default: {
+            // {{CSS_<NAME>}} names a stylesheet explicitly
+            char style[16];
+            if (variable < FlexifiAssets::VAR_COUNT &&
+                strncmp(FlexifiAssets::template_variable_names[variable], "CSS_", 4) == 0) {
+                const char* name = FlexifiAssets::template_variable_names[variable] + 4;
+                size_t i = 0;
+                for (; name[i] && i < sizeof(style) - 1; i++) {
+                    style[i] = tolower((unsigned char)name[i]);
+                }
+                style[i] = '\0';
+            } else {
+                break;
+            }
+            const char* css = FlexifiAssets::getCSS(style);
+            if (css) {
+                out.write((const uint8_t*)css, FlexifiAssets::getCSSSize(style));
+            }
+            break;
+        }
+    }
+}
+
+const char* TemplateManager::_getStyleName() const {
+    // Custom templates and unknown names use the modern stylesheet
+    if (!_usingCustomTemplate && FlexifiAssets::getCSS(_currentTemplate.c_str())) {
+        return _currentTemplate.c_str();
+    }
+    return "modern";
+}
+
+void TemplateManager::_selectAssets() {
+    // Unknown names fall back to modern, as _getBuiltinTemplate() does
+    const char* name = FlexifiAssets::getTemplate(_currentTemplate.c_str()) ? _currentTemplate.c_str() : "modern";
+    _page = _usingCustomTemplate ? nullptr : FlexifiAssets::findAsset("pages", name, ".html");
+    _stylesheet = FlexifiAssets::findAsset("css", _getStyleName(), ".css");
+}
+
 String TemplateManager::_processVariables(const String& html, const String& networks,
                                         const String& status, const String& title, const String& customParameters) const {
     return replaceVariables(html, networks, status, title, customParameters);
@@ -165,10 +1064,18 @@ String TemplateManager::_processVariables(const String& html, const String& netw
 
 String TemplateManager::_generateNetworkList(const String& networksJSON) const {
     if (networksJSON.isEmpty() || networksJSON == "[]") {
-        return "<p>No networks found. Click 'Scan Networks' to search for available WiFi networks.</p>";
+        return NO_NETWORKS_HTML;
     }
 
-    DynamicJsonDocument doc(2048);
+    // Size the document from the input instead of a fixed ceiling: one object per '{',
+    // plus room for every string it copies (never more than the input itself)
+    size_t objects = 0;
+    for (const char* p = networksJSON.c_str(); *p; p++) {
+        if (*p == '{') {
+            objects++;
+        }
+    }
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(objects) + objects * JSON_OBJECT_SIZE(5) + networksJSON.length());
     DeserializationError error = deserializeJson(doc, networksJSON);
 
     if (error) {
@@ -176,43 +1083,38 @@ String TemplateManager::_generateNetworkList(const String& networksJSON) const {
         return "<p>Error parsing network list</p>";
     }
 
-    String html = "<div class=\"network-list\">";
+    JsonNetworkData data(doc.as<JsonArray>());
+    StreamString html;
+    html.reserve(networksJSON.length() + objects * 128);
+    _writeNetworkList(html, &data);
+    return html;
+}
 
-    for (JsonVariant network : doc.as<JsonArray>()) {
-        String ssid = network["ssid"].as<String>();
-        int rssi = network["rssi"].as<int>();
-        bool secure = network["secure"].as<bool>();
+void TemplateManager::_writeNetworkList(Print& out, const TemplateData* data) {
+    size_t count = data ? data->count(FlexifiAssets::VAR_NETWORKS) : 0;
+    if (count == 0) {
+        out.print(NO_NETWORKS_HTML);
+        return;
+    }
 
-        String securityIcon = secure ? "🔒" : "🔓";
-        String signalStrength = network["signal_strength"].as<String>();
+    out.print("<div class=\"network-list\">");
+    for (size_t i = 0; i < count; i++) {
+        TruthSink secure;
+        data->write(FlexifiAssets::VAR_SECURE, FlexifiAssets::VAR_NETWORKS, i, secure);
 
-        // Fallback signal strength calculation if not provided
-        if (signalStrength.isEmpty()) {
-            if (rssi > -50) {
-                signalStrength = "📶📶📶📶";
-            } else if (rssi > -60) {
-                signalStrength = "📶📶📶";
-            } else if (rssi > -70) {
-                signalStrength = "📶📶";
-            } else if (rssi > -80) {
-                signalStrength = "📶";
-            } else {
-                signalStrength = "📵";
-            }
-        }
-
-        html += "<div class=\"network-item\" onclick=\"selectNetwork('" +
-                _escapeHTML(ssid) + "')\">";
-        html += "<span class=\"network-name\">" + _escapeHTML(ssid) + "</span>";
-        html += "<span class=\"network-info\">" + securityIcon + " " + signalStrength + "</span>";
-        html += "</div>";
+        out.print("<div class=\"network-item\" onclick=\"selectNetwork('");
+        data->write(FlexifiAssets::VAR_SSID, FlexifiAssets::VAR_NETWORKS, i, out);
+        out.print("')\"><span class=\"network-name\">");
+        data->write(FlexifiAssets::VAR_SSID, FlexifiAssets::VAR_NETWORKS, i, out);
+        out.print("</span><span class=\"network-info\">");
+        out.print(secure.truthy() ? "🔒 " : "🔓 ");
+        data->write(FlexifiAssets::VAR_SIGNAL, FlexifiAssets::VAR_NETWORKS, i, out);
+        out.print("</span></div>");
     }
-
-    html += "</div>";
-    return html;
+    out.print("</div>");
 }
 
-String TemplateManager::_generateStatusHTML(const String& status) const {
+String TemplateManager::_generateStatusHTML(const String& status) {
     if (status == "scanning") {
         return "<div class=\"status scanning\">🔄 Scanning for networks...</div>";
     } else if (status == "connecting") {
@@ -308,36 +1210,150 @@ String TemplateManager::_getPortalJS() const {
     return "";
 }
 
-String TemplateManager::_escapeHTML(const String& text) const {
-    String escaped = text;
-    escaped.replace("&", "&amp;");
-    escaped.replace("<", "&lt;");
-    escaped.replace(">", "&gt;");
-    escaped.replace("\"", "&quot;");
-    escaped.replace("'", "&#39;");
-    return escaped;
-}
-
-String TemplateManager::_sanitizeTemplate(const String& html) const {
-    // Basic sanitization - remove potentially dangerous elements
-    String sanitized = html;
-
-    // Remove script tags (except our own portal script)
-    int scriptStart = 0;
-    while ((scriptStart = sanitized.indexOf("<script", scriptStart)) != -1) {
-        int scriptEnd = sanitized.indexOf("</script>", scriptStart);
-        if (scriptEnd != -1) {
-            String scriptContent = sanitized.substring(scriptStart, scriptEnd + 9);
-            if (scriptContent.indexOf("portal.js") == -1 &&
-                scriptContent.indexOf("scanNetworks") == -1) {
-                sanitized.remove(scriptStart, scriptEnd - scriptStart + 9);
-            } else {
-                scriptStart = scriptEnd + 9;
-            }
+// TemplateStream
+
+TemplateStream::TemplateStream(const char* source, const FlexifiAssets::TemplateSegment* segments,
+                               size_t segmentCount,
+                               std::shared_ptr<const TemplateManager::CompiledTemplate> owner,
+                               std::shared_ptr<const TemplateData> data,
+                               const FlexifiAssets::Asset* stylesheet) :
+    _owner(owner),
+    _source(source),
+    _segments(segments),
+    _segmentCount(segments ? segmentCount : 0),
+    _segmentIndex(0),
+    _literalOffset(0),
+    _expansionOffset(0),
+    _data(data),
+    _stylesheet(stylesheet),
+    _depth(0) {
+}
+
+size_t TemplateStream::read(uint8_t* buffer, size_t maxLength) {
+    ChunkSink sink(buffer, maxLength);
+
+    while (_segmentIndex < _segmentCount && !sink.full()) {
+        const FlexifiAssets::TemplateSegment& segment = _segments[_segmentIndex];
+        if (_literalOffset < segment.length) {
+            // Literal text, copied straight from the template
+            size_t remaining = segment.length - _literalOffset;
+            size_t room = maxLength - sink.length();
+            size_t count = remaining < room ? remaining : room;
+            _writeLiteral(segment.offset + _literalOffset, count, sink);
+            _literalOffset += count;
+            continue;
+        }
+
+        if (segment.op != FlexifiAssets::OP_EMIT) {
+            _segmentIndex = _execute(segment);
+            _literalOffset = 0;
+            continue;
+        }
+
+        // Regenerate the expansion, skipping what earlier chunks already sent
+        sink.beginSegment(_expansionOffset);
+        _emit(segment.variable, sink);
+        if (sink.overflowed()) {
+            _expansionOffset = sink.segmentBytes();
+            break;
+        }
+        sink.beginSegment(0);
+        _expansionOffset = 0;
+        _literalOffset = 0;
+        _segmentIndex++;
+    }
+
+    return sink.length();
+}
+
+void TemplateStream::renderTo(Print& out) {
+    while (_segmentIndex < _segmentCount) {
+        const FlexifiAssets::TemplateSegment& segment = _segments[_segmentIndex];
+        _writeLiteral(segment.offset, segment.length, out);
+        if (segment.op == FlexifiAssets::OP_EMIT) {
+            _emit(segment.variable, out);
+            _segmentIndex++;
         } else {
+            _segmentIndex = _execute(segment);
+        }
+    }
+    _literalOffset = 0;
+    _expansionOffset = 0;
+}
+
+void TemplateStream::_writeLiteral(size_t offset, size_t length, Print& out) {
+    if (_source) {
+        out.write((const uint8_t*)_source + offset, length);
+        return;
+    }
+
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    if (!_file) {
+        _file = LittleFS.open(_owner->path, FILE_READ);
+        if (!_file) {
+            FLEXIFI_LOGE("Failed to open template file: %s", _owner->path.c_str());
+            return;
+        }
+    }
+    if (_file.position() != offset) {
+        _file.seek(offset);
+    }
+
+    uint8_t block[128];
+    while (length > 0) {
+        size_t count = _file.read(block, length < sizeof(block) ? length : sizeof(block));
+        if (count == 0) {
             break;
         }
+        out.write(block, count);
+        length -= count;
     }
+#endif
+}
+
+void TemplateStream::_emit(uint8_t variable, Print& out) const {
+    // Item fields refer to the innermost loop
+    const Loop* loop = _depth ? &_loops[_depth - 1] : nullptr;
+    TemplateManager::_writeVariable(variable, loop ? loop->collection : (uint8_t)FlexifiAssets::VAR_NONE,
+                                    loop ? loop->index : 0, out, _data.get(), _stylesheet);
+}
 
-    return sanitized;
+bool TemplateStream::_test(uint8_t variable) const {
+    if (variable == FlexifiAssets::VAR_NETWORKS || variable == FlexifiAssets::VAR_PARAMETERS) {
+        return _data && _data->count(variable) > 0;
+    }
+    TruthSink sink;
+    _emit(variable, sink);
+    return sink.truthy();
+}
+
+size_t TemplateStream::_execute(const FlexifiAssets::TemplateSegment& segment) {
+    size_t next = _segmentIndex + 1;
+    switch (segment.op) {
+        case FlexifiAssets::OP_IF:
+            return _test(segment.variable) ? next : segment.jump;
+        case FlexifiAssets::OP_ELSE:
+            return segment.jump;
+        case FlexifiAssets::OP_EACH: {
+            size_t count = _data ? _data->count(segment.variable) : 0;
+            if (count == 0 || _depth >= MAX_LOOP_DEPTH) {
+                return segment.jump;
+            }
+            _loops[_depth++] = {segment.variable, 0, count};
+            return next;
+        }
+        case FlexifiAssets::OP_END_EACH: {
+            if (_depth == 0) {
+                return next;
+            }
+            Loop& loop = _loops[_depth - 1];
+            if (++loop.index < loop.count) {
+                return segment.jump;
+            }
+            _depth--;
+            return next;
+        }
+        default:
+            return next;
+    }
 }
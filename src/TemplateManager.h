@@ -2,35 +2,113 @@
 #define TEMPLATEMANAGER_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <memory>
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+#include <FS.h>
+#endif
+
+#ifndef FLEXIFI_RENDER_CACHE_BUDGET
+#define FLEXIFI_RENDER_CACHE_BUDGET 16384   // Largest page kept by the render cache (bytes); 0 disables it
+#endif
+
+class TemplateStream;
+namespace FlexifiAssets { struct TemplateSegment; struct Asset; }
+
+// Embedded file served on its own cacheable route
+struct FlexifiAsset {
+    const uint8_t* data;
+    size_t length;
+    const uint8_t* gzip;        // nullptr if there is no compressed variant
+    size_t gzipLength;
+    const char* etag;           // Build-time content hash, unquoted
+    const char* mimeType;
+};
+
+// Page held by the render cache, in PSRAM when the board has it
+struct FlexifiRenderedPage {
+    uint8_t* data;
+    size_t length;
+    bool gzip;                  // Compressed (FLEXIFI_RENDER_CACHE_GZIP)
+
+    FlexifiRenderedPage() : data(nullptr), length(0), gzip(false) {}
+    ~FlexifiRenderedPage() { free(data); }
+    FlexifiRenderedPage(const FlexifiRenderedPage&) = delete;
+    FlexifiRenderedPage& operator=(const FlexifiRenderedPage&) = delete;
+};
+
+// Live data a template renders against. Collections are VAR_NETWORKS and
+// VAR_PARAMETERS; item fields are written for `index` of the innermost
+// {{#each}} over `collection` (VAR_NONE outside a loop).
+class TemplateData {
+public:
+    virtual ~TemplateData() {}
+    virtual size_t count(uint8_t /*collection*/) const { return 0; }
+    // False falls back to the built-in value (title, version, assets, ...)
+    virtual bool write(uint8_t /*variable*/, uint8_t /*collection*/, size_t /*index*/, Print& /*out*/) const {
+        return false;
+    }
+};
 
 class TemplateManager {
 public:
+
+    struct CompiledTemplate;   // Custom template split into segments once, when it is set
+
     TemplateManager();
     ~TemplateManager();
 
     // Template management
     void setTemplate(const String& templateName);
     void setCustomTemplate(const String& htmlTemplate);
+    bool setCustomTemplateFile(const String& path);   // Streams from LittleFS; false if the file can't be read
     String getCurrentTemplate() const;
 
     // HTML generation
     String getPortalHTML(const String& customParameters = "") const;
+    const uint8_t* getPrerenderedPage(size_t& length) const;  // Gzipped built-in page in flash, or nullptr; lock-free
+    std::shared_ptr<TemplateStream> createStream(std::shared_ptr<const TemplateData> data = nullptr) const;
+    bool getAsset(const String& path, FlexifiAsset& asset) const;  // /flexifi.css (current template), /flexifi.js or /assets/<path>; lock-free
     String processTemplate(const String& templateStr, const String& networks,
                           const String& customParameters = "") const;
 
+    // Render cache: the last page, reused while the template and the caller's
+    // data version are unchanged. Null if the page doesn't fit the budget.
+    std::shared_ptr<const FlexifiRenderedPage> getRenderedPage(uint64_t dataVersion,
+                                                        std::shared_ptr<const TemplateData> data) const;
+    void setRenderCacheBudget(size_t bytes);   // 0 disables the cache
+    size_t getRenderCacheBudget() const { return _renderCacheBudget; }
+    void clearRenderCache();
+
     // Template validation
     bool isValidTemplate(const String& templateName) const;
     String getAvailableTemplates() const;
+    bool hasParametersPlaceholder() const;  // Template expects server-rendered {{CUSTOM_PARAMETERS}}
 
     // Variable replacement
     String replaceVariables(const String& html, const String& networks, 
                            const String& status = "", const String& title = "Flexifi Setup",
                            const String& customParameters = "") const;
+    static void writeEscaped(Print& out, const char* text);   // HTML-escapes in a single pass
 
 private:
+    friend class TemplateStream;
+
     String _currentTemplate;
-    String _customTemplate;
+    mutable std::shared_ptr<const CompiledTemplate> _customTemplate;   // Shared with in-flight streams
     bool _usingCustomTemplate;
+    mutable uint32_t _templateVersion;   // Bumped whenever the rendered template changes
+
+    // Flash entries for the current selection; swapped whole so web handlers need no lock
+    std::atomic<const FlexifiAssets::Asset*> _page;         // Pre-rendered page; nullptr for custom templates
+    std::atomic<const FlexifiAssets::Asset*> _stylesheet;   // Served as /flexifi.css
+
+    // Render cache (one page); a null page records that the last render didn't fit
+    size_t _renderCacheBudget;
+    mutable std::shared_ptr<const FlexifiRenderedPage> _renderCache;
+    mutable uint32_t _renderCacheTemplate;
+    mutable uint64_t _renderCacheData;
+    mutable bool _renderCacheValid;
 
     // Built-in templates
     String _getBuiltinTemplate(const String& name) const;
@@ -38,13 +116,16 @@ private:
     String _getClassicTemplate() const;
     String _getMinimalTemplate() const;
     String _getDefaultTemplate() const;
+    const char* _getStyleName() const;
+    void _selectAssets();
 
     // Template processing
     String _processVariables(const String& html, const String& networks, 
                             const String& status, const String& title,
                             const String& customParameters = "") const;
     String _generateNetworkList(const String& networksJSON) const;
-    String _generateStatusHTML(const String& status) const;
+    static void _writeNetworkList(Print& out, const TemplateData* data);   // Streams straight from the scan table
+    static String _generateStatusHTML(const String& status);
 
     // Legacy CSS and JavaScript methods (deprecated - now using embedded assets)
     String _getModernCSS() const;
@@ -55,9 +136,60 @@ private:
     // Asset injection
     String _injectEmbeddedAssets(const String& html, const String& templateName) const;
     
-    // Utility methods
-    String _escapeHTML(const String& text) const;
-    String _sanitizeTemplate(const String& html) const;
+    // Segment tables
+    const FlexifiAssets::TemplateSegment* _getSegments(size_t& count) const;
+    void _reloadChangedTemplate() const;   // Recompiles a template file edited on LittleFS
+    std::shared_ptr<TemplateStream> _createStream(std::shared_ptr<const TemplateData> data) const;
+    static bool _compile(CompiledTemplate& compiled);   // Strips scripts and builds the segment table
+    static void _writeVariable(uint8_t variable, uint8_t collection, size_t index, Print& out,
+                               const TemplateData* data, const FlexifiAssets::Asset* stylesheet);
+};
+
+// Incremental page renderer. Executes the template's segment table with a
+// cursor and a small loop stack, so a chunked response costs the chunk buffer
+// regardless of page or data size.
+// Literal text comes from flash: PROGMEM, or the template file on LittleFS.
+// Everything it reads is captured at construction, so chunks can be produced on
+// another task while the template is being changed.
+class TemplateStream {
+public:
+    static const uint8_t MAX_LOOP_DEPTH = 2;   // Nested {{#each}} blocks
+
+    TemplateStream(const char* source, const FlexifiAssets::TemplateSegment* segments, size_t segmentCount,
+                   std::shared_ptr<const TemplateManager::CompiledTemplate> owner,
+                   std::shared_ptr<const TemplateData> data, const FlexifiAssets::Asset* stylesheet);
+
+    size_t read(uint8_t* buffer, size_t maxLength);   // Next chunk; 0 once the page is complete
+    void renderTo(Print& out);                         // Whole page in one go (fresh stream only)
+    bool isDone() const { return _segmentIndex >= _segmentCount; }
+
+private:
+    std::shared_ptr<const TemplateManager::CompiledTemplate> _owner;   // Keeps a custom template alive
+    const char* _source;        // nullptr when reading from _owner's file
+    const FlexifiAssets::TemplateSegment* _segments;
+    size_t _segmentCount;
+    size_t _segmentIndex;       // Segment being emitted
+    size_t _literalOffset;      // Bytes of its literal text already sent
+    size_t _expansionOffset;    // Bytes of its placeholder expansion already sent
+    std::shared_ptr<const TemplateData> _data;
+    const FlexifiAssets::Asset* _stylesheet;   // {{CSS}} and {{CSS_URL}}; flash, never freed
+
+    struct Loop {
+        uint8_t collection;
+        size_t index;
+        size_t count;           // Taken once when the loop starts
+    };
+    Loop _loops[MAX_LOOP_DEPTH];
+    uint8_t _depth;
+
+#ifndef FLEXIFI_DISABLE_LITTLEFS
+    File _file;                 // Opened on first use
+#endif
+
+    void _writeLiteral(size_t offset, size_t length, Print& out);
+    void _emit(uint8_t variable, Print& out) const;
+    bool _test(uint8_t variable) const;
+    size_t _execute(const FlexifiAssets::TemplateSegment& segment);   // Control op; returns the next segment
 };
 
 #endif // TEMPLATEMANAGER_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef FLEXIFI_WEB_ASSET_TYPES_H
+#define FLEXIFI_WEB_ASSET_TYPES_H
+
+/*
+ * Auto-generated by tools/embed_assets.py - DO NOT EDIT MANUALLY!
+ *
+ * Template variable IDs and the segment table layout. Defines no data, so it
+ * can be included anywhere; the assets themselves are in web_assets.h.
+ */
+
+#include <Arduino.h>
+
+namespace FlexifiAssets {
+
+    // Template placeholders, resolved at build time
+    enum TemplateVariable : uint8_t {
+        VAR_NONE = 0,     // No placeholder: literal text only
+        VAR_TITLE,
+        VAR_NETWORKS,
+        VAR_STATUS,
+        VAR_CUSTOM_PARAMETERS,
+        VAR_VERSION,
+        VAR_DEVICE_NAME,
+        VAR_CSS,
+        VAR_CSS_URL,
+        VAR_JS,
+        VAR_JS_URL,
+        VAR_PARAMETERS,
+        VAR_SSID,
+        VAR_RSSI,
+        VAR_CHANNEL,
+        VAR_SECURE,
+        VAR_SIGNAL,
+        VAR_ID,
+        VAR_LABEL,
+        VAR_VALUE,
+        VAR_PARAMETER,
+        VAR_CSS_CLASSIC,
+        VAR_CSS_MINIMAL,
+        VAR_CSS_MODERN,
+        VAR_COUNT
+    };
+
+    // What a segment does after its literal text
+    enum TemplateOp : uint8_t {
+        OP_EMIT = 0,      // Write `variable`
+        OP_IF,            // Continue if `variable` is truthy, else go to `jump`
+        OP_ELSE,          // End of the true branch: go to `jump`
+        OP_EACH,          // Loop over the `variable` collection; empty goes to `jump`
+        OP_END_EACH       // Next item: back to `jump`, or fall through when done
+    };
+
+    // Literal run of a template followed by one instruction
+    struct TemplateSegment {
+        uint32_t offset;    // Byte offset of the literal text in the template
+        uint16_t length;    // Literal text length
+        uint8_t variable;   // TemplateVariable the instruction applies to
+        uint8_t op;         // TemplateOp
+        uint16_t jump;      // Target segment index for control ops
+    };
+
+} // namespace FlexifiAssets
+
+#endif // FLEXIFI_WEB_ASSET_TYPES_H
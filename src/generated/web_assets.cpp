@@ -3,43 +3,145 @@
 
 namespace FlexifiAssets {
 
+// Indexed by assetSlot(assetHash(path))
+constexpr Asset asset_table[ASSET_TABLE_SIZE] = {
+    { "css/classic.css", css_classic, css_classic_len, css_classic_gz, css_classic_gz_len, css_classic_etag, "text/css", nullptr, 0 },   // 0
+#ifndef FLEXIFI_DISABLE_PRERENDERED
+    { "pages/minimal.html", nullptr, 0, page_minimal_gz, page_minimal_gz_len, nullptr, "text/html", nullptr, 0 },   // 1
+#else
+    {},
+#endif
+    { "templates/minimal.html", template_minimal, template_minimal_len, nullptr, 0, nullptr, "text/html", template_minimal_segments, template_minimal_segments_count },   // 2
+    {},   // 3: empty
+    { "css/modern.css", css_modern, css_modern_len, css_modern_gz, css_modern_gz_len, css_modern_etag, "text/css", nullptr, 0 },   // 4
+    {},   // 5: empty
+    { "templates/classic.html", template_classic, template_classic_len, nullptr, 0, nullptr, "text/html", template_classic_segments, template_classic_segments_count },   // 6
+    { "js/portal.js", js_portal, js_portal_len, js_portal_gz, js_portal_gz_len, js_portal_etag, "application/javascript", nullptr, 0 },   // 7
+    {},   // 8: empty
+    { "templates/modern.html", template_modern, template_modern_len, nullptr, 0, nullptr, "text/html", template_modern_segments, template_modern_segments_count },   // 9
+    {},   // 10: empty
+    {},   // 11: empty
+    { "css/minimal.css", css_minimal, css_minimal_len, css_minimal_gz, css_minimal_gz_len, css_minimal_etag, "text/css", nullptr, 0 },   // 12
+#ifndef FLEXIFI_DISABLE_PRERENDERED
+    { "pages/classic.html", nullptr, 0, page_classic_gz, page_classic_gz_len, nullptr, "text/html", nullptr, 0 },   // 13
+#else
+    {},
+#endif
+#ifndef FLEXIFI_DISABLE_PRERENDERED
+    { "pages/modern.html", nullptr, 0, page_modern_gz, page_modern_gz_len, nullptr, "text/html", nullptr, 0 },   // 14
+#else
+    {},
+#endif
+    {},   // 15: empty
+};
+
+const Asset* findAsset(const char* path) {
+    const Asset& asset = asset_table[assetSlot(assetHash(path))];
+    return asset.path && strcmp(asset.path, path) == 0 ? &asset : nullptr;
+}
+
+const Asset* findAsset(const char* directory, const char* name, const char* extension) {
+    // Same as findAsset("<directory>/<name><extension>") without building the path
+    uint32_t hash = assetHash(extension, assetHash(name, assetHash("/", assetHash(directory))));
+    const Asset& asset = asset_table[assetSlot(hash)];
+    if (!asset.path) {
+        return nullptr;
+    }
+
+    const char* path = asset.path;
+    size_t length = strlen(directory);
+    if (strncmp(path, directory, length) != 0 || path[length] != '/') {
+        return nullptr;
+    }
+    path += length + 1;
+    length = strlen(name);
+    if (strncmp(path, name, length) != 0) {
+        return nullptr;
+    }
+    return strcmp(path + length, extension) == 0 ? &asset : nullptr;
+}
+
 const char* getTemplate(const char* name) {
-    if (strcmp(name, "modern") == 0) return template_modern;
-    if (strcmp(name, "classic") == 0) return template_classic;
-    if (strcmp(name, "minimal") == 0) return template_minimal;
-    return nullptr;
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->data : nullptr;
 }
 
 const char* getCSS(const char* name) {
-    if (strcmp(name, "classic") == 0) return css_classic;
-    if (strcmp(name, "minimal") == 0) return css_minimal;
-    if (strcmp(name, "modern") == 0) return css_modern;
-    return nullptr;
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->data : nullptr;
 }
 
 const char* getJS(const char* name) {
-    if (strcmp(name, "portal") == 0) return js_portal;
-    return nullptr;
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->data : nullptr;
 }
 
 // Size functions
 size_t getTemplateSize(const char* name) {
-    if (strcmp(name, "modern") == 0) return template_modern_len;
-    if (strcmp(name, "classic") == 0) return template_classic_len;
-    if (strcmp(name, "minimal") == 0) return template_minimal_len;
-    return 0;
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->length : 0;
 }
 
 size_t getCSSSize(const char* name) {
-    if (strcmp(name, "classic") == 0) return css_classic_len;
-    if (strcmp(name, "minimal") == 0) return css_minimal_len;
-    if (strcmp(name, "modern") == 0) return css_modern_len;
-    return 0;
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->length : 0;
 }
 
 size_t getJSSize(const char* name) {
-    if (strcmp(name, "portal") == 0) return js_portal_len;
-    return 0;
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->length : 0;
+}
+
+const TemplateSegment* getTemplateSegments(const char* name) {
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->segments : nullptr;
+}
+
+size_t getTemplateSegmentCount(const char* name) {
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->segmentCount : 0;
+}
+
+// Cacheable variants
+const uint8_t* getCSSGzip(const char* name) {
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->gzip : nullptr;
+}
+
+size_t getCSSGzipSize(const char* name) {
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->gzipLength : 0;
+}
+
+const char* getCSSETag(const char* name) {
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->etag : nullptr;
+}
+
+const uint8_t* getJSGzip(const char* name) {
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->gzip : nullptr;
+}
+
+size_t getJSGzipSize(const char* name) {
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->gzipLength : 0;
+}
+
+const char* getJSETag(const char* name) {
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->etag : nullptr;
+}
+
+// Pre-rendered pages (empty slots when FLEXIFI_DISABLE_PRERENDERED is set)
+const uint8_t* getPage(const char* name) {
+    const Asset* asset = findAsset("pages", name, ".html");
+    return asset ? asset->gzip : nullptr;
+}
+
+size_t getPageSize(const char* name) {
+    const Asset* asset = findAsset("pages", name, ".html");
+    return asset ? asset->gzipLength : 0;
 }
 
 } // namespace FlexifiAssets
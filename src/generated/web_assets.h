@@ -11,506 +11,614 @@
  */
 
 #include <Arduino.h>
+#include "web_asset_types.h"
 
 namespace FlexifiAssets {
 
-    // HTML Templates
+    // Placeholder names indexed by TemplateVariable
+    const char* const template_variable_names[VAR_COUNT] = { "", "TITLE", "NETWORKS", "STATUS", "CUSTOM_PARAMETERS", "VERSION", "DEVICE_NAME", "CSS", "CSS_URL", "JS", "JS_URL", "PARAMETERS", "SSID", "RSSI", "CHANNEL", "SECURE", "SIGNAL", "ID", "LABEL", "VALUE", "PARAMETER", "CSS_CLASSIC", "CSS_MINIMAL", "CSS_MODERN" };
 
-// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/modern.html (minified: 1338 bytes)
-const char template_modern[] PROGMEM = R"FLEXIFI(<!doctype html><html lang=en><meta charset=UTF-8><meta content="width=device-width,initial-scale=1.0" name=viewport><title>{{TITLE}}</title><style>{{CSS_MODERN}}</style><body><div class=container><div class=header><h1>{{TITLE}}</h1><p class=subtitle>Configure your WiFi connection</div><div class=status-panel><div id=status>{{STATUS}}</div></div><div class=wifi-panel><div class=networks-header><h2>Available Networks</h2><div class=button-group><button class="btn btn-secondary btn-compact" id=manualToggleBtn>Enter Manually</button><button class="btn btn-secondary btn-compact" id=scanBtn><span id=scanBtnText>Scan</span> <span class=spinner id=scanSpinner style=display:none>⟳</span></button><button class="btn btn-danger btn-compact" id=resetBtn>Reset Configuration</button></div></div><div class=networks id=networks>{{NETWORKS}}</div></div><div class=connect-panel><div class=manual-form id=manualConnectForm style=display:none><h3>Manual Connection</h3><form id=connectForm><div class=form-group><label for=ssid>Network Name (SSID):</label><input id=ssid name=ssid required></div><div class=form-group><label for=password>Password:</label><input id=password name=password type=password></div> {{CUSTOM_PARAMETERS}} <button class="btn btn-primary btn-compact">Connect</button></form></div></div></div><script>{{JS_PORTAL}}</script>)FLEXIFI";
-const size_t template_modern_len = sizeof(template_modern) - 1;
+    // HTML Templates
 
-// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/classic.html (minified: 740 bytes)
-const char template_classic[] PROGMEM = R"FLEXIFI(<!doctype html><title>{{TITLE}}</title><meta content="width=device-width,initial-scale=1" name=viewport><style>{{CSS_CLASSIC}}</style><body><div class=container><h1>{{TITLE}}</h1><div class=panel><h2>Status</h2><div id=status>{{STATUS}}</div></div><div class=panel><h2>WiFi Networks</h2><button onclick=scanNetworks()>Scan</button><div id=networks>{{NETWORKS}}</div></div><div class=panel><h2>Connect</h2><form onsubmit="connectToWiFi(); return false;"><p><label>SSID:</label><br> <input id=ssid required><p><label>Password:</label><br> <input id=password type=password></p> {{CUSTOM_PARAMETERS}} <p><button>Connect</button></form></div><div class=panel><button onclick=resetConfig()>Reset</button></div></div><script>{{JS_PORTAL}}</script>)FLEXIFI";
+// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/classic.html (minified: 764 bytes)
+const char template_classic[] PROGMEM = R"FLEXIFI(<!doctype html><title>{{TITLE}}</title><meta content="width=device-width,initial-scale=1" name=viewport><link href="{{CSS_URL}}" rel=stylesheet><body><div class=container><h1>{{TITLE}}</h1><div class=panel><h2>Status</h2><div id=status>{{STATUS}}</div></div><div class=panel><h2>WiFi Networks</h2><button onclick=scanNetworks()>Scan</button><div id=networks>{{NETWORKS}}</div></div><div class=panel><h2>Connect</h2><form onsubmit="connectToWiFi(); return false;"><p><label>SSID:</label><br> <input id=ssid required><p><label>Password:</label><br> <input id=password type=password></p> <div id=customParameters></div> <p><button>Connect</button></form></div><div class=panel><button onclick=resetConfig()>Reset</button></div></div><script src="{{JS_URL}}"></script>)FLEXIFI";
 const size_t template_classic_len = sizeof(template_classic) - 1;
-
-// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/minimal.html (minified: 526 bytes)
-const char template_minimal[] PROGMEM = R"FLEXIFI(<!doctype html><title>{{TITLE}}</title><meta content="width=device-width,initial-scale=1" name=viewport><style>{{CSS_MINIMAL}}</style><body><h1>{{TITLE}}</h1><div id=status>{{STATUS}}</div><button onclick=scanNetworks()>Scan</button><div id=networks>{{NETWORKS}}</div><form onsubmit="connectToWiFi(); return false;">SSID: <input id=ssid required><br> Password: <input id=password type=password><br> {{CUSTOM_PARAMETERS}} <button>Connect</button></form><button onclick=resetConfig()>Reset</button><script>{{JS_PORTAL}}</script>)FLEXIFI";
+const TemplateSegment template_classic_segments[] PROGMEM = {
+    { 0, 22, VAR_TITLE, OP_EMIT, 0 },
+    { 31, 85, VAR_CSS_URL, OP_EMIT, 0 },
+    { 127, 48, VAR_TITLE, OP_EMIT, 0 },
+    { 184, 52, VAR_STATUS, OP_EMIT, 0 },
+    { 246, 112, VAR_NETWORKS, OP_EMIT, 0 },
+    { 370, 373, VAR_JS_URL, OP_EMIT, 0 },
+    { 753, 11, VAR_NONE, OP_EMIT, 0 },
+};
+const size_t template_classic_segments_count = sizeof(template_classic_segments) / sizeof(template_classic_segments[0]);
+
+// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/minimal.html (minified: 550 bytes)
+const char template_minimal[] PROGMEM = R"FLEXIFI(<!doctype html><title>{{TITLE}}</title><meta content="width=device-width,initial-scale=1" name=viewport><link href="{{CSS_URL}}" rel=stylesheet><body><h1>{{TITLE}}</h1><div id=status>{{STATUS}}</div><button onclick=scanNetworks()>Scan</button><div id=networks>{{NETWORKS}}</div><form onsubmit="connectToWiFi(); return false;">SSID: <input id=ssid required><br> Password: <input id=password type=password><br> <div id=customParameters></div> <button>Connect</button></form><button onclick=resetConfig()>Reset</button><script src="{{JS_URL}}"></script>)FLEXIFI";
 const size_t template_minimal_len = sizeof(template_minimal) - 1;
+const TemplateSegment template_minimal_segments[] PROGMEM = {
+    { 0, 22, VAR_TITLE, OP_EMIT, 0 },
+    { 31, 85, VAR_CSS_URL, OP_EMIT, 0 },
+    { 127, 27, VAR_TITLE, OP_EMIT, 0 },
+    { 163, 20, VAR_STATUS, OP_EMIT, 0 },
+    { 193, 67, VAR_NETWORKS, OP_EMIT, 0 },
+    { 272, 257, VAR_JS_URL, OP_EMIT, 0 },
+    { 539, 11, VAR_NONE, OP_EMIT, 0 },
+};
+const size_t template_minimal_segments_count = sizeof(template_minimal_segments) / sizeof(template_minimal_segments[0]);
+
+// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/modern.html (minified: 1363 bytes)
+const char template_modern[] PROGMEM = R"FLEXIFI(<!doctype html><html lang=en><meta charset=UTF-8><meta content="width=device-width,initial-scale=1.0" name=viewport><title>{{TITLE}}</title><link href="{{CSS_URL}}" rel=stylesheet><body><div class=container><div class=header><h1>{{TITLE}}</h1><p class=subtitle>Configure your WiFi connection</div><div class=status-panel><div id=status>{{STATUS}}</div></div><div class=wifi-panel><div class=networks-header><h2>Available Networks</h2><div class=button-group><button class="btn btn-secondary btn-compact" id=manualToggleBtn>Enter Manually</button><button class="btn btn-secondary btn-compact" id=scanBtn><span id=scanBtnText>Scan</span> <span class=spinner id=scanSpinner style=display:none>⟳</span></button><button class="btn btn-danger btn-compact" id=resetBtn>Reset Configuration</button></div></div><div class=networks id=networks>{{NETWORKS}}</div></div><div class=connect-panel><div class=manual-form id=manualConnectForm style=display:none><h3>Manual Connection</h3><form id=connectForm><div class=form-group><label for=ssid>Network Name (SSID):</label><input id=ssid name=ssid required></div><div class=form-group><label for=password>Password:</label><input id=password name=password type=password></div> <div id=customParameters></div> <button class="btn btn-primary btn-compact">Connect</button></form></div></div></div><script src="{{JS_URL}}"></script>)FLEXIFI";
+const size_t template_modern_len = sizeof(template_modern) - 1;
+const TemplateSegment template_modern_segments[] PROGMEM = {
+    { 0, 123, VAR_TITLE, OP_EMIT, 0 },
+    { 132, 20, VAR_CSS_URL, OP_EMIT, 0 },
+    { 163, 66, VAR_TITLE, OP_EMIT, 0 },
+    { 238, 98, VAR_STATUS, OP_EMIT, 0 },
+    { 346, 490, VAR_NETWORKS, OP_EMIT, 0 },
+    { 848, 496, VAR_JS_URL, OP_EMIT, 0 },
+    { 1354, 11, VAR_NONE, OP_EMIT, 0 },
+};
+const size_t template_modern_segments_count = sizeof(template_modern_segments) / sizeof(template_modern_segments[0]);
 
     // CSS Stylesheets
 
 // Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/css/classic.css (minified: 794 bytes)
 const char css_classic[] PROGMEM = R"FLEXIFI(body{background:#f5f5f5;margin:0;padding:20px;font-family:Arial,sans-serif}.container{background:#fff;border-radius:5px;max-width:600px;margin:0 auto;padding:20px;box-shadow:0 2px 10px #0000001a}h1{color:#333;text-align:center}h2{color:#666;border-bottom:2px solid #eee;padding-bottom:10px}.panel{border:1px solid #ddd;border-radius:5px;margin-bottom:20px;padding:15px}button{color:#fff;cursor:pointer;background:#007cba;border:none;border-radius:3px;padding:10px 20px}button:hover{background:#005a8b}input,select,textarea{border:1px solid #ddd;border-radius:3px;margin:5px 0;padding:8px}#status{background:#f0f0f0;border-radius:3px;margin:10px 0;padding:10px}.network-item{cursor:pointer;border:1px solid #eee;border-radius:3px;margin:5px 0;padding:10px}.network-item:hover{background:#f9f9f9})FLEXIFI";
 const size_t css_classic_len = sizeof(css_classic) - 1;
+const char css_classic_etag[] = "5fd02b2b07f8bce0";
+const uint8_t css_classic_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x52, 0xdb, 0x8e, 0x82, 0x30,
+    0x10, 0xfd, 0x15, 0x12, 0x5e, 0xc5, 0x14, 0x89, 0xac, 0x5b, 0x9e, 0xf6, 0x53, 0xa6, 0x74, 0x80,
+    0x46, 0xe8, 0x90, 0xb6, 0xac, 0x18, 0xc2, 0xbf, 0x6f, 0xab, 0xb2, 0x8a, 0xba, 0xc9, 0x32, 0x2f,
+    0x94, 0x93, 0x9e, 0xdb, 0x20, 0x48, 0x9e, 0x27, 0x01, 0xe5, 0xb1, 0x36, 0x34, 0x68, 0xc9, 0xe3,
+    0x6a, 0x1f, 0xa6, 0xe8, 0xc0, 0xd4, 0x4a, 0x73, 0x56, 0xf4, 0x20, 0xa5, 0xd2, 0x35, 0xdf, 0xb1,
+    0x7e, 0x2c, 0x2a, 0xd2, 0x2e, 0xa9, 0xa0, 0x53, 0xed, 0x99, 0x7f, 0x19, 0x05, 0xed, 0xc6, 0x82,
+    0xb6, 0x89, 0x45, 0xa3, 0xaa, 0x79, 0x5b, 0x7a, 0x14, 0x94, 0x46, 0xb3, 0x26, 0xac, 0xaa, 0x42,
+    0x90, 0x91, 0x68, 0x12, 0x03, 0x52, 0x0d, 0x96, 0xef, 0x3d, 0x53, 0x07, 0x63, 0x72, 0x52, 0xd2,
+    0x35, 0x3c, 0x67, 0xec, 0x72, 0xbe, 0xea, 0x45, 0x30, 0x38, 0x5a, 0x8b, 0x0a, 0x1a, 0x13, 0xdb,
+    0x80, 0xa4, 0x93, 0x87, 0x77, 0xfd, 0x18, 0xa5, 0xfe, 0x6b, 0x14, 0xb3, 0xcb, 0x93, 0xc2, 0xdc,
+    0xa4, 0x53, 0x49, 0x2d, 0x19, 0x1e, 0x67, 0x59, 0x56, 0x38, 0x1c, 0x5d, 0x02, 0xad, 0xaa, 0x35,
+    0x2f, 0x51, 0x3b, 0x34, 0x73, 0xb3, 0x5b, 0xf0, 0x3c, 0xcf, 0x17, 0x2b, 0x82, 0x9c, 0xa3, 0x8e,
+    0x07, 0x3a, 0x4b, 0xad, 0x92, 0x51, 0x8c, 0x88, 0x8b, 0xee, 0x82, 0x06, 0xa1, 0x79, 0xdb, 0x83,
+    0xc6, 0x76, 0xba, 0xde, 0xe3, 0xe9, 0xfd, 0x82, 0x94, 0xf2, 0x6d, 0xb0, 0x10, 0xe4, 0x97, 0x3f,
+    0x04, 0x58, 0xd2, 0xa4, 0x1e, 0x9f, 0xc5, 0xe0, 0x01, 0xbd, 0x38, 0x0a, 0xe5, 0x94, 0x83, 0xb1,
+    0xfe, 0xbd, 0x27, 0x15, 0xec, 0x16, 0x8f, 0xdd, 0x31, 0xf6, 0x51, 0x0a, 0xb8, 0xa9, 0x70, 0x4d,
+    0x1a, 0x9f, 0x14, 0xb3, 0x47, 0xfa, 0x50, 0x4b, 0x10, 0xbc, 0x69, 0xf0, 0x86, 0xbe, 0x9f, 0x76,
+    0xc1, 0xd8, 0x1e, 0x0e, 0x62, 0x56, 0xba, 0x1f, 0xdc, 0xc6, 0x62, 0x8b, 0xa5, 0xdb, 0x84, 0xc2,
+    0xc0, 0x20, 0xfc, 0x2b, 0x61, 0x76, 0x5f, 0x95, 0x0f, 0x13, 0xdd, 0x7f, 0x8f, 0x83, 0x97, 0x8d,
+    0xad, 0x03, 0x37, 0xd8, 0xf5, 0xf6, 0x59, 0x98, 0xbf, 0x59, 0x2e, 0xa6, 0xd9, 0x2a, 0xc3, 0xbc,
+    0xd5, 0xe8, 0x4e, 0x64, 0x8e, 0x89, 0x72, 0xd8, 0x4d, 0xcf, 0xf5, 0xbc, 0xb8, 0x0c, 0x8b, 0xfb,
+    0xa7, 0xcb, 0x57, 0xfa, 0x37, 0x25, 0x55, 0x9f, 0x61, 0xe6, 0x1f, 0x91, 0x91, 0x46, 0x24, 0x1a,
+    0x03, 0x00, 0x00,
+};
+const size_t css_classic_gz_len = sizeof(css_classic_gz);
 
 // Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/css/minimal.css (minified: 292 bytes)
 const char css_minimal[] PROGMEM = R"FLEXIFI(body{margin:20px;font-family:Arial,sans-serif}button{margin:5px;padding:5px 10px}input,select,textarea{margin:2px;padding:5px}#status{background:#f0f0f0;margin:10px 0;padding:5px}.network-item{cursor:pointer;border:1px solid #ccc;margin:2px;padding:5px}.network-item:hover{background:#f5f5f5})FLEXIFI";
 const size_t css_minimal_len = sizeof(css_minimal) - 1;
+const char css_minimal_etag[] = "c8fbb9929ebaf817";
+const uint8_t css_minimal_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x8e, 0xcd, 0x0a, 0x83, 0x40,
+    0x0c, 0x84, 0x5f, 0x45, 0xf0, 0xaa, 0xc5, 0x16, 0xbc, 0xac, 0xa7, 0x3e, 0x4a, 0xdc, 0x8d, 0x36,
+    0xa8, 0x89, 0x64, 0xb3, 0xfd, 0x41, 0x7c, 0xf7, 0x2a, 0xb4, 0x05, 0x0f, 0x65, 0x2e, 0x73, 0x98,
+    0x6f, 0x66, 0x5a, 0x09, 0xaf, 0x65, 0x02, 0xed, 0x89, 0xdd, 0xa5, 0x9a, 0x9f, 0x4d, 0x27, 0x6c,
+    0x65, 0x07, 0x13, 0x8d, 0x2f, 0x77, 0x55, 0x82, 0xb1, 0x88, 0xc0, 0xb1, 0x8c, 0xa8, 0xd4, 0xad,
+    0x6d, 0x32, 0x13, 0xfe, 0xe6, 0xeb, 0x2d, 0x3e, 0x43, 0x08, 0xc4, 0xfd, 0xee, 0xb3, 0xf3, 0xc6,
+    0xaf, 0xc4, 0x73, 0xb2, 0x22, 0xe2, 0x88, 0xde, 0x0a, 0xc3, 0xa7, 0x81, 0x22, 0xfc, 0x16, 0x8e,
+    0xc4, 0x9a, 0x47, 0x03, 0x4b, 0x71, 0x69, 0xc1, 0x0f, 0xbd, 0x4a, 0xe2, 0xe0, 0xf2, 0xae, 0xda,
+    0xd5, 0x7c, 0x88, 0xbd, 0x33, 0xab, 0x0e, 0xd0, 0x89, 0xd1, 0x1e, 0xa2, 0x43, 0x49, 0x86, 0xd3,
+    0xe2, 0x93, 0x46, 0x51, 0x37, 0x0b, 0xb1, 0xa1, 0x36, 0xad, 0x68, 0x40, 0x75, 0xe7, 0x8d, 0x8a,
+    0x32, 0x52, 0xc8, 0x72, 0xef, 0x7d, 0xf3, 0x67, 0xfe, 0xd0, 0xe4, 0x6e, 0x72, 0x47, 0x3d, 0x5e,
+    0xa9, 0x77, 0xad, 0x6f, 0xc9, 0xd8, 0x06, 0x63, 0x24, 0x01, 0x00, 0x00,
+};
+const size_t css_minimal_gz_len = sizeof(css_minimal_gz);
 
 // Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/css/modern.css (minified: 4825 bytes)
 const char css_modern[] PROGMEM = R"FLEXIFI(*{box-sizing:border-box;margin:0;padding:0}body{background:linear-gradient(135deg,#667eea 0%,#764ba2 100%);min-height:100vh;padding:10px;font-family:-apple-system,BlinkMacSystemFont,Segoe UI,Roboto,sans-serif}.container{background:#fff;border-radius:12px;max-width:600px;margin:0 auto;overflow:hidden;box-shadow:0 10px 30px #0003}.header{color:#fff;background:#4a5568;justify-content:space-between;align-items:center;padding:15px;display:flex}.header h1{margin-bottom:0;font-size:1.5em}.subtitle{opacity:.9}.status-panel,.wifi-panel,.connect-panel,.actions{padding:12px}.status-panel{padding:8px 12px}.status{border-radius:8px;padding:15px;font-weight:500}.status.ready{color:#065f46;background:#e6fffa}.status.scanning{color:#92400e;background:#fef3c7}.status.connecting{color:#1e40af;background:#dbeafe}.status.connected{color:#166534;background:#dcfce7}.status.failed,.status.error{color:#dc2626;background:#fee2e2}.status.throttled{color:#92400e;background:#fef3c7}.btn{cursor:pointer;border:none;border-radius:6px;padding:12px 24px;font-size:14px;font-weight:500;transition:all .2s}.btn-primary{color:#fff;background:#3b82f6}.btn-primary:hover{background:#2563eb}.btn-secondary{color:#fff;background:#6b7280}.btn-secondary:hover{background:#4b5563}.btn-danger{color:#fff;background:#ef4444}.btn-danger:hover{background:#dc2626}.form-group{align-items:center;gap:12px;margin-bottom:10px;display:flex}.form-group label{flex-shrink:0;min-width:120px;margin-bottom:0;font-weight:500}.form-group input,.form-group select,.form-group textarea{border:2px solid #e5e7eb;border-radius:6px;flex:1;padding:10px;font-size:16px}.form-group input:focus,.form-group select:focus,.form-group textarea:focus{border-color:#3b82f6;outline:none}.network-list{margin-top:15px}.network-item{cursor:pointer;border:1px solid #e5e7eb;border-radius:6px;justify-content:space-between;align-items:center;margin-bottom:8px;padding:12px;display:flex}.network-item:hover{background:#f9fafb}.network-name{font-weight:500}.network-info{color:#6b7280}.actions{text-align:center}.required{color:#dc2626}.manual-connect-toggle{text-align:center;margin-bottom:10px}.manual-form{padding-top:0}.manual-form h3{color:#374151;margin-bottom:8px;font-size:1em}.spinner{animation:1s linear infinite spin;display:inline-block}@keyframes spin{0%{transform:rotate(0)}to{transform:rotate(360deg)}}.btn:disabled{opacity:.6;cursor:not-allowed}.network-item{padding:8px 12px}h2{margin-bottom:10px;font-size:1.2em}.networks-header{justify-content:space-between;align-items:center;margin-bottom:12px;display:flex}.networks-header h2{flex-grow:1;margin-bottom:0}.btn-compact{min-width:60px;padding:8px 16px;font-size:13px}.button-group{gap:8px;display:flex}.button-group .btn{margin:0}.signal-strength{vertical-align:middle;justify-content:flex-end;align-items:flex-end;width:auto;height:20px;margin:0;padding:2px;display:inline-flex}.signal-strength .bar{transform-origin:100% 100%;opacity:.3;background-color:#707070;border-radius:2px;width:4px;margin-left:2px;transition:all .3s cubic-bezier(.17,.67,.42,1.3);display:inline-block}.signal-strength .bar-1{height:20%}.signal-strength .bar-2{height:40%}.signal-strength .bar-3{height:60%}.signal-strength .bar-4{height:80%}.signal-strength .bar-5{height:100%}.signal-strength.strength-0 .bar{opacity:.2;background:#ef4444}.signal-strength.strength-1 .bar-1{opacity:1;background:#dc2626}.signal-strength.strength-1 .bar-2,.signal-strength.strength-1 .bar-3,.signal-strength.strength-1 .bar-4,.signal-strength.strength-1 .bar-5{opacity:.2;background:#707070}.signal-strength.strength-2 .bar-1,.signal-strength.strength-2 .bar-2{opacity:1;background:#ea580c}.signal-strength.strength-2 .bar-3,.signal-strength.strength-2 .bar-4,.signal-strength.strength-2 .bar-5{opacity:.2;background:#707070}.signal-strength.strength-3 .bar-1,.signal-strength.strength-3 .bar-2,.signal-strength.strength-3 .bar-3{opacity:1;background:#ca8a04}.signal-strength.strength-3 .bar-4,.signal-strength.strength-3 .bar-5{opacity:.2;background:#707070}.signal-strength.strength-4 .bar-1,.signal-strength.strength-4 .bar-2,.signal-strength.strength-4 .bar-3,.signal-strength.strength-4 .bar-4{opacity:1;background:#65a30d}.signal-strength.strength-4 .bar-5{opacity:.2;background:#707070}.signal-strength.strength-5 .bar-1,.signal-strength.strength-5 .bar-2,.signal-strength.strength-5 .bar-3,.signal-strength.strength-5 .bar-4,.signal-strength.strength-5 .bar-5{opacity:1;background:#16a34a}@keyframes signal-intro{0%{transform:scaleY(.3)}to{transform:scaleY(1)}}.signal-strength .bar{animation:.3s ease-out forwards signal-intro}.signal-strength .bar-1{animation-delay:50ms}.signal-strength .bar-2{animation-delay:.1s}.signal-strength .bar-3{animation-delay:.15s}.signal-strength .bar-4{animation-delay:.2s}.signal-strength .bar-5{animation-delay:.25s})FLEXIFI";
 const size_t css_modern_len = sizeof(css_modern) - 1;
+const char css_modern_etag[] = "112ea0dacb09209a";
+const uint8_t css_modern_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x57, 0x4b, 0x6f, 0xe3, 0x36,
+    0x10, 0xfe, 0x2b, 0x02, 0x82, 0x00, 0x49, 0x61, 0x09, 0xd4, 0xd3, 0x5e, 0xf9, 0x52, 0xf4, 0x50,
+    0xa0, 0x87, 0x5e, 0xba, 0xe8, 0xa1, 0x47, 0x4a, 0x1a, 0xd9, 0x6c, 0x64, 0x52, 0x25, 0xe9, 0x4d,
+    0xbc, 0x82, 0xff, 0x7b, 0x87, 0x92, 0x28, 0x4b, 0xb6, 0xb4, 0xda, 0x6e, 0x13, 0x24, 0x88, 0xc9,
+    0xe1, 0x3c, 0xbf, 0xf9, 0x66, 0xf2, 0x53, 0x93, 0x89, 0x0f, 0x57, 0xb1, 0xaf, 0x8c, 0x1f, 0xd2,
+    0x4c, 0xc8, 0x02, 0xa4, 0x8b, 0x27, 0xfb, 0x13, 0x95, 0x07, 0xc6, 0x53, 0xb2, 0xaf, 0x69, 0x51,
+    0x98, 0x3b, 0x72, 0xcd, 0x44, 0x71, 0x69, 0x32, 0x9a, 0xbf, 0x1d, 0xa4, 0x38, 0xf3, 0x22, 0xad,
+    0x18, 0x07, 0x2a, 0xdd, 0x83, 0xa4, 0x05, 0x03, 0xae, 0x5f, 0xfc, 0x30, 0x2e, 0xe0, 0xb0, 0x79,
+    0x4a, 0x92, 0x2d, 0x00, 0x75, 0xc8, 0xf3, 0xe6, 0x69, 0x9b, 0x44, 0x19, 0x0d, 0x1c, 0x9f, 0x90,
+    0xe7, 0xd7, 0xfd, 0x89, 0x71, 0xf7, 0x08, 0xec, 0x70, 0xd4, 0x29, 0x1e, 0x7c, 0x39, 0x0e, 0xaa,
+    0x7d, 0x52, 0x7f, 0xec, 0x4b, 0xc1, 0xb5, 0x5b, 0xd2, 0x13, 0xab, 0x2e, 0xa9, 0x4b, 0xeb, 0xba,
+    0x02, 0x57, 0x5d, 0x94, 0x86, 0xd3, 0xe6, 0x17, 0x34, 0xf4, 0xf6, 0x3b, 0xcd, 0x3f, 0xb7, 0x1f,
+    0x7f, 0x45, 0xb9, 0xcd, 0x67, 0x38, 0x08, 0x70, 0xfe, 0xfc, 0x6d, 0xf3, 0x87, 0xc8, 0x84, 0x16,
+    0x1b, 0x45, 0xb9, 0x72, 0x15, 0x48, 0x56, 0x5e, 0xbd, 0x1c, 0x05, 0x28, 0xba, 0x26, 0xc7, 0xbe,
+    0x3e, 0x95, 0x65, 0xb9, 0xef, 0xc3, 0x33, 0xfe, 0x9e, 0x55, 0xea, 0x07, 0xb5, 0x09, 0xf3, 0xc3,
+    0x7d, 0x67, 0x85, 0x3e, 0xa6, 0x09, 0x21, 0xf5, 0x2d, 0x6c, 0x87, 0x9e, 0xb5, 0xd8, 0x8b, 0x2f,
+    0x20, 0xcb, 0x4a, 0xbc, 0xa7, 0x47, 0x56, 0x14, 0xc0, 0xf7, 0x6d, 0xaa, 0x8e, 0xb4, 0xc0, 0x13,
+    0xe2, 0x18, 0xaf, 0x9d, 0xd0, 0xfc, 0x7a, 0x22, 0x84, 0x84, 0x57, 0xef, 0x08, 0x14, 0xd5, 0x37,
+    0xb9, 0xa8, 0x84, 0xec, 0x0d, 0x8e, 0x1c, 0x88, 0x68, 0x1c, 0x27, 0xbb, 0xfd, 0xdf, 0x67, 0xa5,
+    0x59, 0x79, 0x71, 0x8d, 0x97, 0x98, 0xb4, 0x54, 0xd5, 0x34, 0x07, 0x37, 0x03, 0xfd, 0x0e, 0x68,
+    0x80, 0x56, 0xec, 0xc0, 0x5d, 0x86, 0x61, 0xaa, 0x34, 0xc7, 0x6b, 0x90, 0xb7, 0x24, 0xc5, 0xe8,
+    0x5e, 0xc1, 0x54, 0x5d, 0xd1, 0x4b, 0x5a, 0x56, 0xf0, 0x61, 0x0d, 0x3a, 0x47, 0xbf, 0xe9, 0xdc,
+    0xc6, 0xc2, 0x69, 0x2d, 0x4e, 0x58, 0xb4, 0x36, 0x99, 0x58, 0x54, 0x48, 0x7d, 0x2f, 0x86, 0xd3,
+    0xd5, 0x53, 0xe7, 0x4c, 0x33, 0x5d, 0x41, 0x23, 0xd0, 0x1e, 0xd3, 0x97, 0xd4, 0xfb, 0x84, 0x87,
+    0x9a, 0xea, 0xb3, 0x72, 0x6b, 0xca, 0xa1, 0xda, 0x78, 0xef, 0xac, 0x64, 0xf6, 0x6f, 0xf4, 0x8e,
+    0x43, 0xae, 0xed, 0x47, 0x9a, 0x6b, 0x26, 0xb8, 0x6a, 0x06, 0x5f, 0x30, 0x75, 0xd3, 0xe7, 0xc3,
+    0xd5, 0x0e, 0xf3, 0x31, 0xbe, 0x6e, 0xa6, 0x49, 0xc7, 0xeb, 0x69, 0x44, 0xad, 0xa7, 0xef, 0x1d,
+    0x2a, 0x62, 0x42, 0xec, 0x33, 0x4f, 0x62, 0x6c, 0x17, 0x9b, 0x4b, 0x92, 0xc4, 0x65, 0x94, 0x4c,
+    0xd2, 0x09, 0x09, 0x26, 0x98, 0x0e, 0xe2, 0x2a, 0xa7, 0x9c, 0xa3, 0x52, 0xfb, 0xe2, 0x53, 0x10,
+    0x11, 0x02, 0x93, 0x17, 0x25, 0x94, 0x61, 0xbe, 0x1d, 0x5e, 0xf4, 0x21, 0x8e, 0xde, 0xf8, 0x10,
+    0x11, 0x3a, 0x2d, 0x5a, 0x91, 0x01, 0x2d, 0xe1, 0xfe, 0x0d, 0x14, 0xc3, 0x93, 0x24, 0x89, 0xc3,
+    0x68, 0xfa, 0x24, 0x2f, 0x73, 0xb8, 0x99, 0x29, 0x29, 0xab, 0xa0, 0xd8, 0xd8, 0x8f, 0x20, 0xa5,
+    0x18, 0x20, 0x52, 0xe4, 0x41, 0x12, 0x24, 0x77, 0x4e, 0x42, 0x00, 0xc1, 0xf0, 0x5a, 0x1f, 0x25,
+    0x96, 0xb4, 0xba, 0x19, 0xfc, 0x46, 0x5c, 0x99, 0xe6, 0x4d, 0x7e, 0x96, 0x0a, 0xc5, 0x6a, 0xc1,
+    0x5a, 0xec, 0x74, 0xb9, 0x4f, 0xb9, 0xe0, 0x70, 0x07, 0xfe, 0x64, 0x5c, 0x07, 0x2c, 0x97, 0x13,
+    0x44, 0xb6, 0x18, 0x1d, 0x6c, 0xa2, 0xc7, 0xda, 0xec, 0xb5, 0xc4, 0x36, 0x63, 0x06, 0x0a, 0x29,
+    0xad, 0x2a, 0xc7, 0x0b, 0x54, 0x6b, 0xd5, 0xad, 0x25, 0x43, 0x00, 0x5e, 0x96, 0x90, 0x1f, 0x66,
+    0xbb, 0xa0, 0x4c, 0x26, 0xa2, 0xe9, 0xd1, 0xb4, 0xd6, 0xa4, 0x41, 0x83, 0x38, 0x09, 0x21, 0xeb,
+    0xa4, 0x14, 0x60, 0xa6, 0x8b, 0x6f, 0xa8, 0x4c, 0xb2, 0x6d, 0xb0, 0x23, 0x77, 0xc2, 0x33, 0x4a,
+    0xa3, 0x0c, 0x9b, 0x2e, 0xec, 0xe4, 0x0a, 0xca, 0x0f, 0xcb, 0xed, 0x09, 0x65, 0x84, 0x5f, 0x63,
+    0xc9, 0x19, 0x75, 0x5d, 0xc1, 0xae, 0x5e, 0x29, 0xe4, 0xc9, 0x35, 0x87, 0x75, 0x33, 0xd3, 0xb1,
+    0x07, 0x5a, 0x5b, 0x72, 0x19, 0x77, 0x65, 0xcb, 0x72, 0xd3, 0x06, 0xbe, 0xe9, 0x71, 0x2a, 0x9a,
+    0x61, 0x17, 0x99, 0x63, 0x64, 0x18, 0x89, 0x84, 0x87, 0x5d, 0x6c, 0x08, 0xb3, 0x23, 0x27, 0x3f,
+    0x20, 0x0f, 0xfa, 0xc8, 0x63, 0xef, 0x8c, 0xf4, 0x31, 0x5e, 0x9f, 0xf5, 0x66, 0x7c, 0xa2, 0xa0,
+    0x42, 0xec, 0x4e, 0x8e, 0x34, 0x7c, 0x68, 0x8a, 0x9d, 0xd6, 0x37, 0x69, 0x6a, 0x80, 0xa0, 0x44,
+    0xc5, 0x0a, 0xe7, 0x09, 0x62, 0xd8, 0x42, 0x36, 0x83, 0x1a, 0xe3, 0x62, 0xea, 0xcf, 0x70, 0x77,
+    0x87, 0x9b, 0xa4, 0xfe, 0x78, 0xf4, 0x23, 0x2d, 0x45, 0x7e, 0x56, 0x33, 0xde, 0xcc, 0x5c, 0x58,
+    0x9f, 0xba, 0x2b, 0x4b, 0x1f, 0x7d, 0xd5, 0x3a, 0x28, 0xed, 0xc5, 0x59, 0x9b, 0xe1, 0xd3, 0x02,
+    0xfb, 0xea, 0x71, 0x24, 0x4f, 0x21, 0xdf, 0xdc, 0x8a, 0x29, 0x6d, 0x99, 0x50, 0x8b, 0xba, 0xe5,
+    0x97, 0xdb, 0xad, 0x29, 0xd1, 0x42, 0x7f, 0xf8, 0xdf, 0x11, 0xf6, 0x7f, 0xe6, 0xed, 0x69, 0xb1,
+    0x76, 0x77, 0xfd, 0x76, 0x07, 0x84, 0xb1, 0x93, 0x33, 0xb8, 0x2b, 0x3f, 0x95, 0xb4, 0xcc, 0x6e,
+    0x62, 0x9c, 0x9e, 0xa0, 0x79, 0xa8, 0xfe, 0xa0, 0x84, 0x97, 0xc2, 0xc2, 0xdc, 0x36, 0x8a, 0x65,
+    0x70, 0x93, 0x5d, 0xb7, 0xf5, 0xb6, 0xf7, 0xf3, 0x8a, 0x4c, 0xfb, 0xcf, 0x99, 0xc9, 0x1b, 0xc5,
+    0x58, 0x90, 0x9f, 0x28, 0x3f, 0xd3, 0xca, 0xb5, 0xa3, 0x40, 0x8b, 0xc3, 0x01, 0xe7, 0xc7, 0x83,
+    0x82, 0x19, 0x94, 0x0f, 0x6f, 0x4d, 0x59, 0xed, 0x64, 0x68, 0x4b, 0x42, 0x26, 0x57, 0xce, 0x31,
+    0xb4, 0x46, 0xc3, 0x6d, 0xe4, 0xc7, 0xfe, 0x4c, 0xd2, 0x46, 0xd0, 0x6a, 0xe7, 0x58, 0xcd, 0xb8,
+    0x19, 0xed, 0x94, 0x23, 0x8f, 0xb4, 0x4c, 0xe4, 0x2b, 0xa7, 0x5b, 0x44, 0x10, 0x6a, 0x25, 0xe3,
+    0x98, 0x41, 0xc7, 0x08, 0x0d, 0x09, 0x66, 0xdc, 0x5c, 0xbb, 0x59, 0x25, 0xf2, 0xb7, 0xeb, 0xcf,
+    0x6f, 0x70, 0x29, 0x25, 0x66, 0x4f, 0xb5, 0x42, 0x0d, 0x79, 0x6e, 0x5a, 0x52, 0x33, 0xde, 0xa4,
+    0x48, 0xb5, 0x54, 0xc3, 0x0b, 0x79, 0xbd, 0x6a, 0xf1, 0x78, 0x1c, 0x26, 0x04, 0xb7, 0x9b, 0xd7,
+    0x6b, 0x4b, 0x11, 0x29, 0x6a, 0xa7, 0x99, 0xe1, 0xe5, 0x61, 0x9e, 0x26, 0xfb, 0x1e, 0x5c, 0x5c,
+    0x98, 0x04, 0xe1, 0xd6, 0x00, 0xc5, 0x1d, 0xfa, 0x1e, 0x66, 0xe4, 0x31, 0x68, 0x66, 0x38, 0x62,
+    0x3c, 0xbc, 0x03, 0x13, 0x74, 0xaf, 0x44, 0xb9, 0xfd, 0x86, 0xf1, 0x3f, 0xb1, 0xb8, 0x8c, 0x3f,
+    0x6b, 0xc1, 0x41, 0xc7, 0x5a, 0x2a, 0x42, 0x00, 0xbe, 0xa7, 0xf7, 0x65, 0xe9, 0x79, 0x37, 0x17,
+    0x27, 0xb4, 0x8b, 0x1d, 0x37, 0xb0, 0x54, 0x42, 0x46, 0x28, 0x6f, 0x83, 0x4c, 0xa6, 0xe1, 0x84,
+    0x06, 0x1b, 0xd9, 0x19, 0xb5, 0xf0, 0x9e, 0x3e, 0x0d, 0x57, 0xee, 0x1e, 0xdc, 0x19, 0x8b, 0x38,
+    0xed, 0x60, 0xb3, 0x7b, 0x19, 0x22, 0x00, 0xa3, 0x43, 0xfc, 0x28, 0x2d, 0x81, 0x1f, 0xf4, 0xb1,
+    0xc1, 0x5e, 0xd1, 0x2c, 0xc7, 0x93, 0x0e, 0x94, 0x27, 0xdc, 0xd4, 0x2a, 0x78, 0x68, 0xd7, 0x36,
+    0x1a, 0xe0, 0xc5, 0x24, 0x3b, 0xc3, 0x61, 0xe7, 0x7e, 0xbb, 0xf2, 0xf5, 0x0b, 0x6a, 0x30, 0x5e,
+    0x06, 0x87, 0x98, 0xc6, 0x89, 0xeb, 0x71, 0xd5, 0x39, 0x7c, 0xe7, 0x14, 0xfa, 0x4c, 0xe5, 0x0d,
+    0x42, 0xae, 0x90, 0xcc, 0x28, 0x32, 0x6b, 0x70, 0xbb, 0x0b, 0xef, 0x07, 0xd4, 0x84, 0xa3, 0x21,
+    0x64, 0x49, 0x6e, 0x4b, 0xcc, 0xf7, 0x1d, 0x07, 0x19, 0xd3, 0x9d, 0x9b, 0xd1, 0x6d, 0x12, 0x54,
+    0x50, 0xea, 0xf6, 0xe6, 0x7e, 0x32, 0x87, 0xca, 0xc9, 0xcf, 0x19, 0xcb, 0x11, 0x14, 0x5f, 0x19,
+    0xc8, 0x17, 0xcf, 0xdf, 0x6e, 0xbc, 0x04, 0x7f, 0xa2, 0x60, 0xe3, 0x7b, 0xe1, 0xeb, 0x7c, 0x77,
+    0xcc, 0x86, 0xe1, 0xfa, 0xcd, 0x90, 0x93, 0xe7, 0x05, 0x91, 0xc0, 0x8a, 0x44, 0x8b, 0x22, 0xa1,
+    0x15, 0x49, 0x16, 0x45, 0x22, 0x2b, 0xb2, 0x5b, 0x14, 0x89, 0x9b, 0xdb, 0x3f, 0x10, 0x8f, 0x32,
+    0x9e, 0xfd, 0xc3, 0x25, 0x5d, 0x05, 0x86, 0x34, 0x07, 0xb3, 0xb3, 0x7e, 0xf1, 0xb9, 0x6f, 0x23,
+    0xb7, 0x0a, 0xfc, 0xfd, 0xdc, 0x1a, 0xb0, 0xf6, 0x3e, 0xd8, 0xac, 0x8a, 0x84, 0xeb, 0x22, 0xd1,
+    0xba, 0x48, 0xbc, 0x14, 0x69, 0x07, 0xa5, 0x6f, 0x78, 0x1a, 0xf4, 0x91, 0x6e, 0x56, 0x45, 0x82,
+    0x85, 0x64, 0x00, 0x8d, 0x77, 0x24, 0x5f, 0x37, 0x11, 0xae, 0x9b, 0x88, 0xd6, 0x45, 0x7e, 0x3c,
+    0xd2, 0x70, 0x3d, 0xd2, 0x70, 0xbd, 0x6c, 0xa1, 0x45, 0xf3, 0x7c, 0x32, 0x72, 0xba, 0xa3, 0x24,
+    0x5a, 0xf7, 0x22, 0x5a, 0x37, 0xf1, 0xe3, 0x91, 0x46, 0xeb, 0x91, 0x46, 0xeb, 0x91, 0x46, 0xeb,
+    0x65, 0x8b, 0x6c, 0xdf, 0xce, 0x27, 0x23, 0x89, 0x69, 0x48, 0x8a, 0x75, 0x47, 0x7f, 0x3c, 0xd2,
+    0x78, 0x3d, 0xd2, 0x78, 0x3d, 0xd2, 0x78, 0x3d, 0xd2, 0x78, 0xbd, 0x6c, 0xf1, 0x7d, 0x30, 0xd3,
+    0x64, 0xf8, 0x09, 0x0d, 0x23, 0x3a, 0x59, 0x40, 0x3a, 0x4d, 0xb8, 0x89, 0x4a, 0x31, 0x5d, 0x44,
+    0xf0, 0x9f, 0xd9, 0x0a, 0xfe, 0x7a, 0x41, 0x9e, 0x9e, 0x6e, 0x22, 0xfd, 0xb9, 0x6f, 0x96, 0x90,
+    0xd9, 0x89, 0x73, 0xdb, 0x8a, 0xcc, 0x04, 0x00, 0xaa, 0xc0, 0xc5, 0x55, 0xd9, 0xc1, 0xc7, 0xef,
+    0x54, 0x16, 0x53, 0x93, 0x8b, 0x6c, 0x3f, 0x28, 0x71, 0x0b, 0x30, 0x23, 0x22, 0x26, 0x27, 0xb5,
+    0xc8, 0xfb, 0xf7, 0xc2, 0x9e, 0xaf, 0x16, 0x07, 0xc0, 0xa3, 0x6c, 0xac, 0x16, 0x47, 0xc1, 0x83,
+    0x70, 0xa0, 0x16, 0x67, 0xc2, 0xa3, 0x2c, 0x2a, 0xfe, 0x17, 0x15, 0xf1, 0x99, 0x83, 0xd9, 0x12,
+    0x00, 0x00,
+};
+const size_t css_modern_gz_len = sizeof(css_modern_gz);
 
     // JavaScript Files
 
-// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/js/portal.js (minified: 17578 bytes)
-const char js_portal[] PROGMEM = R"FLEXIFI(let ws = null;
-let scanInProgress = false;
-
-function initWebSocket() {
-    if ('WebSocket' in window) {
-        console.log('Initializing WebSocket connection...');
-        ws = new WebSocket('ws://' + window.location.host + '/ws');
-        ws.onopen = function() { 
-            console.log('✅ WebSocket connected successfully'); 
-        };
-        ws.onmessage = function(event) { 
-            console.log('📨 WebSocket message received:', event.data);
-            handleWebSocketMessage(event.data); 
-        };
-        ws.onclose = function() { 
-            console.log('❌ WebSocket disconnected, reconnecting...'); 
-            setTimeout(initWebSocket, 5000); 
-        };
-        ws.onerror = function(error) { 
-            console.log('⚠️ WebSocket error:', error); 
-        };
-    } else {
-        console.log('⚠️ WebSocket not supported by browser');
-    }
-}
-
-function handleWebSocketMessage(data) {
-    try {
-        const msg = JSON.parse(data);
-        console.log('📥 WebSocket message received:', msg);
-        
-        if (msg.type === 'scan_complete') {
-            if (msg.data.refresh_networks) {
-                // New approach: refresh networks from API instead of receiving via WebSocket
-                console.log('🔄 Received refresh signal, fetching networks from API...');
-                loadNetworksFromAPI();
-            } else if (msg.data.networks) {
-                // Legacy fallback for direct network data
-                updateNetworks(msg.data.networks);
-            }
-            scanInProgress = false;
-            updateScanButton(false); // Re-enable scan button
-        } else if (msg.type === 'status_update') {
-            updateStatus(msg.data.status, msg.data.message);
-        } else if (msg.hasOwnProperty('success')) {
-            // Handle scan response (success/failure/throttled)
-            console.log('📋 WebSocket scan response:', msg);
-            
-            if (msg.success) {
-                console.log('✅ Scan initiated via WebSocket');
-                // Keep scanning state - wait for scan_complete
-            } else {
-                // Scan failed or throttled
-                console.log('⚠️ Scan failed via WebSocket:', msg.message);
-                scanInProgress = false;
-                updateScanButton(false); // Re-enable button
-                
-                if (msg.message && msg.message.includes('throttle')) {
-                    updateStatus('throttled', msg.message);
-                } else {
-                    updateStatus('error', msg.message || 'Scan failed');
-                }
-                // Don't clear networks on scan failure - preserve existing results
-            }
-        }
-    } catch (e) {
-        console.error('Error parsing WebSocket message:', e);
-    }
-}
-
-function scanNetworks() {
-    if (scanInProgress) {
-        console.log('⚠️ Scan already in progress, ignoring request');
-        return;
-    }
-    
-    console.log('🔍 Starting network scan...');
-    scanInProgress = true;
-    updateScanButton(true); // Disable and show spinner
-    updateStatus('scanning', 'Scanning for networks...');
-    
-    // Clear network list immediately when scan starts and ensure it's visible
-    const networksList = document.getElementById('networks');
-    const manualForm = document.getElementById('manualConnectForm');
-    const toggleBtn = document.getElementById('manualToggleBtn');
-    
-    networksList.style.display = 'block';
-    manualForm.style.display = 'none';
-    toggleBtn.textContent = 'Enter Manually';
-    updateNetworks([], true); // Pass isScanning=true to show scanning message
-    
-    if (ws && ws.readyState === WebSocket.OPEN) {
-        console.log('📤 Sending scan request via WebSocket');
-        ws.send(JSON.stringify({action: 'scan'}));
-    } else {
-        console.log('📤 WebSocket not available, using HTTP fetch');
-        fetch('/scan')
-            .then(response => {
-                console.log('📡 Scan response status:', response.status);
-                return response.json();
-            })
-            .then(data => {
-                console.log('📋 Scan data received:', data);
-                scanInProgress = false;
-                updateScanButton(false); // Re-enable button
-                
-                if (data.success && data.data) {
-                    console.log('✅ Scan successful, updating networks with:', data.data);
-                    updateNetworks(data.data);
-                } else if (data.message && data.message.includes('throttle')) {
-                    // Handle throttled response
-                    console.log('⏳ Scan throttled:', data.message);
-                    updateStatus('throttled', data.message);
-                    // Don't clear networks when throttled - preserve existing results
-                } else {
-                    console.log('⚠️ Scan response missing data or failed');
-                    updateStatus('error', data.message || 'Scan failed');
-                    // Don't clear networks on error - preserve existing results
-                }
-            })
-            .catch(error => {
-                console.error('❌ Scan error:', error);
-                scanInProgress = false;
-                updateScanButton(false); // Re-enable button
-                updateStatus('error', 'Scan failed. Please try again.');
-                // Don't clear networks on error - preserve existing results
-            });
-    }
-}
-
-function updateScanButton(scanning) {
-    const scanBtn = document.getElementById('scanBtn');
-    const scanBtnText = document.getElementById('scanBtnText');
-    const scanSpinner = document.getElementById('scanSpinner');
-    
-    if (scanning) {
-        scanBtn.disabled = true;
-        scanBtnText.style.display = 'none';
-        scanSpinner.style.display = 'inline-block';
-    } else {
-        scanBtn.disabled = false;
-        scanBtnText.style.display = 'inline-block';
-        scanSpinner.style.display = 'none';
-    }
-}
-
-function selectNetwork(ssid) {
-    document.getElementById('ssid').value = ssid;
-    showManualForm(); // Automatically show the form when a network is selected
-}
-
-function showManualForm() {
-    const manualForm = document.getElementById('manualConnectForm');
-    const toggleBtn = document.getElementById('manualToggleBtn');
-    const networksList = document.getElementById('networks');
-    
-    if (manualForm.style.display === 'none') {
-        manualForm.style.display = 'block';
-        toggleBtn.textContent = 'Hide Manual Entry';
-        // Hide network list when manual entry is shown
-        networksList.style.display = 'none';
-    } else {
-        manualForm.style.display = 'none';
-        toggleBtn.textContent = 'Enter Manually';
-        // Show network list when manual entry is hidden
-        networksList.style.display = 'block';
-    }
-}
-
-function connectToWiFi() {
-    const ssid = document.getElementById('ssid').value;
-    const password = document.getElementById('password').value;
-    
-    if (!ssid) {
-        alert('Please enter a network name');
-        return;
-    }
-    
-    updateStatus('connecting', 'Connecting to ' + ssid + '...');
-    
-    const data = new FormData();
-    data.append('ssid', ssid);
-    data.append('password', password);
-    
-    // Add custom parameters to form data
-    const form = document.getElementById('connectForm');
-    if (form) {
-        const formData = new FormData(form);
-        for (let [key, value] of formData.entries()) {
-            if (key !== 'ssid' && key !== 'password') {
-                data.append(key, value);
-            }
-        }
-    }
-    
-    fetch('/connect', {
-        method: 'POST',
-        body: data
-    })
-    .then(response => response.json())
-    .then(data => {
-        if (data.success) {
-            updateStatus('connected', 'Connected successfully!');
-            setTimeout(() => {
-                window.location.href = '/';
-            }, 3000);
-        } else {
-            updateStatus('failed', 'Connection failed: ' + data.message);
-        }
-    })
-    .catch(error => {
-        console.error('Connection error:', error);
-        updateStatus('failed', 'Connection failed');
-    });
-}
-
-function resetConfig() {
-    if (confirm('Are you sure you want to reset the configuration?')) {
-        fetch('/reset', {method: 'POST'})
-            .then(() => {
-                updateStatus('ready', 'Configuration reset');
-                document.getElementById('ssid').value = '';
-                document.getElementById('password').value = '';
-                
-                // Reset custom parameters
-                const form = document.getElementById('connectForm');
-                if (form) {
-                    form.reset();
-                }
-            })
-            .catch(error => console.error('Reset error:', error));
-    }
-}
-
-function updateStatus(status, message) {
-    const statusEl = document.getElementById('status');
-    statusEl.className = 'status ' + status;
-    statusEl.textContent = message || getStatusMessage(status);
-}
-
-function getStatusMessage(status) {
-    switch(status) {
-        case 'scanning': return '🔄 Scanning for networks...';
-        case 'connecting': return '⏳ Connecting to network...';
-        case 'connected': return '✅ Connected successfully!';
-        case 'failed': return '❌ Connection failed';
-        case 'error': return '❌ Error occurred';
-        case 'throttled': return '⏳ Scan throttled - please wait';
-        default: return '🔧 Ready to configure';
-    }
-}
-
-function createSignalStrengthIndicator(rssi) {
-    // Convert RSSI to signal strength (0-5 bars) with granular WiFi ranges
-    // 5-bar system provides more detailed signal quality representation
-    let strength = 0;
-    if (rssi >= -30) strength = 5;      // Exceptional: 5 bars, green (-30 and above)
-    else if (rssi >= -50) strength = 4; // Excellent: 4 bars, yellow-green (-50 to -30)
-    else if (rssi >= -60) strength = 3; // Good: 3 bars, yellow-orange (-60 to -50)  
-    else if (rssi >= -70) strength = 2; // Fair: 2 bars, red-orange (-70 to -60)
-    else if (rssi >= -80) strength = 1; // Poor: 1 bar, red (-80 to -70)
-    else strength = 0;                  // Very poor: dim bars (below -80)
-    
-    const colorMap = {
-        5: 'GREEN',
-        4: 'YELLOW-GREEN', 
-        3: 'YELLOW-ORANGE',
-        2: 'RED-ORANGE',
-        1: 'RED',
-        0: 'DIM RED'
-    };
-    
-    console.log('📶 RSSI:', rssi, '→ Strength:', strength, '→ Expected color:', colorMap[strength]);
-    
-    return '<div class="signal-strength strength-' + strength + '">' +
-           '<span class="bar bar-1"></span>' +
-           '<span class="bar bar-2"></span>' +
-           '<span class="bar bar-3"></span>' +
-           '<span class="bar bar-4"></span>' +
-           '<span class="bar bar-5"></span>' +
-           '</div>';
-}
-
-function updateNetworks(networks, isScanning = false) {
-    console.log('🔄 Updating networks UI with data:', networks, 'isScanning:', isScanning);
-    const networksEl = document.getElementById('networks');
-    
-    if (isScanning) {
-        // While scanning, show a scanning message instead of "No networks found"
-        networksEl.innerHTML = '<p style="color: #92400e;">🔄 Scanning...</p>';
-        return;
-    }
-    
-    if (!networks || networks.length === 0) {
-        console.log('⚠️ No networks to display');
-        networksEl.innerHTML = '<p>No networks found</p>';
-        // Update status when no networks found (only if not currently scanning and no important status is showing)
-        if (!scanInProgress) {
-            const statusEl = document.getElementById('status');
-            const currentStatus = statusEl.className;
-            // Don't override error, throttled, or connecting statuses
-            if (!currentStatus.includes('error') && !currentStatus.includes('throttled') && !currentStatus.includes('connecting')) {
-                updateStatus('ready', 'No networks found. Try scanning again.');
-            }
-        }
-        return;
-    }
-    
-    // Update status when networks are found (always override any previous status)
-    updateStatus('ready', 'Select a network or enter manually');
-    
-    console.log('✅ Building HTML for', networks.length, 'networks');
-    let html = '<div class="network-list">';
-    networks.forEach(network => {
-        const securityIcon = network.secure ? '🔒' : '🔓';
-        // Use CSS signal strength indicator instead of emoji
-        const signalStrength = createSignalStrengthIndicator(network.rssi || network.signal_strength || -70);
-        
-        html += '<div class="network-item" onclick="selectNetwork(\'' + 
-                network.ssid.replace(/'/g, "\\'") + '\')">';
-        html += '<span class="network-name">' + network.ssid + '</span>';
-        html += '<span class="network-info">' + securityIcon + ' ' + signalStrength + '</span>';
-        html += '</div>';
-    });
-    html += '</div>';
-    networksEl.innerHTML = html;
-    console.log('✅ Networks UI updated successfully');
-}
-
-function selectNetwork(ssid) {
-    console.log('🔗 Network selected:', ssid);
-    
-    // Fill in the SSID field
-    const ssidInput = document.getElementById('ssid');
-    if (ssidInput) {
-        ssidInput.value = ssid;
-    }
-    
-    // Show the manual connection form
-    const manualForm = document.getElementById('manualConnectForm');
-    const toggleBtn = document.getElementById('manualToggleBtn');
-    const networksList = document.getElementById('networks');
-    
-    if (manualForm && manualForm.style.display === 'none') {
-        manualForm.style.display = 'block';
-        if (toggleBtn) toggleBtn.textContent = 'Hide Manual Entry';
-        if (networksList) networksList.style.display = 'none';
-    }
-    
-    // Focus the password input after a brief delay to ensure the form is visible
-    setTimeout(() => {
-        const passwordInput = document.getElementById('password');
-        if (passwordInput) {
-            passwordInput.focus();
-            console.log('🎯 Password field focused');
-        }
-    }, 100);
-    
-    // Update status
-    updateStatus('ready', 'Enter password for ' + ssid);
-}
-
-// Initialize
-document.addEventListener('DOMContentLoaded', function() {
-    initWebSocket();
-    
-    // Set up form submission
-    const form = document.getElementById('connectForm');
-    if (form) {
-        form.addEventListener('submit', function(e) {
-            e.preventDefault();
-            connectToWiFi();
-        });
-    }
-    
-    // Set up scan button
-    const scanBtn = document.getElementById('scanBtn');
-    if (scanBtn) {
-        scanBtn.addEventListener('click', scanNetworks);
-    }
-    
-    // Set up manual toggle button
-    const manualToggleBtn = document.getElementById('manualToggleBtn');
-    if (manualToggleBtn) {
-        manualToggleBtn.addEventListener('click', showManualForm);
-    }
-    
-    // Set up reset button
-    const resetBtn = document.getElementById('resetBtn');
-    if (resetBtn) {
-        resetBtn.addEventListener('click', resetConfig);
-    }
-    
-    // Load initial networks from server-side scan (if available)
-    loadInitialNetworks();
-    
-    // If no networks are shown, do a scan
-    setTimeout(function() {
-        const networksEl = document.getElementById('networks');
-        if (!networksEl.innerHTML || networksEl.innerHTML.trim() === '' || 
-            networksEl.innerHTML.includes('Scanning for networks')) {
-            scanNetworks();
-        }
-    }, 500);
-});
-
-function loadNetworksFromAPI() {
-    console.log('🔄 Loading networks from API...');
-    
-    fetch('/networks.json')
-        .then(response => {
-            console.log('📡 networks.json response status:', response.status);
-            return response.json();
-        })
-        .then(data => {
-            console.log('📋 networks.json data received:', data);
-            
-            if (data.networks && data.networks.length > 0) {
-                console.log('✅ Found', data.networks.length, 'networks, updating UI...');
-                updateNetworks(data.networks);
-                if (!scanInProgress) {
-                    updateStatus('ready', 'Select a network or enter manually');
-                }
-            } else {
-                console.log('ℹ️ No networks found');
-                updateNetworks([]);
-                if (!scanInProgress) {
-                    updateStatus('ready', 'No networks found. Try scanning again.');
-                }
-            }
-        })
-        .catch(error => {
-            console.log('❌ Error loading networks from API:', error);
-            if (!scanInProgress) {
-                updateStatus('ready', 'Click "Scan Networks" to find WiFi networks');
-            }
-        });
-}
-
-function loadInitialNetworks() {
-    console.log('🔄 Loading initial networks and status...');
-    
-    // First check status to see if scan is in progress
-    fetch('/status')
-        .then(response => response.json())
-        .then(statusData => {
-            console.log('📊 Status data received:', statusData);
-            
-            if (statusData.scan_in_progress) {
-                console.log('🔄 Scan is in progress, showing scan state...');
-                scanInProgress = true;
-                updateScanButton(true);
-                updateStatus('scanning', 'Scanning for networks...');
-            }
-            
-            // Load networks from API
-            loadNetworksFromAPI();
-        })
-        .catch(error => {
-            console.log('❌ Error loading initial data:', error);
-            if (!scanInProgress) {
-                updateStatus('ready', 'Click "Scan Networks" to find WiFi networks');
-            }
-        });
-})FLEXIFI";
+// Generated from: /Users/andy/GitHub/andyshinn/flexifi/src/web/js/portal.js (minified: 12006 bytes)
+const char js_portal[] PROGMEM = R"FLEXIFI(let ws=null;let scanInProgress=false;function initWebSocket(){if('WebSocket'in window){ws=new WebSocket('ws://'+window.location.host+'/ws');ws.onopen=function(){};ws.onmessage=function(event){handleWebSocketMessage(event.data);};ws.onclose=function(){setTimeout(initWebSocket,5000);};ws.onerror=function(error){};}else{}}
+function handleWebSocketMessage(data){try{const msg=JSON.parse(data);if(msg.type==='scan_complete'){if(msg.data.refresh_networks){loadNetworksFromAPI();}else if(msg.data.networks){updateNetworks(msg.data.networks);}
+scanInProgress=false;updateScanButton(false);}else if(msg.type==='status_update'){updateStatus(msg.data.status,msg.data.message);}else if(msg.hasOwnProperty('success')){if(msg.success){}else{scanInProgress=false;updateScanButton(false);if(msg.message&&msg.message.includes('throttle')){updateStatus('throttled',msg.message);}else{updateStatus('error',msg.message||'Scan failed');}}}}catch(e){console.error('Error parsing WebSocket message:',e);}}
+function scanNetworks(){if(scanInProgress){return;}
+scanInProgress=true;updateScanButton(true);updateStatus('scanning','Scanning for networks...');const networksList=document.getElementById('networks');const manualForm=document.getElementById('manualConnectForm');const toggleBtn=document.getElementById('manualToggleBtn');networksList.style.display='block';manualForm.style.display='none';toggleBtn.textContent='Enter Manually';updateNetworks([],true);if(ws&&ws.readyState===WebSocket.OPEN){ws.send(JSON.stringify({action:'scan'}));}else{fetch('/scan').then(response=>{return response.json();}).then(data=>{scanInProgress=false;updateScanButton(false);if(data.success&&data.data){updateNetworks(data.data);}else if(data.message&&data.message.includes('throttle')){updateStatus('throttled',data.message);}else{updateStatus('error',data.message||'Scan failed');}}).catch(error=>{console.error('❌ Scan error:',error);scanInProgress=false;updateScanButton(false);updateStatus('error','Scan failed. Please try again.');});}}
+function updateScanButton(scanning){const scanBtn=document.getElementById('scanBtn');const scanBtnText=document.getElementById('scanBtnText');const scanSpinner=document.getElementById('scanSpinner');if(scanning){scanBtn.disabled=true;scanBtnText.style.display='none';scanSpinner.style.display='inline-block';}else{scanBtn.disabled=false;scanBtnText.style.display='inline-block';scanSpinner.style.display='none';}}
+function selectNetwork(ssid){document.getElementById('ssid').value=ssid;showManualForm();}
+function showManualForm(){const manualForm=document.getElementById('manualConnectForm');const toggleBtn=document.getElementById('manualToggleBtn');const networksList=document.getElementById('networks');if(manualForm.style.display==='none'){manualForm.style.display='block';toggleBtn.textContent='Hide Manual Entry';networksList.style.display='none';}else{manualForm.style.display='none';toggleBtn.textContent='Enter Manually';networksList.style.display='block';}}
+function connectToWiFi(){const ssid=document.getElementById('ssid').value;const password=document.getElementById('password').value;if(!ssid){alert('Please enter a network name');return;}
+updateStatus('connecting','Connecting to '+ssid+'...');const data=new FormData();data.append('ssid',ssid);data.append('password',password);const form=document.getElementById('connectForm');if(form){const formData=new FormData(form);for(let[key,value]of formData.entries()){if(key!=='ssid'&&key!=='password'){data.append(key,value);}}}
+fetch('/connect',{method:'POST',body:data}).then(response=>response.json()).then(data=>{if(data.success){updateStatus('connected','Connected successfully!');setTimeout(()=>{window.location.href='/';},3000);}else if(data.errors){showParameterErrors(data.errors);updateStatus('failed',data.message);}else{updateStatus('failed','Connection failed: '+data.message);}}).catch(error=>{console.error('Connection error:',error);updateStatus('failed','Connection failed');});}
+function resetConfig(){if(confirm('Are you sure you want to reset the configuration?')){fetch('/reset',{method:'POST'}).then(()=>{updateStatus('ready','Configuration reset');document.getElementById('ssid').value='';document.getElementById('password').value='';const form=document.getElementById('connectForm');if(form){form.reset();}}).catch(error=>console.error('Reset error:',error));}}
+function updateStatus(status,message){const statusEl=document.getElementById('status');statusEl.className='status '+status;statusEl.textContent=message||getStatusMessage(status);}
+function getStatusMessage(status){switch(status){case'scanning':return'🔄 Scanning for networks...';case'connecting':return'⏳ Connecting to network...';case'connected':return'✅ Connected successfully!';case'failed':return'❌ Connection failed';case'error':return'❌ Error occurred';case'throttled':return'⏳ Scan throttled - please wait';default:return'🔧 Ready to configure';}}
+function createSignalStrengthIndicator(rssi){let strength=0;if(rssi>=-30)strength=5;else if(rssi>=-50)strength=4;else if(rssi>=-60)strength=3;else if(rssi>=-70)strength=2;else if(rssi>=-80)strength=1;else strength=0;const colorMap={5:'GREEN',4:'YELLOW-GREEN',3:'YELLOW-ORANGE',2:'RED-ORANGE',1:'RED',0:'DIM RED'};return'<div class="signal-strength strength-'+strength+'">'+
+'<span class="bar bar-1"></span>'+
+'<span class="bar bar-2"></span>'+
+'<span class="bar bar-3"></span>'+
+'<span class="bar bar-4"></span>'+
+'<span class="bar bar-5"></span>'+
+'</div>';}
+function updateNetworks(networks,isScanning=false){const networksEl=document.getElementById('networks');if(isScanning){networksEl.innerHTML='<p style="color: #92400e;">🔄 Scanning...</p>';return;}
+if(!networks||networks.length===0){networksEl.innerHTML='<p>No networks found</p>';if(!scanInProgress){const statusEl=document.getElementById('status');const currentStatus=statusEl.className;if(!currentStatus.includes('error')&&!currentStatus.includes('throttled')&&!currentStatus.includes('connecting')){updateStatus('ready','No networks found. Try scanning again.');}}
+return;}
+updateStatus('ready','Select a network or enter manually');let html='<div class="network-list">';networks.forEach(network=>{const securityIcon=network.secure?'🔒':'🔓';const signalStrength=createSignalStrengthIndicator(network.rssi||network.signal_strength||-70);html+='<div class="network-item" onclick="selectNetwork(\''+
+network.ssid.replace(/'/g,"\\'")+'\')">';html+='<span class="network-name">'+network.ssid+'</span>';html+='<span class="network-info">'+securityIcon+' '+signalStrength+'</span>';html+='</div>';});html+='</div>';networksEl.innerHTML=html;}
+function selectNetwork(ssid){const ssidInput=document.getElementById('ssid');if(ssidInput){ssidInput.value=ssid;}
+const manualForm=document.getElementById('manualConnectForm');const toggleBtn=document.getElementById('manualToggleBtn');const networksList=document.getElementById('networks');if(manualForm&&manualForm.style.display==='none'){manualForm.style.display='block';if(toggleBtn)toggleBtn.textContent='Hide Manual Entry';if(networksList)networksList.style.display='none';}
+setTimeout(()=>{const passwordInput=document.getElementById('password');if(passwordInput){passwordInput.focus();}},100);updateStatus('ready','Enter password for '+ssid);}
+document.addEventListener('DOMContentLoaded',function(){initWebSocket();const form=document.getElementById('connectForm');if(form){form.addEventListener('submit',function(e){e.preventDefault();connectToWiFi();});}
+const scanBtn=document.getElementById('scanBtn');if(scanBtn){scanBtn.addEventListener('click',scanNetworks);}
+const manualToggleBtn=document.getElementById('manualToggleBtn');if(manualToggleBtn){manualToggleBtn.addEventListener('click',showManualForm);}
+const resetBtn=document.getElementById('resetBtn');if(resetBtn){resetBtn.addEventListener('click',resetConfig);}
+loadParameterSchema();loadInitialNetworks();setTimeout(function(){const networksEl=document.getElementById('networks');if(!networksEl.innerHTML||networksEl.innerHTML.trim()===''||networksEl.innerHTML.includes('Scanning for networks')){scanNetworks();}},500);});function loadNetworksFromAPI(){fetch('/networks.json').then(response=>{return response.json();}).then(data=>{if(data.networks&&data.networks.length>0){updateNetworks(data.networks);if(!scanInProgress){updateStatus('ready','Select a network or enter manually');}}else{updateNetworks([]);if(!scanInProgress){updateStatus('ready','No networks found. Try scanning again.');}}}).catch(error=>{if(!scanInProgress){updateStatus('ready','Click "Scan Networks" to find WiFi networks');}});}
+function loadInitialNetworks(){fetch('/status').then(response=>response.json()).then(statusData=>{if(statusData.scan_in_progress){scanInProgress=true;updateScanButton(true);updateStatus('scanning','Scanning for networks...');}
+loadNetworksFromAPI();}).catch(error=>{if(!scanInProgress){updateStatus('ready','Click "Scan Networks" to find WiFi networks');}});}
+const SCHEMA_CACHE_KEY='flexifiParameterSchema';function cacheableSchema(schema){return{parameters:(schema.parameters||[]).map(param=>{if(param.type!=='password'){return param;}
+const copy=Object.assign({},param);delete copy.value;return copy;})};}
+function loadParameterSchema(){const container=document.getElementById('customParameters');if(!container){return;}
+let cached=null;try{cached=JSON.parse(sessionStorage.getItem(SCHEMA_CACHE_KEY));}catch(e){cached=null;}
+if(cached&&cached.parameters){renderParameters(container,cached);}
+fetch('/params/schema',{cache:'no-cache'}).then(response=>{if(!response.ok){throw new Error('HTTP '+response.status);}
+return response.json();}).then(schema=>{renderParameters(container,schema);try{sessionStorage.setItem(SCHEMA_CACHE_KEY,JSON.stringify(cacheableSchema(schema)));}catch(e){}}).catch(error=>void 0);}
+function renderParameters(container,schema){container.innerHTML='';(schema.parameters||[]).forEach(param=>{if(param.html){container.insertAdjacentHTML('beforeend',param.html);return;}
+const group=document.createElement('div');group.className='form-group';const label=document.createElement('label');label.htmlFor=param.id;label.textContent=param.label;if(param.required){const marker=document.createElement('span');marker.className='required';marker.textContent='*';label.append(' ',marker);}
+group.appendChild(label);const input=createParameterInput(param);group.appendChild(input);if(param.type==='checkbox'){group.append(' '+param.label);}
+container.appendChild(group);});}
+function createParameterInput(param){let input;if(param.type==='select'){input=document.createElement('select');if(!param.required){input.add(new Option('-- Select --',''));}
+(param.options||[]).forEach(option=>{input.add(new Option(option,option,false,option===param.value));});}else if(param.type==='textarea'){input=document.createElement('textarea');input.rows=3;input.value=param.value;}else if(param.type==='checkbox'){input=document.createElement('input');input.type='checkbox';input.value='1';input.checked=param.value===true;}else{input=document.createElement('input');input.type=param.type;input.value=param.value;}
+input.id=param.id;input.name=param.id;if(param.type!=='select'&&param.type!=='checkbox'){if(param.maxLength){input.maxLength=param.maxLength;}
+if(param.placeholder){input.placeholder=param.placeholder;}
+if(param.pattern){input.pattern=param.pattern;}
+if(param.min!==undefined&&param.type==='number'){input.min=param.min;input.max=param.max;input.step='any';}}
+if(param.required&&param.type!=='checkbox'){input.required=true;}
+return input;}
+function showParameterErrors(errors){let first=null;Object.keys(errors).forEach(id=>{const field=document.getElementById(id);if(!field||!field.setCustomValidity){return;}
+field.setCustomValidity(errors[id]);field.addEventListener('input',()=>field.setCustomValidity(''),{once:true});first=first||field;});if(first){const manualForm=document.getElementById('manualConnectForm');if(manualForm&&manualForm.style.display==='none'){showManualForm();}
+first.reportValidity();}})FLEXIFI";
 const size_t js_portal_len = sizeof(js_portal) - 1;
+const char js_portal_etag[] = "18345a1505db3b22";
+const uint8_t js_portal_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5a, 0xdb, 0x6e, 0xdc, 0xc8,
+    0x11, 0x7d, 0xd7, 0x57, 0xd0, 0x0a, 0x30, 0x4d, 0x46, 0x1c, 0x4a, 0xbe, 0xe5, 0x32, 0x34, 0xb5,
+    0xf0, 0xca, 0xb3, 0x6b, 0x25, 0xd6, 0x05, 0x96, 0x90, 0xc5, 0x62, 0xbd, 0x10, 0x28, 0xb2, 0x67,
+    0x86, 0x16, 0x87, 0x9c, 0x90, 0x1c, 0x8f, 0x07, 0xa3, 0x79, 0x4b, 0xde, 0x02, 0x04, 0x48, 0xf2,
+    0x98, 0x20, 0x8f, 0xf9, 0x80, 0xfc, 0xd1, 0x7e, 0x41, 0x3e, 0x21, 0x55, 0xd5, 0x17, 0x36, 0x39,
+    0x17, 0x49, 0xf6, 0x26, 0x41, 0x0c, 0x58, 0x43, 0x76, 0x57, 0x75, 0x57, 0x57, 0x57, 0x9d, 0xae,
+    0xaa, 0x66, 0xca, 0x2b, 0x6b, 0x56, 0x06, 0xd9, 0x34, 0x4d, 0xfd, 0x14, 0x9e, 0xcb, 0x28, 0xcc,
+    0x8e, 0xb3, 0xf3, 0x22, 0x1f, 0x16, 0xbc, 0x2c, 0x83, 0x41, 0x98, 0x96, 0xdc, 0x1f, 0x4c, 0xb3,
+    0xa8, 0x4a, 0xf2, 0xcc, 0x4a, 0xb2, 0xa4, 0xfa, 0x86, 0x5f, 0x5f, 0xe4, 0xd1, 0x0d, 0xaf, 0x6c,
+    0x67, 0x91, 0x0c, 0x6c, 0xa6, 0xdf, 0x59, 0x92, 0x59, 0xb3, 0x24, 0x8b, 0xf3, 0x99, 0xb3, 0xc0,
+    0x21, 0xf9, 0xcc, 0xaa, 0x69, 0xd9, 0xac, 0xec, 0xed, 0xef, 0xb3, 0x3d, 0x41, 0xe0, 0xa5, 0x79,
+    0x14, 0xe2, 0x88, 0xde, 0x28, 0x2f, 0xab, 0x3d, 0xb6, 0x3f, 0x2b, 0x99, 0xe3, 0xcf, 0x4a, 0x2f,
+    0xcf, 0xf2, 0x09, 0xcf, 0x02, 0x35, 0x21, 0x4c, 0xb1, 0x14, 0xcd, 0x63, 0x90, 0x26, 0x1c, 0xf2,
+    0xba, 0x87, 0x7f, 0xe0, 0x59, 0xe5, 0x2c, 0x46, 0x61, 0x16, 0xa7, 0x5c, 0xcf, 0x73, 0x22, 0xc8,
+    0x44, 0xaf, 0x17, 0x87, 0x55, 0xe8, 0xf8, 0x72, 0x84, 0x28, 0xcd, 0x4b, 0x6e, 0x8e, 0x5c, 0xf2,
+    0xea, 0x32, 0x19, 0xf3, 0x7c, 0x5a, 0xd9, 0x8d, 0x75, 0xb9, 0xcf, 0x0f, 0x0e, 0x0e, 0x34, 0x1b,
+    0x2f, 0x8a, 0xbc, 0x30, 0xa6, 0xc5, 0x57, 0x94, 0x6a, 0xc9, 0x41, 0x33, 0x8b, 0xe5, 0x72, 0x47,
+    0x2b, 0x67, 0x83, 0x28, 0x24, 0xc4, 0xa2, 0x2a, 0xe6, 0x8b, 0x28, 0xcf, 0xca, 0xca, 0x1a, 0x97,
+    0xc3, 0xe0, 0x57, 0x17, 0x67, 0xa7, 0xde, 0x24, 0x2c, 0x4a, 0xd9, 0xed, 0x83, 0x22, 0xa1, 0xdd,
+    0xab, 0xe6, 0x13, 0x1e, 0x04, 0x01, 0xc3, 0x5d, 0xb8, 0x8a, 0xf2, 0xf1, 0x04, 0xb6, 0x84, 0x33,
+    0xd2, 0x33, 0x76, 0x23, 0xad, 0x57, 0xf0, 0x01, 0x6c, 0xcd, 0xe8, 0x2a, 0xe3, 0xd5, 0x2c, 0x2f,
+    0x6e, 0x4a, 0x67, 0x91, 0xe6, 0x61, 0x7c, 0x2a, 0xdf, 0xbe, 0x2a, 0xf2, 0xf1, 0xcb, 0xf3, 0x63,
+    0xdb, 0x11, 0x02, 0x5a, 0x26, 0x67, 0xcd, 0x31, 0x9d, 0x40, 0x03, 0x57, 0x3c, 0x6b, 0x28, 0xfc,
+    0xe5, 0xce, 0x5a, 0x4b, 0x10, 0x8c, 0x17, 0xd0, 0xf5, 0xe5, 0xb4, 0xaa, 0x40, 0x1f, 0xd4, 0xdc,
+    0x9a, 0x4c, 0xaf, 0xa2, 0x0a, 0xab, 0x69, 0x79, 0x25, 0x78, 0x98, 0x9a, 0xf5, 0x82, 0x5a, 0xeb,
+    0x39, 0x05, 0x95, 0xab, 0xdf, 0xe5, 0x4e, 0xb7, 0xc6, 0x1c, 0x85, 0xe5, 0xd9, 0x0c, 0xa5, 0x99,
+    0xf0, 0xa2, 0x9a, 0xdb, 0xac, 0x9c, 0x46, 0x11, 0x10, 0x32, 0x47, 0x2b, 0x47, 0xb6, 0xc0, 0xde,
+    0xd0, 0xce, 0x3c, 0x48, 0x7c, 0x39, 0x84, 0x9c, 0xba, 0xd3, 0x31, 0x5e, 0xbc, 0x04, 0x2c, 0x67,
+    0x1a, 0xf3, 0xd2, 0x66, 0xd5, 0xa8, 0xc8, 0xab, 0x2a, 0xe5, 0x38, 0x69, 0x63, 0x2d, 0xba, 0x27,
+    0x66, 0xae, 0xc1, 0x2a, 0x97, 0xd0, 0xa2, 0x25, 0x0b, 0x6a, 0xd0, 0xdd, 0xde, 0x32, 0x14, 0xc9,
+    0x1a, 0x84, 0x09, 0x0e, 0x01, 0x6c, 0xf0, 0x0f, 0xfc, 0x23, 0x1a, 0xd9, 0xdc, 0x21, 0xab, 0xc9,
+    0x53, 0xee, 0x11, 0x9f, 0xcd, 0xfa, 0xf8, 0x63, 0xa1, 0xed, 0x24, 0xd9, 0xb0, 0x76, 0x30, 0x4b,
+    0x8e, 0xd5, 0x63, 0x2e, 0xce, 0x6b, 0x98, 0x25, 0x2a, 0x42, 0xef, 0x34, 0x69, 0xab, 0xa9, 0x1a,
+    0x67, 0x51, 0xf0, 0x6a, 0x5a, 0x64, 0xab, 0x5b, 0x5e, 0x15, 0xd3, 0x35, 0x2a, 0xc3, 0x56, 0xc7,
+    0x6f, 0xae, 0x09, 0x19, 0x33, 0x90, 0x87, 0xb9, 0xb4, 0x12, 0x7c, 0xb4, 0x06, 0x20, 0xa6, 0xb2,
+    0x27, 0xcf, 0xf3, 0x60, 0x59, 0xc2, 0xfe, 0x55, 0xdb, 0x9b, 0xa4, 0xac, 0x82, 0x38, 0x8f, 0xa6,
+    0x63, 0x74, 0xd5, 0x21, 0xaf, 0xfa, 0x29, 0xc7, 0xc7, 0x2f, 0xe7, 0xc7, 0xb1, 0xcd, 0x14, 0x95,
+    0x66, 0x1b, 0x87, 0xd9, 0x34, 0x4c, 0xbf, 0xca, 0x8b, 0xf1, 0x66, 0x26, 0x41, 0x73, 0x94, 0x67,
+    0x19, 0x8f, 0x2a, 0x24, 0xd5, 0xdc, 0x55, 0x3e, 0x1c, 0xa6, 0xfc, 0xcb, 0x2a, 0xbb, 0x8b, 0xf9,
+    0x52, 0x11, 0x02, 0xab, 0x29, 0x29, 0x98, 0xe9, 0x1c, 0x36, 0x21, 0x4e, 0xca, 0x49, 0x1a, 0xce,
+    0x03, 0x76, 0x0d, 0x08, 0x76, 0xc3, 0xfc, 0x5a, 0xaa, 0x36, 0x41, 0x06, 0xd0, 0xc1, 0x7c, 0x3d,
+    0xaf, 0x57, 0xf1, 0x8f, 0x15, 0x48, 0x56, 0xc1, 0x7c, 0x01, 0xeb, 0xc3, 0x6f, 0x61, 0x9d, 0x10,
+    0x73, 0x3a, 0x67, 0x7e, 0xcb, 0x1f, 0xbf, 0xfb, 0xde, 0x15, 0x5a, 0x86, 0xcd, 0x9a, 0x95, 0x9d,
+    0x0e, 0x00, 0x51, 0xc1, 0xc3, 0x78, 0x8e, 0xea, 0x46, 0xcf, 0xd2, 0xbb, 0xee, 0x9d, 0x9d, 0xf7,
+    0x4f, 0x11, 0x6d, 0xbd, 0x92, 0x67, 0xb1, 0x4d, 0xb0, 0x52, 0x56, 0x05, 0xa8, 0x3f, 0x19, 0xcc,
+    0xed, 0x45, 0x48, 0x16, 0xd0, 0xa3, 0xed, 0x61, 0x4b, 0x47, 0xd9, 0xe3, 0x80, 0xa3, 0x69, 0xb1,
+    0x7d, 0x6a, 0x76, 0xbc, 0x6a, 0xc4, 0x33, 0x1b, 0x36, 0x7c, 0x02, 0x9a, 0xe2, 0xc1, 0xa1, 0x34,
+    0x07, 0x4b, 0xb5, 0x78, 0xef, 0x4b, 0x84, 0x4b, 0x7f, 0x29, 0x29, 0xd1, 0x49, 0x81, 0xea, 0xa1,
+    0xfe, 0x25, 0x7c, 0x5d, 0xf8, 0x68, 0xa7, 0x43, 0x6f, 0x02, 0x19, 0x5b, 0x6b, 0xaf, 0x7b, 0x6a,
+    0x00, 0x30, 0x71, 0x41, 0xf2, 0x7e, 0xa2, 0x77, 0xae, 0x41, 0x98, 0xf5, 0xee, 0x69, 0x12, 0xae,
+    0xf1, 0x4f, 0xc7, 0x93, 0xfe, 0x49, 0xa7, 0xc3, 0x61, 0xdb, 0x49, 0x7f, 0xf8, 0xdb, 0x1f, 0x2c,
+    0x62, 0xa1, 0x77, 0xf4, 0x49, 0x3a, 0x36, 0xfc, 0x07, 0x29, 0x6d, 0xad, 0x5c, 0xa6, 0x24, 0x9e,
+    0x75, 0x9e, 0xf2, 0x10, 0x54, 0x04, 0x87, 0x8b, 0x15, 0x0e, 0xc3, 0x24, 0x43, 0x2f, 0x5b, 0x36,
+    0xdd, 0x7f, 0x65, 0x74, 0xe5, 0xab, 0x8e, 0x3c, 0x8f, 0xf0, 0x7d, 0xab, 0x63, 0x48, 0x02, 0xed,
+    0x4b, 0xf2, 0xfd, 0x12, 0x0c, 0xfa, 0x4e, 0x26, 0x24, 0x6a, 0x30, 0x5e, 0x4c, 0x12, 0xf0, 0xce,
+    0x62, 0x3b, 0xa3, 0x24, 0x62, 0x64, 0x38, 0xb5, 0xbc, 0x72, 0x4c, 0xf4, 0xb1, 0xf0, 0x1a, 0xd6,
+    0x2f, 0x00, 0xca, 0x98, 0x69, 0xbd, 0x0f, 0x1a, 0x23, 0xb6, 0x09, 0x92, 0x2c, 0x4d, 0x32, 0xde,
+    0x95, 0xce, 0x5c, 0x1f, 0x1c, 0x8d, 0x59, 0xc4, 0x2e, 0x6d, 0x99, 0xa6, 0x39, 0xca, 0x96, 0xe9,
+    0x84, 0x3c, 0x0d, 0x70, 0xe6, 0x29, 0x40, 0x95, 0x34, 0x7e, 0xbb, 0x2c, 0x93, 0xd8, 0x59, 0x6c,
+    0x56, 0x0d, 0x74, 0x83, 0xbf, 0x7e, 0x08, 0xd3, 0x29, 0x0f, 0xf0, 0xc5, 0x2f, 0x47, 0xf9, 0xec,
+    0x44, 0x43, 0x10, 0x3a, 0xa9, 0x31, 0x74, 0xab, 0x6f, 0xf1, 0x3f, 0xc3, 0xd1, 0x4f, 0xc4, 0x7d,
+    0x3c, 0x94, 0x37, 0xc1, 0x6b, 0x20, 0x95, 0xe9, 0x2c, 0x36, 0x23, 0xb0, 0xdc, 0x8f, 0x0d, 0x10,
+    0xfc, 0x3a, 0x89, 0xb9, 0x44, 0x60, 0x0b, 0xe0, 0xb8, 0x00, 0x14, 0xde, 0x86, 0xf7, 0x72, 0xeb,
+    0xc8, 0x42, 0x7e, 0x24, 0xd0, 0xbf, 0xc7, 0xf1, 0x62, 0x9a, 0x4a, 0x24, 0xb6, 0xe3, 0x32, 0xff,
+    0x26, 0xf9, 0x2a, 0xd1, 0xdb, 0x89, 0x66, 0x10, 0xdc, 0xcb, 0x62, 0xe4, 0x36, 0x4c, 0xc2, 0xb2,
+    0x84, 0x69, 0xb7, 0x30, 0x29, 0x0a, 0xcd, 0x08, 0x1b, 0xf1, 0x48, 0x98, 0x66, 0x98, 0x42, 0xf4,
+    0x65, 0x33, 0x09, 0x3b, 0x9c, 0x16, 0x14, 0xaa, 0x9d, 0xb5, 0xb2, 0x70, 0x0c, 0x3b, 0xe2, 0xeb,
+    0x70, 0xa2, 0x09, 0x60, 0x52, 0x7e, 0x11, 0x25, 0x1c, 0xe9, 0x17, 0x30, 0x29, 0x8b, 0xed, 0xe1,
+    0xf0, 0x7b, 0xcc, 0x0c, 0x13, 0xe8, 0x98, 0xc1, 0x1c, 0x02, 0xf5, 0xfc, 0x0a, 0x5e, 0xc0, 0xba,
+    0x09, 0x94, 0xc3, 0xc9, 0x04, 0xcf, 0x3a, 0xb1, 0x36, 0x97, 0xe4, 0x6a, 0x76, 0x68, 0xf9, 0x5d,
+    0xf5, 0xa4, 0xc6, 0x1c, 0x6c, 0xb5, 0xfa, 0xa8, 0x61, 0xef, 0xb0, 0x68, 0x24, 0x57, 0x7a, 0x1e,
+    0x48, 0x29, 0x9a, 0x22, 0x11, 0x85, 0x0f, 0x7f, 0x6d, 0x08, 0xd4, 0xbf, 0xbb, 0xe1, 0x73, 0x97,
+    0x34, 0xf6, 0x7d, 0x3e, 0xd0, 0x0c, 0x1e, 0x8c, 0x5f, 0x24, 0x70, 0x40, 0x89, 0x48, 0x15, 0x68,
+    0x1e, 0x61, 0x68, 0x8c, 0xc2, 0x77, 0x3a, 0xf2, 0xad, 0xd6, 0xf8, 0xc2, 0x5c, 0x89, 0x1e, 0x8f,
+    0x22, 0xc2, 0x1d, 0x75, 0x6c, 0x4b, 0x39, 0x99, 0xbb, 0x18, 0xf3, 0x6a, 0x94, 0xc7, 0x3d, 0x76,
+    0x7e, 0x76, 0x71, 0xc9, 0xdc, 0xeb, 0x3c, 0x9e, 0xf7, 0x90, 0x7f, 0xb9, 0x72, 0xa6, 0xb7, 0xce,
+    0xf2, 0xe6, 0x49, 0xde, 0x3a, 0x9c, 0xdb, 0xa7, 0xa7, 0x9c, 0x0e, 0x4f, 0x4f, 0xb5, 0x6d, 0x3c,
+    0xb6, 0x24, 0xf1, 0x00, 0xf2, 0xc6, 0xf9, 0x23, 0x50, 0x97, 0x91, 0x4c, 0xd9, 0x0e, 0x0c, 0xba,
+    0x92, 0xe7, 0x41, 0xda, 0x12, 0xb0, 0x7d, 0x30, 0x69, 0xf7, 0xa9, 0x48, 0xaf, 0x1a, 0x87, 0x3b,
+    0x9d, 0x6e, 0x30, 0x35, 0x82, 0xd6, 0x79, 0x58, 0x80, 0x21, 0x81, 0x69, 0x51, 0xa8, 0x5b, 0x36,
+    0x08, 0x5a, 0x87, 0xa2, 0x3c, 0x91, 0xef, 0x71, 0xac, 0x2b, 0x4a, 0x6d, 0x79, 0xb9, 0x3a, 0x45,
+    0x7b, 0x60, 0x7e, 0x2d, 0xfe, 0xbb, 0x8e, 0x77, 0x63, 0x8c, 0xd6, 0x01, 0x7f, 0xdf, 0x49, 0xe5,
+    0x39, 0x5d, 0x7b, 0x37, 0xec, 0x10, 0x47, 0xa8, 0x18, 0x24, 0x43, 0x11, 0xa4, 0x47, 0xf8, 0x0c,
+    0xb8, 0xcd, 0x5e, 0x16, 0xdc, 0x9a, 0xe7, 0x53, 0xd0, 0xb8, 0x7c, 0x98, 0x85, 0x19, 0x02, 0xb1,
+    0x60, 0xb1, 0x60, 0x27, 0x2d, 0xa2, 0x1d, 0x4e, 0x0b, 0x52, 0xf5, 0x17, 0x18, 0x00, 0x29, 0x5b,
+    0x21, 0x9a, 0xb6, 0xa5, 0x28, 0xfb, 0xa0, 0x8d, 0x6a, 0x4a, 0x4c, 0x61, 0xa6, 0x10, 0xb8, 0x1e,
+    0x51, 0xcc, 0x04, 0x22, 0xdf, 0xef, 0x64, 0x62, 0xcc, 0xbf, 0x37, 0xb6, 0x20, 0xf1, 0x67, 0xf8,
+    0x26, 0xfe, 0xf5, 0x48, 0x3a, 0x7b, 0xcd, 0xb6, 0xb5, 0x76, 0xed, 0x2d, 0xe9, 0xab, 0xb9, 0x61,
+    0x6b, 0x63, 0x25, 0xa1, 0x0b, 0x95, 0x97, 0x4a, 0xab, 0x50, 0x78, 0x4b, 0xad, 0xfd, 0x74, 0x0b,
+    0xe6, 0x12, 0x05, 0xba, 0x84, 0x24, 0xf5, 0xa2, 0x14, 0x56, 0x7d, 0x0a, 0x36, 0xad, 0x52, 0x62,
+    0x04, 0x3c, 0x7a, 0xa8, 0x69, 0xcc, 0x93, 0x42, 0x87, 0x9d, 0x30, 0xb4, 0x10, 0x46, 0xd5, 0x12,
+    0x04, 0x79, 0xc3, 0x70, 0x36, 0xd1, 0x2c, 0xca, 0x59, 0x82, 0xba, 0x50, 0xaf, 0x11, 0x20, 0x76,
+    0x9d, 0xa7, 0xf5, 0x04, 0x48, 0xb3, 0x7f, 0xfd, 0xfd, 0x2f, 0xbf, 0xb3, 0x36, 0xa6, 0x6c, 0x3e,
+    0x31, 0x19, 0xc0, 0xad, 0xd8, 0x7e, 0xf8, 0xe3, 0x3f, 0xad, 0x26, 0x84, 0x4b, 0xb6, 0x15, 0x2e,
+    0x30, 0x75, 0xcd, 0xf4, 0xd7, 0xdf, 0x5b, 0x9b, 0x00, 0x44, 0xf0, 0x48, 0xdf, 0xd0, 0x0c, 0x10,
+    0x45, 0xaf, 0x7a, 0x8e, 0x20, 0x15, 0xe1, 0xb0, 0x49, 0x29, 0x12, 0xe3, 0x3c, 0x8a, 0xa6, 0x45,
+    0xa1, 0xc9, 0xea, 0xd0, 0xdf, 0x14, 0x9d, 0x62, 0x68, 0xdd, 0x65, 0x75, 0xad, 0x89, 0x38, 0xd0,
+    0x66, 0x61, 0x52, 0x81, 0xf1, 0xf2, 0x41, 0x38, 0x4d, 0x2b, 0x43, 0x45, 0xff, 0xb0, 0xde, 0xa2,
+    0x5f, 0xe0, 0x3a, 0x95, 0xab, 0xb5, 0xe2, 0xb8, 0x08, 0x1c, 0x07, 0x2c, 0x27, 0x19, 0x66, 0x61,
+    0x7a, 0x51, 0x15, 0x3c, 0x1b, 0x56, 0xa3, 0xe3, 0x2c, 0x4e, 0xc0, 0x1e, 0xc1, 0xf4, 0x0a, 0xf0,
+    0x0f, 0x67, 0x41, 0xe5, 0x35, 0xd9, 0x17, 0x1c, 0xa0, 0x11, 0x63, 0xfb, 0x61, 0xd0, 0x7d, 0x7a,
+    0xe0, 0xe8, 0xf6, 0xe7, 0xbe, 0xc2, 0x45, 0xd9, 0xf9, 0xdc, 0xe8, 0x7c, 0xd6, 0xee, 0xfc, 0x99,
+    0xd1, 0xf9, 0xb4, 0xdd, 0xf9, 0x73, 0xa3, 0xf3, 0x49, 0xbb, 0xf3, 0x17, 0x46, 0xe7, 0x63, 0xd1,
+    0x69, 0xc8, 0x26, 0x6c, 0x3d, 0xca, 0xd3, 0xbc, 0x38, 0x09, 0x27, 0xc1, 0xe2, 0x79, 0x8f, 0x7d,
+    0xfd, 0xb6, 0xdf, 0x3f, 0x65, 0xee, 0xb3, 0x1e, 0xfb, 0xb6, 0xff, 0xe6, 0xcd, 0xd9, 0x37, 0x5d,
+    0xd9, 0xf0, 0x54, 0x37, 0x9c, 0xbd, 0x7d, 0x79, 0xfa, 0x75, 0x9f, 0xb9, 0x4f, 0x7a, 0xec, 0x6d,
+    0xff, 0x95, 0x7e, 0x7d, 0x4c, 0xaf, 0xcc, 0x3d, 0xe8, 0xb1, 0x57, 0xc7, 0x27, 0x16, 0x3e, 0x2f,
+    0x65, 0x8c, 0xc0, 0x5e, 0xc4, 0xc9, 0x07, 0x8b, 0xdc, 0x23, 0xd8, 0x2d, 0x49, 0x79, 0x5d, 0x25,
+    0x85, 0x16, 0xa7, 0x8b, 0xce, 0x22, 0x1e, 0xf7, 0xd8, 0xee, 0x21, 0xdb, 0xdb, 0x61, 0x2f, 0xca,
+    0x09, 0x6c, 0xa0, 0xe4, 0xbb, 0x0e, 0x0b, 0x0b, 0xfe, 0x77, 0x1f, 0xef, 0x1e, 0xbe, 0xd8, 0xc7,
+    0x8e, 0xcd, 0x24, 0x4f, 0xee, 0x26, 0x79, 0x7a, 0x37, 0xc9, 0xb3, 0xbb, 0x49, 0x9e, 0x37, 0x49,
+    0xf6, 0x61, 0x99, 0x87, 0xcc, 0x5f, 0x41, 0x1a, 0x9d, 0xf4, 0x2a, 0xa7, 0x73, 0x93, 0x52, 0x39,
+    0xa3, 0x48, 0x3b, 0x14, 0xec, 0x28, 0x82, 0x6d, 0xc0, 0xd3, 0x0c, 0x9d, 0xeb, 0x91, 0x9c, 0x45,
+    0xcd, 0xed, 0x51, 0x5e, 0xf2, 0xfa, 0xf2, 0xe4, 0x4d, 0xc0, 0x5e, 0x4c, 0x2c, 0x8a, 0x3a, 0x83,
+    0x5d, 0xda, 0xe8, 0x9e, 0xf5, 0x93, 0x5f, 0x3e, 0x79, 0x76, 0x70, 0xc0, 0xfd, 0xdd, 0xc3, 0x06,
+    0x2c, 0x80, 0x4f, 0xbf, 0xd8, 0x9f, 0x80, 0xfc, 0x3a, 0xb0, 0xc3, 0x80, 0x50, 0x8d, 0x79, 0x7b,
+    0xab, 0x11, 0x23, 0x15, 0xe6, 0x13, 0x04, 0x07, 0x9b, 0xa7, 0x3c, 0x3c, 0xd5, 0x58, 0x51, 0x02,
+    0xde, 0x4c, 0xb3, 0x58, 0x8c, 0x4d, 0x31, 0x66, 0xab, 0x2e, 0xf5, 0x60, 0xc4, 0x95, 0x66, 0x8b,
+    0x00, 0x90, 0x49, 0x54, 0x0c, 0x56, 0x51, 0x98, 0xe6, 0x6a, 0x10, 0x19, 0x55, 0x04, 0x81, 0x2b,
+    0x4e, 0xa7, 0xb3, 0x91, 0xa2, 0x86, 0x94, 0x6d, 0x54, 0x06, 0x68, 0xae, 0xd4, 0x23, 0xd4, 0x21,
+    0xbb, 0xa2, 0x0a, 0xcf, 0xba, 0x84, 0x4c, 0x5e, 0x81, 0xb4, 0x91, 0xd2, 0x2f, 0x77, 0x36, 0x04,
+    0xd5, 0x6a, 0xa8, 0x0b, 0xca, 0x23, 0x8d, 0x58, 0x1c, 0xa0, 0x50, 0x84, 0xe7, 0x63, 0x95, 0x6f,
+    0x38, 0x54, 0xdf, 0x1f, 0x55, 0xe3, 0x34, 0x68, 0xf8, 0x9d, 0xe4, 0xe8, 0xa6, 0x90, 0x86, 0x80,
+    0x7b, 0xe9, 0xb4, 0xc4, 0x83, 0xd3, 0xa0, 0x1f, 0xc2, 0x09, 0x22, 0x1b, 0x64, 0x18, 0x04, 0x1b,
+    0xc2, 0x61, 0xd1, 0x49, 0x35, 0x3f, 0x86, 0xd7, 0x40, 0xe1, 0x3e, 0x35, 0xf2, 0x2f, 0x10, 0x2d,
+    0xff, 0xc4, 0x7a, 0xf8, 0xf3, 0x67, 0x75, 0xb2, 0x97, 0x0d, 0x54, 0x0c, 0xb6, 0x43, 0xa5, 0x1a,
+    0x0f, 0x61, 0x4a, 0x9b, 0x96, 0x27, 0x86, 0xb8, 0x52, 0x38, 0x70, 0x7b, 0x8b, 0xe0, 0xe6, 0xe3,
+    0x5a, 0xf6, 0xd6, 0x2f, 0x26, 0xa9, 0xf8, 0x78, 0xd7, 0xc2, 0xa2, 0x7f, 0x12, 0xdd, 0x00, 0xb6,
+    0x34, 0xd2, 0xec, 0x77, 0x0c, 0xbc, 0x52, 0x0f, 0x0d, 0xa1, 0x0b, 0x84, 0x10, 0x90, 0x76, 0x45,
+    0xdc, 0xde, 0x67, 0xfb, 0x43, 0x77, 0xf7, 0xdd, 0x3b, 0xb6, 0xeb, 0xec, 0xb1, 0x77, 0xcc, 0x41,
+    0x7d, 0xa8, 0x59, 0x4c, 0x3f, 0x57, 0xd3, 0x60, 0xc6, 0x83, 0x90, 0x64, 0x0e, 0xb6, 0xc7, 0x94,
+    0xeb, 0x6f, 0x65, 0x4d, 0xb2, 0x41, 0x8e, 0xac, 0xa6, 0x36, 0xf7, 0x18, 0x46, 0x06, 0x0d, 0xcd,
+    0xac, 0x19, 0x4d, 0xa1, 0x89, 0xd3, 0x6e, 0x59, 0xeb, 0x73, 0x48, 0xe3, 0xdf, 0x51, 0x71, 0xa8,
+    0x53, 0xc9, 0xe3, 0x6c, 0x32, 0xad, 0xee, 0xca, 0x27, 0xa9, 0x2a, 0xa3, 0x88, 0x21, 0xd0, 0x50,
+    0x8f, 0x66, 0x65, 0x62, 0xb9, 0xf3, 0x7f, 0x5d, 0x6e, 0xe8, 0x74, 0x7e, 0x8c, 0xd2, 0x03, 0x0c,
+    0xa9, 0x57, 0xe0, 0xdc, 0xbf, 0x0e, 0x01, 0x6c, 0xa6, 0xf4, 0xce, 0x3d, 0xea, 0x12, 0x3b, 0xed,
+    0xfc, 0xab, 0x99, 0xec, 0xdf, 0xb1, 0xad, 0x75, 0x54, 0x8e, 0x73, 0x37, 0x98, 0x9c, 0x45, 0xe3,
+    0x15, 0x40, 0x21, 0x02, 0xdc, 0x41, 0x48, 0x72, 0x1f, 0x63, 0x1a, 0xb7, 0x1e, 0x8e, 0x44, 0xa9,
+    0x43, 0x71, 0x52, 0x5c, 0x29, 0x72, 0x7c, 0x0c, 0x5d, 0xb5, 0x18, 0x61, 0x1c, 0xf7, 0xf1, 0x9e,
+    0x0e, 0xd7, 0xc5, 0xc1, 0x5e, 0x6d, 0xf6, 0xea, 0xec, 0x44, 0x2a, 0xe6, 0x4d, 0x1e, 0xc6, 0x98,
+    0x3a, 0x19, 0xf7, 0x75, 0xad, 0xcb, 0xc7, 0xcf, 0xce, 0x1b, 0x56, 0xa7, 0x2f, 0xa7, 0xd7, 0x63,
+    0x88, 0x00, 0xeb, 0x49, 0xe1, 0xfc, 0xe5, 0xde, 0xa4, 0xa0, 0xdb, 0xc4, 0x57, 0x22, 0x2c, 0x14,
+    0x13, 0x9b, 0x95, 0x18, 0x91, 0xc9, 0x3d, 0xb8, 0x98, 0x2a, 0x4b, 0x9b, 0x68, 0x1a, 0xba, 0xe6,
+    0xb8, 0x2a, 0x12, 0x01, 0x18, 0x73, 0xcd, 0x4b, 0x1c, 0xa7, 0xe5, 0x5c, 0x97, 0x9f, 0xe2, 0x24,
+    0xda, 0xda, 0x75, 0xa3, 0xb2, 0x67, 0xdd, 0xb0, 0x45, 0x9a, 0x46, 0x69, 0xb1, 0x96, 0x87, 0x32,
+    0xb1, 0xad, 0x82, 0x28, 0x0a, 0x21, 0x81, 0x7a, 0xc3, 0x2b, 0x28, 0xf1, 0xb4, 0x79, 0x4e, 0x23,
+    0x41, 0xc6, 0x09, 0xf1, 0xce, 0x53, 0x17, 0x0a, 0x2e, 0xa2, 0x11, 0x1f, 0x63, 0x81, 0x08, 0x5b,
+    0x8f, 0xc1, 0x4c, 0x92, 0x30, 0xad, 0xaf, 0xbc, 0xcc, 0xda, 0x84, 0x61, 0x4e, 0x9f, 0x1a, 0x58,
+    0x3d, 0x5a, 0x07, 0xb3, 0x75, 0x14, 0x64, 0xb6, 0x7a, 0x55, 0x91, 0x8c, 0xc1, 0x1d, 0x01, 0x32,
+    0xd8, 0x06, 0x8a, 0x3a, 0x62, 0x58, 0x9b, 0x85, 0x61, 0xf0, 0xd0, 0xbc, 0xc0, 0x43, 0xcf, 0x7b,
+    0x4e, 0x05, 0x14, 0xa7, 0xbe, 0x97, 0x5f, 0x7b, 0x03, 0xac, 0x8b, 0x00, 0xfa, 0x44, 0xc7, 0xea,
+    0xcf, 0x27, 0x5f, 0xf8, 0xa8, 0x52, 0x8d, 0x1a, 0x4d, 0x5e, 0xc4, 0xb4, 0xa2, 0xbf, 0xc3, 0x83,
+    0xf5, 0x37, 0x3a, 0xf5, 0xcd, 0xf2, 0xba, 0x48, 0xef, 0x33, 0x82, 0x9a, 0xa5, 0x59, 0xed, 0x31,
+    0x6e, 0xd0, 0x1e, 0x32, 0xd1, 0x03, 0x02, 0xb1, 0x95, 0xd2, 0xd0, 0xfd, 0x67, 0x39, 0x42, 0x43,
+    0xb6, 0x76, 0x29, 0xf9, 0x54, 0x82, 0xee, 0x62, 0x4e, 0x39, 0x48, 0xb2, 0xd8, 0x42, 0x2c, 0x31,
+    0xb6, 0x1d, 0xab, 0x19, 0xe6, 0xb1, 0xbd, 0xd6, 0xb2, 0xeb, 0x9b, 0x3c, 0x19, 0x01, 0xdf, 0xaf,
+    0xee, 0x27, 0xa8, 0x5f, 0xe9, 0x6d, 0xad, 0xdf, 0x3d, 0xfa, 0xf0, 0x20, 0xc9, 0xae, 0x26, 0x7a,
+    0x2d, 0xff, 0xe1, 0x3b, 0x61, 0xe1, 0xc9, 0x6b, 0xbe, 0x5e, 0xf8, 0xef, 0xea, 0x59, 0x80, 0xc1,
+    0xc5, 0xd1, 0xeb, 0xfe, 0xc9, 0xcb, 0xab, 0xa3, 0x97, 0xf0, 0x7b, 0xf5, 0xeb, 0xfe, 0xb7, 0x01,
+    0x1b, 0xa4, 0xfc, 0x63, 0x32, 0x48, 0x5a, 0x48, 0xc3, 0x6a, 0xcf, 0x8b, 0x20, 0x42, 0xe6, 0x78,
+    0x4f, 0x24, 0x31, 0xa8, 0xa4, 0x1f, 0x75, 0xa7, 0x0e, 0x87, 0xa7, 0x64, 0x2c, 0x7b, 0xb2, 0xcb,
+    0xab, 0x9b, 0x6e, 0x6f, 0xc1, 0x4c, 0xbd, 0x71, 0x38, 0xb1, 0xa9, 0x4d, 0x2c, 0x92, 0x1e, 0xe9,
+    0x13, 0x8a, 0x56, 0x65, 0x58, 0x7a, 0x29, 0xf5, 0x6b, 0x89, 0xa3, 0x7c, 0x32, 0x0f, 0xce, 0xae,
+    0xdf, 0x83, 0x9f, 0x78, 0x40, 0x0a, 0xa1, 0xa3, 0xbd, 0x58, 0xba, 0x44, 0xe3, 0xf8, 0x31, 0xc7,
+    0xcf, 0x47, 0x88, 0x46, 0x56, 0xf2, 0xe5, 0x18, 0xd8, 0x02, 0x1a, 0x5e, 0xb6, 0x0d, 0x6c, 0x05,
+    0x50, 0x17, 0x6a, 0x96, 0xac, 0x02, 0x0f, 0xd8, 0x76, 0x6d, 0x07, 0x51, 0x41, 0x95, 0x8f, 0xf5,
+    0x00, 0x0a, 0x2b, 0x35, 0xa7, 0xf1, 0x95, 0x01, 0xa6, 0x21, 0xa4, 0xb6, 0x58, 0x7c, 0x76, 0x44,
+    0x9f, 0xc6, 0x88, 0x77, 0xe3, 0xbb, 0x98, 0x12, 0x76, 0x18, 0xe4, 0xba, 0x80, 0xa4, 0x00, 0xef,
+    0x79, 0x61, 0xbe, 0x63, 0x88, 0xe9, 0xed, 0xf6, 0x16, 0x61, 0x05, 0xaf, 0xfe, 0x54, 0xc2, 0x18,
+    0x95, 0xb2, 0x54, 0xd1, 0xd0, 0xe9, 0x88, 0x5f, 0x43, 0xf5, 0x28, 0x4e, 0x16, 0xf3, 0xa2, 0x16,
+    0xd8, 0xd6, 0xa2, 0xba, 0x82, 0x9a, 0xdc, 0x4f, 0xfa, 0x17, 0x31, 0x96, 0xfb, 0x62, 0x07, 0x99,
+    0x2b, 0x26, 0xea, 0x41, 0xf0, 0xd5, 0xa5, 0x27, 0xb6, 0x5a, 0x71, 0x27, 0x7b, 0xd5, 0xee, 0x97,
+    0xdf, 0x38, 0x0b, 0xcc, 0x1b, 0x67, 0x16, 0x5e, 0x1f, 0xf4, 0x45, 0x3d, 0xf2, 0xf5, 0xe5, 0xe5,
+    0x39, 0x84, 0x45, 0x9a, 0xa8, 0x2e, 0xee, 0xdd, 0x01, 0xc8, 0x42, 0x0c, 0x02, 0xee, 0x8d, 0x6b,
+    0x90, 0x76, 0x48, 0xca, 0x6d, 0xa9, 0xb2, 0xdc, 0xa0, 0x4a, 0xb7, 0xf5, 0xf9, 0xc0, 0x06, 0xd3,
+    0x6e, 0x68, 0x7c, 0x05, 0x0f, 0x3f, 0xe4, 0x49, 0x6c, 0x1d, 0xb4, 0x4a, 0xdb, 0x77, 0x49, 0xb9,
+    0xd0, 0x2d, 0x66, 0xb1, 0x80, 0xf9, 0x9b, 0x5c, 0x46, 0x65, 0xa6, 0x2b, 0x6e, 0x83, 0xc9, 0x4e,
+    0x73, 0xb4, 0x92, 0x17, 0xd5, 0xcb, 0xf8, 0x3d, 0x24, 0x77, 0x59, 0x85, 0xc3, 0xda, 0xec, 0x9a,
+    0x03, 0x3b, 0x07, 0x99, 0x98, 0x6b, 0x30, 0xd5, 0xc5, 0x0d, 0x61, 0xf2, 0xc3, 0x22, 0x9f, 0x4e,
+    0x6a, 0x73, 0x17, 0x49, 0xab, 0xb4, 0x78, 0x9b, 0x41, 0xbe, 0x05, 0x06, 0x4e, 0x34, 0x66, 0x75,
+    0x17, 0xc3, 0xca, 0x2e, 0xb5, 0xaa, 0xdc, 0x37, 0x0d, 0xaf, 0x79, 0xba, 0x71, 0x18, 0xea, 0xc5,
+    0xc4, 0x1c, 0x7f, 0x49, 0x0e, 0x88, 0xa7, 0x02, 0x21, 0x15, 0xe4, 0x50, 0xa2, 0xd9, 0xcc, 0x16,
+    0x44, 0x17, 0xb5, 0xfb, 0x7a, 0xd1, 0x05, 0xff, 0xed, 0x34, 0x29, 0x78, 0x5c, 0xdf, 0xf0, 0x16,
+    0x37, 0xa6, 0xab, 0xb6, 0x26, 0xc5, 0x6c, 0x12, 0xe6, 0x14, 0x54, 0xa6, 0xf4, 0x6a, 0x1c, 0xa6,
+    0xfa, 0x1a, 0x79, 0xca, 0x4f, 0x99, 0x94, 0x47, 0x5d, 0xb3, 0x59, 0xcc, 0x15, 0x74, 0xb8, 0xd9,
+    0x42, 0x15, 0xa2, 0xeb, 0x68, 0x94, 0xa4, 0xb1, 0x4d, 0xc4, 0x2a, 0x48, 0x4f, 0x28, 0xff, 0x10,
+    0x82, 0x68, 0x43, 0xa0, 0x84, 0xc2, 0x96, 0x58, 0xb5, 0x3a, 0x00, 0xf1, 0x38, 0x7e, 0x03, 0x12,
+    0x31, 0x92, 0x02, 0x93, 0x88, 0x6e, 0xae, 0xf3, 0x8f, 0x00, 0x89, 0x26, 0x13, 0x0a, 0xb4, 0x67,
+    0xe8, 0x47, 0xa2, 0xba, 0x34, 0x04, 0x73, 0x60, 0xe2, 0x6a, 0xdf, 0xbf, 0x6c, 0x91, 0x8d, 0x0a,
+    0xb7, 0x24, 0xcd, 0xaa, 0x30, 0x22, 0x9b, 0xc6, 0x2f, 0xf4, 0x9a, 0x19, 0x56, 0x5b, 0xe7, 0x92,
+    0x8c, 0x30, 0xb1, 0xbd, 0x6b, 0xc4, 0x8a, 0x81, 0xaf, 0x8d, 0xe0, 0x70, 0x36, 0xa1, 0xf8, 0x94,
+    0x75, 0xbb, 0x96, 0x8c, 0x7f, 0xba, 0x5d, 0x38, 0xd4, 0x18, 0xba, 0xdd, 0x8e, 0x9c, 0x3d, 0x27,
+    0x9a, 0x96, 0x33, 0x88, 0x46, 0xf4, 0x86, 0x75, 0xe3, 0x89, 0x5e, 0x57, 0xfe, 0x50, 0x6d, 0x51,
+    0xbe, 0xc0, 0x32, 0xc4, 0xa8, 0xe2, 0xaa, 0x51, 0x28, 0x46, 0x55, 0x8b, 0x9b, 0xab, 0x45, 0x83,
+    0x08, 0x61, 0x65, 0x77, 0xae, 0xb7, 0x26, 0xf4, 0x85, 0x34, 0x00, 0x7d, 0x65, 0xf0, 0x54, 0xbe,
+    0x88, 0x32, 0x81, 0x31, 0xe9, 0xa6, 0xf9, 0x8c, 0xad, 0xde, 0x3e, 0x1f, 0xf5, 0xea, 0xc9, 0x88,
+    0xbd, 0x66, 0x6e, 0xcc, 0xca, 0x1e, 0xab, 0x77, 0xea, 0x87, 0xd3, 0xc2, 0x90, 0x03, 0xe6, 0xa4,
+    0xf8, 0x46, 0x84, 0x94, 0x0f, 0x9e, 0xb2, 0x16, 0x7e, 0xf3, 0x42, 0x77, 0x44, 0x4f, 0x12, 0xd7,
+    0x6e, 0x2e, 0x5a, 0xb0, 0x94, 0x64, 0xb4, 0xb5, 0x03, 0x01, 0x69, 0x41, 0x9d, 0x4e, 0xb3, 0xd9,
+    0xd4, 0x90, 0x62, 0x19, 0x87, 0x1f, 0xdf, 0x50, 0x2c, 0xae, 0x4c, 0x4b, 0x37, 0x04, 0x2d, 0x02,
+    0x71, 0x48, 0x8a, 0x46, 0x2a, 0x80, 0x8d, 0xf2, 0x34, 0xc6, 0xb3, 0x5a, 0xf0, 0x19, 0x4d, 0xc1,
+    0x0a, 0x51, 0x83, 0x37, 0xac, 0xc0, 0x67, 0x32, 0xcd, 0x27, 0x5e, 0x83, 0x46, 0xa7, 0x49, 0x3f,
+    0x4e, 0x32, 0x10, 0x1e, 0xe2, 0x6c, 0x0e, 0x21, 0x19, 0x9e, 0xcf, 0xcd, 0x6d, 0xcf, 0xa6, 0xe3,
+    0x6b, 0xfc, 0xfa, 0x47, 0x89, 0x9f, 0xa8, 0xa1, 0xe0, 0xc9, 0xd7, 0x4b, 0xaa, 0x17, 0x23, 0xdb,
+    0x20, 0x61, 0x9c, 0x04, 0x2c, 0xcc, 0xe6, 0x74, 0x35, 0xb3, 0x02, 0x8f, 0xdb, 0x54, 0x27, 0x6c,
+    0x54, 0x12, 0x4a, 0x1b, 0x50, 0xa7, 0xb0, 0xf0, 0xfc, 0xd6, 0x87, 0x35, 0xed, 0x3b, 0x6a, 0x75,
+    0x7f, 0x8d, 0x50, 0x31, 0x48, 0x8a, 0xb2, 0x12, 0x41, 0x88, 0x8c, 0xcc, 0x6e, 0xf8, 0x5c, 0x93,
+    0x68, 0x7f, 0x05, 0x13, 0x50, 0x65, 0x9a, 0x41, 0xc2, 0xd3, 0xcd, 0x1f, 0x64, 0x60, 0xd5, 0x04,
+    0x71, 0x83, 0xa8, 0x6e, 0x6f, 0xc5, 0x2f, 0x9e, 0xe2, 0x47, 0x14, 0x73, 0xfd, 0x26, 0x4c, 0x93,
+    0x38, 0xa9, 0xe6, 0x46, 0x84, 0xb5, 0x81, 0x42, 0x8a, 0xf0, 0x5d, 0x12, 0x43, 0x76, 0x24, 0x68,
+    0x56, 0xd3, 0x6d, 0x61, 0xd7, 0x2e, 0x16, 0x91, 0x36, 0x0d, 0x03, 0x60, 0xe4, 0x2e, 0xf2, 0x2c,
+    0xe2, 0x3d, 0xd4, 0x14, 0xe6, 0xa1, 0xb4, 0x62, 0xfa, 0x7b, 0x7b, 0x4b, 0x5c, 0x08, 0x22, 0x58,
+    0x6d, 0xc1, 0xa6, 0xcf, 0xfd, 0xf2, 0xe8, 0xe1, 0x85, 0xb9, 0x75, 0x9f, 0x45, 0xa1, 0x24, 0x58,
+    0xe7, 0xcd, 0x8b, 0x4a, 0x2f, 0x04, 0xa3, 0xff, 0x7f, 0x03, 0x67, 0x5d, 0x50, 0x3b, 0x01, 0x2f,
+    0x00, 0x00,
+};
+const size_t js_portal_gz_len = sizeof(js_portal_gz);
+
+#ifndef FLEXIFI_DISABLE_PRERENDERED
+    // Pre-rendered Pages (gzip)
+
+// Pre-rendered from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/classic.html (931 bytes, gzipped: 503 bytes)
+const uint8_t page_classic_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x53, 0xcd, 0x6e, 0x13, 0x31,
+    0x10, 0x7e, 0x95, 0x61, 0x2f, 0x6d, 0x25, 0x9a, 0x4d, 0x52, 0x22, 0x2a, 0xea, 0x35, 0x87, 0xa0,
+    0x4a, 0x5c, 0xaa, 0xaa, 0x41, 0xe2, 0xec, 0xb5, 0x67, 0xd9, 0x21, 0x8e, 0xbd, 0xd8, 0xb3, 0x09,
+    0x79, 0x0f, 0xee, 0x1c, 0x79, 0x3d, 0x1e, 0x01, 0x3b, 0x9b, 0x44, 0x4b, 0x45, 0xc5, 0x65, 0xb5,
+    0xf3, 0xfb, 0x7d, 0xf3, 0xcd, 0x58, 0xbc, 0x32, 0x5e, 0xf3, 0xbe, 0x43, 0x68, 0x79, 0x63, 0xa5,
+    0x60, 0x62, 0x8b, 0xf2, 0xde, 0xe2, 0x77, 0x6a, 0x08, 0x56, 0xc8, 0x7d, 0x27, 0xca, 0xc1, 0x29,
+    0x36, 0xc8, 0x0a, 0xb4, 0x77, 0x8c, 0x8e, 0xab, 0x62, 0x47, 0x86, 0xdb, 0xca, 0xe0, 0x96, 0x34,
+    0x5e, 0x1f, 0x8c, 0xd7, 0xe4, 0x88, 0x49, 0xd9, 0xeb, 0xa8, 0x95, 0xc5, 0x6a, 0x56, 0x80, 0x53,
+    0x1b, 0xac, 0xb6, 0x84, 0xbb, 0xce, 0x07, 0x96, 0xc2, 0x92, 0x5b, 0x43, 0x1b, 0xb0, 0xa9, 0x8a,
+    0xb2, 0x19, 0x20, 0x26, 0x3a, 0xc6, 0xf7, 0xdb, 0x6a, 0xd1, 0x98, 0xe9, 0xbc, 0x9e, 0xd7, 0xd3,
+    0xb7, 0xcd, 0x6d, 0xad, 0x71, 0x5a, 0x40, 0x40, 0x5b, 0x45, 0xde, 0x5b, 0x8c, 0x2d, 0x62, 0xaa,
+    0xad, 0xbd, 0xd9, 0x4b, 0x61, 0x68, 0x0b, 0xda, 0xaa, 0x18, 0xab, 0xcc, 0x43, 0x91, 0xc3, 0x20,
+    0x45, 0x3b, 0x7b, 0x4e, 0x38, 0x79, 0x46, 0xa9, 0x9d, 0x72, 0x98, 0x46, 0x6b, 0xe7, 0x72, 0xc5,
+    0x8a, 0xfb, 0x98, 0xe2, 0xf3, 0x21, 0x4e, 0x26, 0x61, 0x64, 0xd7, 0x38, 0xbd, 0x18, 0x5c, 0x89,
+    0x81, 0x32, 0xfb, 0x42, 0xfe, 0xfe, 0xf9, 0xe3, 0x17, 0x3c, 0xe5, 0x7f, 0x60, 0x9f, 0xc7, 0x6f,
+    0xe8, 0x4b, 0x1f, 0x50, 0x94, 0xa9, 0x42, 0xfe, 0xf5, 0xfd, 0x17, 0xe2, 0x67, 0xba, 0x27, 0x78,
+    0x40, 0xde, 0xf9, 0xb0, 0x3e, 0x02, 0xd7, 0x3d, 0xb3, 0x77, 0xe0, 0x9d, 0xb6, 0xa4, 0xd7, 0x55,
+    0x12, 0xcb, 0x9d, 0x12, 0x2e, 0xaf, 0xe4, 0x2a, 0x99, 0xa2, 0x1c, 0x72, 0xce, 0x24, 0xdd, 0x31,
+    0x2e, 0x45, 0x27, 0x1f, 0x3c, 0x9c, 0x4c, 0x68, 0x7c, 0xef, 0xcc, 0x04, 0x96, 0xb9, 0x11, 0x5c,
+    0xe4, 0xd2, 0x33, 0xd6, 0x45, 0x66, 0x1b, 0x51, 0x05, 0xdd, 0xa6, 0xb4, 0x00, 0x6a, 0xab, 0xc8,
+    0xaa, 0xda, 0x22, 0x1c, 0x28, 0x9d, 0x5a, 0x4c, 0x44, 0xd9, 0xfd, 0x7f, 0x8a, 0xa5, 0x77, 0x0e,
+    0x35, 0x0f, 0xfc, 0x53, 0xb7, 0x4d, 0x62, 0x1f, 0xfb, 0x7a, 0x43, 0xe9, 0x0e, 0xf4, 0x10, 0xfb,
+    0xe4, 0x73, 0xdf, 0xcb, 0xab, 0xbb, 0xa4, 0x1b, 0xf7, 0xc1, 0x41, 0xa3, 0x6c, 0xc4, 0xbb, 0x22,
+    0x53, 0x16, 0x09, 0x38, 0x75, 0x5a, 0xad, 0x3e, 0x7e, 0x78, 0x27, 0xca, 0xc1, 0x10, 0x75, 0x90,
+    0x20, 0xc8, 0x75, 0x3d, 0x1f, 0xd6, 0x10, 0xc9, 0xa4, 0xca, 0x6f, 0x3d, 0x05, 0x34, 0xa3, 0x9a,
+    0xc7, 0x44, 0x24, 0x11, 0x35, 0x2f, 0xd5, 0x75, 0xc7, 0x38, 0xe4, 0x1b, 0x3e, 0x5b, 0x32, 0x4f,
+    0x05, 0x27, 0xf5, 0x74, 0x1f, 0xd9, 0x6f, 0x1e, 0x55, 0x48, 0xd7, 0xc8, 0x18, 0xe2, 0x71, 0x52,
+    0xc8, 0x28, 0x47, 0xa1, 0xcf, 0x03, 0x9e, 0x84, 0x2f, 0xf3, 0x94, 0x2f, 0x4a, 0xf2, 0x6c, 0x85,
+    0x01, 0x23, 0xf2, 0xf2, 0x70, 0x19, 0x69, 0x83, 0x4f, 0xd9, 0x1a, 0x75, 0x1a, 0x69, 0x1b, 0x75,
+    0xa0, 0x8e, 0x21, 0x06, 0x3d, 0x7a, 0x01, 0x5f, 0xf3, 0x03, 0x98, 0xdd, 0xde, 0xbc, 0x59, 0xa8,
+    0xd9, 0x62, 0xba, 0x30, 0xf5, 0x4d, 0x3d, 0x9f, 0x27, 0xdd, 0xca, 0x21, 0x5b, 0xfe, 0x01, 0xb7,
+    0xe3, 0x22, 0xee, 0xa3, 0x03, 0x00, 0x00,
+};
+const size_t page_classic_gz_len = sizeof(page_classic_gz);
+
+// Pre-rendered from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/minimal.html (717 bytes, gzipped: 449 bytes)
+const uint8_t page_minimal_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x65, 0x52, 0xc1, 0x6e, 0xdb, 0x30,
+    0x0c, 0xfd, 0x15, 0xce, 0x97, 0xb6, 0xc0, 0x1a, 0x2f, 0xe9, 0x82, 0x26, 0xab, 0xac, 0x1d, 0x32,
+    0x14, 0xd8, 0xa5, 0x28, 0x9a, 0x01, 0x3b, 0xcb, 0x12, 0x3d, 0x73, 0x91, 0x25, 0x4f, 0xa2, 0x9d,
+    0xe5, 0x3f, 0x76, 0xdf, 0x71, 0xbf, 0xb7, 0x4f, 0x98, 0x1c, 0x3b, 0x69, 0xd1, 0x5d, 0x04, 0x3d,
+    0xea, 0x91, 0x7c, 0x7c, 0xa2, 0x78, 0x63, 0xbc, 0xe6, 0x43, 0x8b, 0x50, 0x73, 0x63, 0xa5, 0x60,
+    0x62, 0x8b, 0xf2, 0xde, 0xe2, 0x4f, 0xaa, 0x08, 0xb6, 0xc8, 0x5d, 0x2b, 0xf2, 0x31, 0x28, 0x1a,
+    0x64, 0x05, 0xda, 0x3b, 0x46, 0xc7, 0x45, 0xb6, 0x27, 0xc3, 0x75, 0x61, 0xb0, 0x27, 0x8d, 0xd7,
+    0x47, 0xf0, 0x96, 0x1c, 0x31, 0x29, 0x7b, 0x1d, 0xb5, 0xb2, 0x58, 0xcc, 0x33, 0x70, 0xaa, 0xc1,
+    0xa2, 0x27, 0xdc, 0xb7, 0x3e, 0xb0, 0x14, 0x96, 0xdc, 0x0e, 0xea, 0x80, 0x55, 0x91, 0xe5, 0xd5,
+    0xd8, 0x62, 0xa6, 0x63, 0xfc, 0xd8, 0x17, 0x7a, 0x55, 0x95, 0xe5, 0x7a, 0xbd, 0x58, 0x63, 0xa9,
+    0xaa, 0xd5, 0xfc, 0x36, 0x83, 0x80, 0xb6, 0x88, 0x7c, 0xb0, 0x18, 0x6b, 0xc4, 0x94, 0x5b, 0x7a,
+    0x73, 0x90, 0xa2, 0x9e, 0xbf, 0xd6, 0x96, 0x22, 0xc2, 0x50, 0x0f, 0x64, 0x12, 0x5d, 0x71, 0x17,
+    0x47, 0xa8, 0xad, 0x8a, 0xb1, 0xc8, 0xc6, 0x50, 0x2a, 0xa6, 0xcc, 0x21, 0x93, 0x7f, 0x7f, 0xff,
+    0xfa, 0x03, 0x4f, 0xc3, 0x1d, 0xd8, 0x0f, 0x93, 0x54, 0xf4, 0xad, 0x0b, 0x28, 0xf2, 0x94, 0x21,
+    0xa7, 0xb3, 0xec, 0x98, 0xbd, 0x03, 0xef, 0xb4, 0x25, 0xbd, 0x2b, 0xd2, 0x28, 0xee, 0x01, 0x79,
+    0xef, 0xc3, 0x2e, 0x5e, 0x5e, 0xc9, 0x6d, 0x82, 0x22, 0x1f, 0x39, 0xe7, 0xbe, 0x6e, 0x7a, 0x97,
+    0xa2, 0x95, 0x0f, 0x1e, 0x4e, 0x10, 0x2a, 0xdf, 0x39, 0x33, 0x83, 0xcd, 0x50, 0x08, 0x2e, 0x86,
+    0x54, 0x38, 0x95, 0xba, 0x18, 0x04, 0x44, 0x54, 0x41, 0xd7, 0x89, 0x16, 0x40, 0xf5, 0x8a, 0xac,
+    0x2a, 0x2d, 0xc2, 0x57, 0xba, 0xa7, 0x73, 0x89, 0x99, 0xc8, 0xdb, 0x93, 0xb0, 0x44, 0x6b, 0x92,
+    0xac, 0xd8, 0x95, 0x0d, 0x25, 0xfb, 0x93, 0x7a, 0x87, 0x9a, 0xbf, 0xf8, 0x21, 0xe1, 0xf2, 0xea,
+    0x2e, 0xcd, 0xc8, 0x5d, 0x70, 0x50, 0x29, 0x1b, 0xf1, 0x2e, 0x93, 0xdb, 0xed, 0xe7, 0x4f, 0x1f,
+    0x40, 0x90, 0x6b, 0x3b, 0x3e, 0x9a, 0x13, 0xc9, 0x24, 0xce, 0x8f, 0x8e, 0x02, 0x9a, 0x34, 0x66,
+    0x90, 0xf0, 0x98, 0x2c, 0x4a, 0x6d, 0xcc, 0x4b, 0x5a, 0x3b, 0xc5, 0x60, 0xd8, 0x89, 0x33, 0x1a,
+    0xf9, 0xa7, 0x79, 0x75, 0x17, 0xd9, 0x37, 0x8f, 0x2a, 0xa4, 0xdf, 0x65, 0x0c, 0x71, 0x52, 0x08,
+    0x93, 0x77, 0x72, 0x33, 0x4a, 0x7b, 0xf6, 0x29, 0x1f, 0xb4, 0xff, 0x67, 0x6d, 0xc0, 0x88, 0xbc,
+    0x39, 0x7e, 0x42, 0x72, 0xf6, 0x69, 0x40, 0xcf, 0x29, 0x51, 0x07, 0x6a, 0x19, 0x62, 0xd0, 0x2f,
+    0x76, 0xe5, 0xfb, 0xb0, 0x2a, 0xf3, 0xd5, 0xcd, 0xfb, 0xa5, 0x9a, 0x2f, 0xdf, 0x2d, 0x4d, 0x79,
+    0x53, 0x2e, 0x16, 0x59, 0xaa, 0x3f, 0xb2, 0xe5, 0x3f, 0x87, 0x85, 0xae, 0x12, 0xcd, 0x02, 0x00,
+    0x00,
+};
+const size_t page_minimal_gz_len = sizeof(page_minimal_gz);
+
+// Pre-rendered from: /Users/andy/GitHub/andyshinn/flexifi/src/web/templates/modern.html (1532 bytes, gzipped: 699 bytes)
+const uint8_t page_modern_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0xc1, 0x6e, 0xd4, 0x30,
+    0x10, 0xfd, 0x15, 0x93, 0x4b, 0x41, 0x22, 0x9b, 0xdd, 0x2d, 0x95, 0xda, 0xca, 0x31, 0x82, 0x85,
+    0x95, 0x38, 0x50, 0x55, 0xdd, 0x22, 0xce, 0x8e, 0x3d, 0xbb, 0x31, 0x75, 0xec, 0x60, 0x3b, 0xbb,
+    0xcd, 0x7f, 0xf4, 0xde, 0x23, 0x1f, 0xc0, 0x1f, 0xf1, 0x05, 0x7c, 0x02, 0x76, 0x9c, 0xec, 0x46,
+    0xed, 0x22, 0xc4, 0x21, 0xd1, 0xf8, 0x79, 0xfc, 0x66, 0xc6, 0xf3, 0xc6, 0xf8, 0x05, 0xd7, 0xcc,
+    0xb5, 0x35, 0xa0, 0xd2, 0x55, 0x92, 0xe0, 0xf0, 0x47, 0x92, 0xaa, 0x4d, 0x0e, 0x8a, 0xe0, 0x0a,
+    0x1c, 0x45, 0xac, 0xa4, 0xc6, 0x82, 0xcb, 0xbf, 0xdc, 0x2e, 0xd3, 0xf3, 0x01, 0xd3, 0xca, 0x81,
+    0x72, 0x79, 0xb2, 0x13, 0xdc, 0x95, 0x39, 0x87, 0xad, 0x60, 0x90, 0x76, 0x8b, 0xd7, 0x42, 0x09,
+    0x27, 0xa8, 0x4c, 0x2d, 0xa3, 0x12, 0xf2, 0xd9, 0x64, 0x9a, 0x20, 0x45, 0x2b, 0xc8, 0xb7, 0x02,
+    0x76, 0xb5, 0x36, 0x8e, 0x60, 0x27, 0x9c, 0x04, 0xb2, 0x94, 0x70, 0x2f, 0xd6, 0x02, 0xad, 0xc0,
+    0x35, 0x35, 0xce, 0x22, 0x88, 0xa5, 0x50, 0x77, 0xa8, 0x34, 0xb0, 0xce, 0x93, 0x6c, 0x1d, 0x3d,
+    0x26, 0xcc, 0xda, 0xb7, 0xdb, 0x7c, 0x36, 0x9b, 0x03, 0x9d, 0x72, 0xca, 0x8a, 0xe9, 0xc5, 0x7c,
+    0x7a, 0x41, 0x13, 0x64, 0x40, 0xe6, 0xd6, 0xb5, 0x12, 0x6c, 0x09, 0xe0, 0x79, 0x0b, 0xcd, 0x5b,
+    0x82, 0xb9, 0xd8, 0x22, 0x26, 0xa9, 0xb5, 0x79, 0xc8, 0x92, 0x0a, 0x05, 0x66, 0x0c, 0x96, 0x40,
+    0x79, 0x40, 0xca, 0xd9, 0xd3, 0x0c, 0x3c, 0x82, 0xeb, 0xde, 0xcb, 0x36, 0x45, 0x4c, 0x68, 0xa1,
+    0xd5, 0x5a, 0x6c, 0x1a, 0x03, 0xa8, 0xd5, 0x8d, 0x41, 0x5f, 0xc5, 0x52, 0x84, 0xea, 0x15, 0x30,
+    0x27, 0xb4, 0xc2, 0x99, 0x27, 0x1e, 0xb3, 0x5b, 0x47, 0x5d, 0x63, 0xd3, 0x9a, 0x2a, 0x90, 0x11,
+    0x17, 0xbc, 0x07, 0xc7, 0x6e, 0x49, 0x84, 0x7c, 0x05, 0x94, 0xb7, 0x09, 0xf9, 0xfd, 0xf8, 0xf0,
+    0x03, 0xdd, 0x04, 0x1b, 0x39, 0x1d, 0xe8, 0x63, 0xc8, 0x9e, 0x7d, 0xfc, 0x3f, 0x50, 0xec, 0x7c,
+    0xe6, 0xe3, 0x38, 0x11, 0x55, 0xe0, 0x76, 0xda, 0xdc, 0xd9, 0x74, 0x5f, 0xe6, 0x9c, 0xbc, 0xdb,
+    0x52, 0x21, 0x69, 0x21, 0x01, 0x5d, 0xf5, 0xbb, 0xbe, 0xd6, 0xf9, 0xf8, 0x54, 0xd1, 0x38, 0xa7,
+    0x55, 0xba, 0x31, 0xba, 0xa9, 0xfd, 0x35, 0x76, 0xab, 0x21, 0xd3, 0xc2, 0x29, 0xe4, 0xbf, 0xd4,
+    0x82, 0xcf, 0x8b, 0x53, 0xd3, 0x76, 0x2b, 0xa6, 0xab, 0x9a, 0x32, 0x97, 0x84, 0xf2, 0x2a, 0xaa,
+    0x1a, 0x2a, 0x6f, 0xf5, 0x66, 0x23, 0xe1, 0xbd, 0x53, 0xe4, 0xa3, 0xd7, 0x86, 0x41, 0x9f, 0x3b,
+    0x54, 0xb6, 0x38, 0x8b, 0x7c, 0xff, 0xcf, 0xeb, 0x05, 0xa4, 0x02, 0x1f, 0xb6, 0xbe, 0xcc, 0x11,
+    0x70, 0x0b, 0xf7, 0x8e, 0xac, 0xbc, 0x8d, 0xb3, 0xb0, 0x43, 0x50, 0x74, 0xe8, 0x1b, 0x50, 0x0b,
+    0xdf, 0x1c, 0x33, 0xb8, 0xaf, 0xfa, 0x65, 0x27, 0x93, 0x9c, 0x0b, 0x5b, 0x4b, 0xda, 0x5e, 0x2a,
+    0xad, 0x80, 0xfc, 0x7a, 0xfc, 0xd9, 0x13, 0xfc, 0x2b, 0x45, 0xee, 0xe7, 0xc1, 0x73, 0x3c, 0xcd,
+    0xcf, 0x80, 0x1f, 0x8b, 0x90, 0xe0, 0x4d, 0x30, 0xd0, 0xa0, 0x14, 0x1a, 0x85, 0x31, 0x50, 0x1e,
+    0xef, 0xde, 0xd0, 0xa7, 0xc0, 0x33, 0xd8, 0x5e, 0x7d, 0xe4, 0x4a, 0xa3, 0xfd, 0xd6, 0x5a, 0x37,
+    0x8a, 0x4f, 0xd0, 0x42, 0x0a, 0x76, 0x87, 0x4e, 0x42, 0xc1, 0xfb, 0x06, 0x9e, 0x04, 0x9d, 0x58,
+    0xa0, 0x86, 0x95, 0xde, 0xcd, 0x20, 0xba, 0x6f, 0x71, 0x27, 0xd0, 0x81, 0x62, 0x82, 0xb3, 0xfa,
+    0x6f, 0x19, 0xf4, 0x22, 0x7e, 0x2e, 0xa1, 0xd8, 0xce, 0xd4, 0xd3, 0x56, 0x87, 0xee, 0x2e, 0xa2,
+    0xf7, 0x32, 0x80, 0x47, 0xee, 0x12, 0x97, 0xa7, 0x24, 0x36, 0x1c, 0x2d, 0x46, 0xc3, 0xe1, 0x51,
+    0x3c, 0xf0, 0xb0, 0x03, 0xc3, 0x38, 0x5a, 0xd8, 0x1e, 0x84, 0xe7, 0x2b, 0x00, 0x19, 0xea, 0xc9,
+    0xad, 0x15, 0x9c, 0xf4, 0xc5, 0xa2, 0x2b, 0xff, 0x7a, 0xa0, 0x97, 0xab, 0xd5, 0xa7, 0x0f, 0xaf,
+    0x2e, 0x71, 0xd6, 0x39, 0x11, 0x2c, 0x54, 0xdd, 0xb8, 0xae, 0xcb, 0xde, 0x35, 0x3e, 0x30, 0x9d,
+    0x65, 0xe0, 0x7b, 0x23, 0x0c, 0xf0, 0xe7, 0x05, 0x1f, 0x8f, 0x54, 0xfb, 0x2d, 0x1f, 0x85, 0x93,
+    0xeb, 0xde, 0x38, 0x12, 0x62, 0xf0, 0x89, 0x61, 0xf6, 0xab, 0xf0, 0x6c, 0x1e, 0xce, 0xc7, 0x78,
+    0x68, 0x98, 0x79, 0xd6, 0x58, 0xa7, 0xab, 0x6b, 0x6a, 0xfc, 0x11, 0x3f, 0x0e, 0x76, 0xbf, 0x7f,
+    0x5c, 0x62, 0xb5, 0x11, 0xd5, 0xd3, 0x19, 0x20, 0xfd, 0x55, 0x8e, 0xb4, 0xb4, 0xee, 0x6e, 0xef,
+    0xf9, 0xb3, 0x60, 0x99, 0x11, 0xb5, 0x43, 0xd6, 0xb0, 0xd1, 0xb3, 0xf9, 0xad, 0x7b, 0x35, 0xcf,
+    0x4f, 0xdf, 0x9c, 0xd1, 0xd9, 0xd9, 0xf4, 0x8c, 0x17, 0xa7, 0xc5, 0x7c, 0x9e, 0xf8, 0x23, 0xd1,
+    0x9b, 0xfc, 0x01, 0xa8, 0x85, 0x1e, 0xba, 0xfc, 0x05, 0x00, 0x00,
+};
+const size_t page_modern_gz_len = sizeof(page_modern_gz);
+#endif // FLEXIFI_DISABLE_PRERENDERED
 
     // Asset lookup functions
     const char* getTemplate(const char* name);
@@ -519,9 +627,54 @@ const size_t js_portal_len = sizeof(js_portal) - 1;
     
     // Asset size functions
     size_t getTemplateSize(const char* name);
+
+    // Build-time segment tables for the built-in templates
+    const TemplateSegment* getTemplateSegments(const char* name);
+    size_t getTemplateSegmentCount(const char* name);
     size_t getCSSSize(const char* name);
     size_t getJSSize(const char* name);
 
+    // Cacheable variants of CSS and JS (gzip data and content-hash ETag)
+    const uint8_t* getCSSGzip(const char* name);
+    size_t getCSSGzipSize(const char* name);
+    const char* getCSSETag(const char* name);
+    const uint8_t* getJSGzip(const char* name);
+    size_t getJSGzipSize(const char* name);
+    const char* getJSETag(const char* name);
+
+    // Pre-rendered page lookup (nullptr/0 when unavailable or disabled)
+    const uint8_t* getPage(const char* name);
+    size_t getPageSize(const char* name);
+
+    // Embedded file, found by its path under src/web ("css/modern.css").
+    // Pre-rendered pages are "pages/<template>.html" and only have gzip data.
+    struct Asset {
+        const char* path;                   // nullptr for an empty slot
+        const char* data;                   // nullptr if there is no uncompressed variant
+        size_t length;
+        const uint8_t* gzip;                // nullptr if there is no compressed variant
+        size_t gzipLength;
+        const char* etag;                   // Set for assets served on their own route
+        const char* mimeType;
+        const TemplateSegment* segments;    // Templates only
+        size_t segmentCount;
+    };
+
+    // Perfect hash over the asset paths, chosen at build time: every path has
+    // its own slot, so a lookup is one hash and one string compare
+    constexpr uint32_t ASSET_HASH_SEED = 2166136287u;
+    constexpr size_t ASSET_TABLE_SIZE = 16;
+    constexpr uint32_t assetHash(const char* text, uint32_t hash = ASSET_HASH_SEED) {
+        return *text ? assetHash(text + 1, (hash ^ (uint8_t)*text) * 16777619u) : hash;
+    }
+    constexpr size_t assetSlot(uint32_t hash) {
+        // Fold the high half in: the low bits of FNV-1a barely depend on the seed
+        return (hash ^ (hash >> 16)) & (ASSET_TABLE_SIZE - 1);
+    }
+
+    const Asset* findAsset(const char* path);   // nullptr if nothing is embedded at path
+    const Asset* findAsset(const char* directory, const char* name, const char* extension);
+
 } // namespace FlexifiAssets
 
 #endif // FLEXIFI_WEB_ASSETS_H
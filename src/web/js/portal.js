@@ -204,6 +204,9 @@ function connectToWiFi() {
             setTimeout(() => {
                 window.location.href = '/';
             }, 3000);
+        } else if (data.errors) {
+            showParameterErrors(data.errors);
+            updateStatus('failed', data.message);
         } else {
             updateStatus('failed', 'Connection failed: ' + data.message);
         }
@@ -391,6 +394,9 @@ document.addEventListener('DOMContentLoaded', function() {
         resetBtn.addEventListener('click', resetConfig);
     }
     
+    // Render custom parameters from the schema endpoint
+    loadParameterSchema();
+    
     // Load initial networks from server-side scan (if available)
     loadInitialNetworks();
     
@@ -462,4 +468,166 @@ function loadInitialNetworks() {
                 updateStatus('ready', 'Click "Scan Networks" to find WiFi networks');
             }
         });
-}
\ No newline at end of file
+}
+
+const SCHEMA_CACHE_KEY = 'flexifiParameterSchema';
+
+// Keep only what is needed to draw the form; password values never leave memory
+function cacheableSchema(schema) {
+    return {
+        parameters: (schema.parameters || []).map(param => {
+            if (param.type !== 'password') {
+                return param;
+            }
+            const copy = Object.assign({}, param);
+            delete copy.value;
+            return copy;
+        })
+    };
+}
+
+function loadParameterSchema() {
+    const container = document.getElementById('customParameters');
+    if (!container) {
+        return; // Custom template with server-rendered {{CUSTOM_PARAMETERS}}
+    }
+    
+    let cached = null;
+    try {
+        cached = JSON.parse(sessionStorage.getItem(SCHEMA_CACHE_KEY));
+    } catch (e) {
+        cached = null;
+    }
+    
+    // Show the cached form immediately; the HTTP cache revalidates the full
+    // schema against its ETag, so an unchanged schema is a 304 on the wire
+    if (cached && cached.parameters) {
+        renderParameters(container, cached);
+    }
+    
+    fetch('/params/schema', {cache: 'no-cache'})
+        .then(response => {
+            if (!response.ok) {
+                throw new Error('HTTP ' + response.status);
+            }
+            return response.json();
+        })
+        .then(schema => {
+            console.log('📋 Parameter schema received:', schema);
+            renderParameters(container, schema);
+            try {
+                sessionStorage.setItem(SCHEMA_CACHE_KEY, JSON.stringify(cacheableSchema(schema)));
+            } catch (e) {
+                console.log('⚠️ Could not cache parameter schema:', e);
+            }
+        })
+        .catch(error => console.log('❌ Error loading parameter schema:', error));
+}
+
+function renderParameters(container, schema) {
+    container.innerHTML = '';
+    
+    (schema.parameters || []).forEach(param => {
+        if (param.html) {
+            // Custom HTML is supplied by the firmware and inserted as-is
+            container.insertAdjacentHTML('beforeend', param.html);
+            return;
+        }
+        
+        const group = document.createElement('div');
+        group.className = 'form-group';
+        
+        const label = document.createElement('label');
+        label.htmlFor = param.id;
+        label.textContent = param.label;
+        if (param.required) {
+            const marker = document.createElement('span');
+            marker.className = 'required';
+            marker.textContent = '*';
+            label.append(' ', marker);
+        }
+        group.appendChild(label);
+        
+        const input = createParameterInput(param);
+        group.appendChild(input);
+        if (param.type === 'checkbox') {
+            group.append(' ' + param.label);
+        }
+        
+        container.appendChild(group);
+    });
+}
+
+function createParameterInput(param) {
+    let input;
+    
+    if (param.type === 'select') {
+        input = document.createElement('select');
+        if (!param.required) {
+            input.add(new Option('-- Select --', ''));
+        }
+        (param.options || []).forEach(option => {
+            input.add(new Option(option, option, false, option === param.value));
+        });
+    } else if (param.type === 'textarea') {
+        input = document.createElement('textarea');
+        input.rows = 3;
+        input.value = param.value;
+    } else if (param.type === 'checkbox') {
+        input = document.createElement('input');
+        input.type = 'checkbox';
+        input.value = '1';
+        input.checked = param.value === true;
+    } else {
+        input = document.createElement('input');
+        input.type = param.type;
+        input.value = param.value;
+    }
+    
+    input.id = param.id;
+    input.name = param.id;
+    
+    if (param.type !== 'select' && param.type !== 'checkbox') {
+        if (param.maxLength) {
+            input.maxLength = param.maxLength;
+        }
+        if (param.placeholder) {
+            input.placeholder = param.placeholder;
+        }
+        if (param.pattern) {
+            input.pattern = param.pattern;
+        }
+        if (param.min !== undefined && param.type === 'number') {
+            input.min = param.min;
+            input.max = param.max;
+            input.step = 'any';
+        }
+    }
+    if (param.required && param.type !== 'checkbox') {
+        input.required = true;
+    }
+    
+    return input;
+}
+
+function showParameterErrors(errors) {
+    // Mark each rejected field; the message clears as soon as the user edits it
+    let first = null;
+    Object.keys(errors).forEach(id => {
+        const field = document.getElementById(id);
+        if (!field || !field.setCustomValidity) {
+            return;
+        }
+        field.setCustomValidity(errors[id]);
+        field.addEventListener('input', () => field.setCustomValidity(''), {once: true});
+        first = first || field;
+    });
+    
+    if (first) {
+        const manualForm = document.getElementById('manualConnectForm');
+        if (manualForm && manualForm.style.display === 'none') {
+            showManualForm();
+        }
+        first.reportValidity();
+    }
+}
@@ -110,6 +110,11 @@ void setup() {
         setNeoPixelColor(COLOR_PORTAL_ACTIVE);
     });
 
+    portal.onPortalFailed([]() {
+        ESP_LOGE(TAG, "❌ Captive portal access point failed to start");
+        setNeoPixelColor(COLOR_ERROR);
+    });
+
     portal.onWiFiConnect([](const String& ssid) {
         ESP_LOGI(TAG, "✅ Connected to WiFi: %s", ssid.c_str());
         ESP_LOGI(TAG, "🌐 IP Address: %s", WiFi.localIP().toString().c_str());
@@ -162,16 +167,13 @@ void setup() {
         ESP_LOGI(TAG, "📭 No WiFi profiles found, starting captive portal...");
 
         if (portal.startPortal("Flexifi Test")) { // No password - will use generated one
-            ESP_LOGI(TAG, "✅ Captive portal started successfully");
+            // The AP comes up from portal.loop(); onPortalStart or onPortalFailed reports the outcome,
+            // and the portal runs its first scan itself once the AP is up
+            ESP_LOGI(TAG, "⏳ Captive portal starting");
             ESP_LOGI(TAG, "📶 SSID: Flexifi Test");
             ESP_LOGI(TAG, "🔐 Password: %s", portal.getGeneratedPassword().c_str());
             ESP_LOGI(TAG, "🌐 Portal URL: http://192.168.4.1");
-
-            // Start initial WiFi scan immediately
-            ESP_LOGI(TAG, "🔍 Starting initial WiFi scan...");
-            setNeoPixelColor(COLOR_SCANNING);
-            bool scanStarted = portal.scanNetworks(true); // Bypass throttle for initial scan
-            ESP_LOGI(TAG, "🔍 Initial scan result: %s", scanStarted ? "SUCCESS" : "FAILED");
+            setNeoPixelColor(COLOR_PORTAL_STARTING);
         } else {
             ESP_LOGE(TAG, "❌ Failed to start captive portal");
         }
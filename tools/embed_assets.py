@@ -6,17 +6,100 @@ This script converts web assets (HTML, CSS, JS) into C++ header files
 for compile-time embedding in the Flexifi library.
 
 Usage:
-    python3 tools/embed_assets.py
+    python3 tools/embed_assets.py [--force]
 
 Generated files:
+    src/generated/web_asset_types.h - Template variable IDs and segment layout only
     src/generated/web_assets.h - Contains all embedded assets
+    src/generated/web_assets.cpp - Asset table and lookup functions
 """
 
+import gzip
+import hashlib
 import os
 import sys
 import re
 from pathlib import Path
 
+# Values TemplateManager substitutes for built-in templates. Pre-rendered
+# pages bake these in; keep them in sync with TemplateManager::_writeVariable().
+PAGE_VARIABLES = {
+    '{{TITLE}}': 'Flexifi Setup',
+    '{{NETWORKS}}': "<p>No networks found. Click 'Scan Networks' to search for available WiFi networks.</p>",
+    '{{STATUS}}': '<div class="status ready">🔧 Ready to configure</div>',
+    '{{CUSTOM_PARAMETERS}}': '',
+    '{{VERSION}}': '1.0.0',
+    '{{DEVICE_NAME}}': 'Flexifi Device',
+}
+
+# Placeholders understood by TemplateManager, in TemplateVariable order.
+# Built-in templates are compiled into segment tables at build time so
+# rendering never has to search for "{{".
+TEMPLATE_VARIABLES = [
+    ('TITLE', 'VAR_TITLE'),
+    ('NETWORKS', 'VAR_NETWORKS'),
+    ('STATUS', 'VAR_STATUS'),
+    ('CUSTOM_PARAMETERS', 'VAR_CUSTOM_PARAMETERS'),
+    ('VERSION', 'VAR_VERSION'),
+    ('DEVICE_NAME', 'VAR_DEVICE_NAME'),
+    ('CSS', 'VAR_CSS'),
+    ('CSS_URL', 'VAR_CSS_URL'),
+    ('JS', 'VAR_JS'),
+    ('JS_URL', 'VAR_JS_URL'),
+    ('PARAMETERS', 'VAR_PARAMETERS'),
+    # Fields of the current {{#each NETWORKS}} item
+    ('SSID', 'VAR_SSID'),
+    ('RSSI', 'VAR_RSSI'),
+    ('CHANNEL', 'VAR_CHANNEL'),
+    ('SECURE', 'VAR_SECURE'),
+    ('SIGNAL', 'VAR_SIGNAL'),
+    # Fields of the current {{#each PARAMETERS}} item
+    ('ID', 'VAR_ID'),
+    ('LABEL', 'VAR_LABEL'),
+    ('VALUE', 'VAR_VALUE'),
+    ('PARAMETER', 'VAR_PARAMETER'),
+]
+# Collections {{#each}} can iterate
+TEMPLATE_COLLECTIONS = {'NETWORKS', 'PARAMETERS'}
+TEMPLATE_MAX_LOOP_DEPTH = 2   # Keep in sync with TemplateStream::MAX_LOOP_DEPTH
+# {{NAME}}, {{#if NAME}}, {{#each NAME}}, {{else}}, {{/if}}, {{/each}}
+PLACEHOLDER_PATTERN = re.compile(rb'\{\{(?:(#if|#each) ([A-Za-z0-9_]+)|(else|/if|/each)|([A-Za-z0-9_]+))\}\}')
+
+# Debug logging removed from JavaScript at build time; console.warn and
+# console.error stay so failures can still be diagnosed in the browser
+JS_STRIPPED_CALLS = {'console.log', 'console.debug', 'console.info'}
+# After these keywords a '/' starts a regular expression, not a division
+JS_REGEX_KEYWORDS = {'return', 'typeof', 'instanceof', 'in', 'of', 'new', 'delete',
+                     'void', 'throw', 'case', 'do', 'else', 'yield', 'await'}
+JS_WHITESPACE = ' \t\r\n\f\v\u00a0\ufeff\u2028\u2029'
+
+# Flash budgets in bytes. Exceeding one fails embed_assets.py (and so the
+# build) before anything is written; raise a budget in the change that needs it.
+SIZE_BUDGETS = {
+    'portal.js': {'minified': 13312, 'gzip': 4096},
+    'modern.css': {'minified': 5120, 'gzip': 1536},
+    'classic.css': {'minified': 1024, 'gzip': 512},
+    'minimal.css': {'minified': 512, 'gzip': 256},
+    'modern.html': {'minified': 1536, 'page': 1792, 'gzip': 768},
+    'classic.html': {'minified': 1024, 'page': 1024, 'gzip': 640},
+    'minimal.html': {'minified': 768, 'page': 768, 'gzip': 512},
+}
+
+# Content types for the asset table, by file extension
+ASSET_MIME_TYPES = {
+    '.html': 'text/html',
+    '.css': 'text/css',
+    '.js': 'application/javascript',
+}
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+class BudgetExceeded(Exception):
+    """An asset grew past its entry in SIZE_BUDGETS"""
+
+# Sizes collected while embedding: name -> {'source': ..., 'minified': ..., ...}
+size_report = {}
+
 try:
     import minify_html
     MINIFY_AVAILABLE = True
@@ -36,6 +119,13 @@ def sanitize_var_name(name):
 
 def minify_content(content, file_extension):
     """Minify content based on file type"""
+    if file_extension == '.js':
+        try:
+            return minify_js(content)
+        except ValueError as e:
+            print(f"⚠️ JS minification failed, embedding as-is: {e}")
+            return content
+
     if not MINIFY_AVAILABLE:
         return content
     
@@ -55,16 +145,202 @@ def minify_content(content, file_extension):
             import re
             match = re.search(r'<style>(.*?)</style>', minified_wrapped, re.DOTALL)
             return match.group(1) if match else content
-        elif file_extension == '.js':
-            # Skip JS minification for now due to compatibility issues
-            # The minify-html JS minifier has issues with certain JS patterns
-            return content
         else:
             return content
     except Exception as e:
         print(f"⚠️ Minification failed for {file_extension}: {e}")
         return content
 
+def js_is_word(c):
+    """Character that can be part of an identifier, keyword or number"""
+    return c.isalnum() or c in '_$\\' or ord(c) > 127
+
+def js_template_end(source, i):
+    """Index just past the template literal starting at source[i]"""
+    j = i + 1
+    while j < len(source):
+        if source[j] == '\\':
+            j += 2
+        elif source[j] == '`':
+            return j + 1
+        elif source.startswith('${', j):
+            # Substitution: skip to its closing brace, minding nested literals
+            j += 2
+            depth = 1
+            while depth:
+                if j >= len(source):
+                    break
+                c = source[j]
+                if c in '\'"':
+                    j = js_string_end(source, j)
+                    continue
+                if c == '`':
+                    j = js_template_end(source, j)
+                    continue
+                depth += {'{': 1, '}': -1}.get(c, 0)
+                j += 1
+        else:
+            j += 1
+    raise ValueError('unterminated template literal')
+
+def js_string_end(source, i):
+    """Index just past the string literal starting at source[i]"""
+    j = i + 1
+    while j < len(source) and source[j] != source[i]:
+        if source[j] == '\\':
+            j += 1
+        elif source[j] == '\n':
+            break
+        j += 1
+    if j >= len(source) or source[j] != source[i]:
+        raise ValueError(f'unterminated string at offset {i}')
+    return j + 1
+
+def js_regex_end(source, i):
+    """Index just past the regular expression literal (and flags) at source[i]"""
+    j = i + 1
+    in_class = False
+    while j < len(source):
+        c = source[j]
+        if c == '\\':
+            j += 2
+            continue
+        if c == '\n':
+            break
+        if c == '[':
+            in_class = True
+        elif c == ']':
+            in_class = False
+        elif c == '/' and not in_class:
+            j += 1
+            while j < len(source) and js_is_word(source[j]):
+                j += 1
+            return j
+        j += 1
+    raise ValueError(f'unterminated regular expression at offset {i}')
+
+def js_tokens(source):
+    """Split JavaScript into (kind, text) tokens: 'space', 'word', 'literal' or 'punct'.
+    Comments become whitespace; literals are kept verbatim."""
+    tokens = []
+    last = None   # Last significant token, to tell a regex from a division
+    i = 0
+    while i < len(source):
+        c = source[i]
+        if c in JS_WHITESPACE:
+            j = i
+            while j < len(source) and source[j] in JS_WHITESPACE:
+                j += 1
+            tokens.append(('space', source[i:j]))
+            i = j
+            continue
+        if source.startswith('//', i):
+            j = source.find('\n', i)
+            i = len(source) if j < 0 else j
+            tokens.append(('space', ' '))
+            continue
+        if source.startswith('/*', i):
+            j = source.find('*/', i + 2)
+            if j < 0:
+                raise ValueError(f'unterminated comment at offset {i}')
+            tokens.append(('space', '\n' if '\n' in source[i:j] else ' '))
+            i = j + 2
+            continue
+
+        if c in '\'"':
+            j = js_string_end(source, i)
+            kind = 'literal'
+        elif c == '`':
+            j = js_template_end(source, i)
+            kind = 'literal'
+        elif c == '/' and (last is None or
+                           (last[0] == 'punct' and last[1] not in ')]}') or
+                           (last[0] == 'word' and last[1] in JS_REGEX_KEYWORDS)):
+            j = js_regex_end(source, i)
+            kind = 'literal'
+        elif js_is_word(c):
+            j = i
+            while j < len(source) and js_is_word(source[j]):
+                j += 1
+            kind = 'word'
+        else:
+            j = i + 1
+            kind = 'punct'
+        last = (kind, source[i:j])
+        tokens.append(last)
+        i = j
+    return tokens
+
+def js_strip_calls(tokens):
+    """Remove JS_STRIPPED_CALLS. A call that is a whole statement disappears;
+    one used as an expression (e.g. an arrow function body) becomes `void 0`."""
+    def significant(index, step):
+        while 0 <= index < len(tokens) and tokens[index][0] == 'space':
+            index += step
+        return index if 0 <= index < len(tokens) else None
+
+    result = []
+    i = 0
+    while i < len(tokens):
+        # console . log (
+        names = [i]
+        for _ in range(3):
+            names.append(significant(names[-1] + 1, 1) if names[-1] is not None else None)
+        if (None in names or tokens[i][0] != 'word' or tokens[names[1]][1] != '.' or
+                tokens[names[3]][1] != '(' or
+                f'{tokens[i][1]}.{tokens[names[2]][1]}' not in JS_STRIPPED_CALLS):
+            result.append(tokens[i])
+            i += 1
+            continue
+
+        # Find the closing parenthesis; literals are single tokens
+        end = names[3]
+        depth = 0
+        while end < len(tokens):
+            if tokens[end][0] == 'punct':
+                depth += {'(': 1, ')': -1}.get(tokens[end][1], 0)
+                if depth == 0:
+                    break
+            end += 1
+        if end >= len(tokens):
+            raise ValueError(f'unbalanced {tokens[i][1]}.{tokens[names[2]][1]}() call')
+
+        before = next((t for t in reversed(result) if t[0] != 'space'), None)
+        after = significant(end + 1, 1)
+        statement = before is None or before[1] in (';', '{', '}')
+        if statement and after is not None and tokens[after][1] == ';':
+            i = after + 1
+        elif statement and (after is None or tokens[after][1] == '}' or
+                            any('\n' in t[1] for t in tokens[end + 1:after] if t[0] == 'space')):
+            i = end + 1
+        else:
+            result += [('word', 'void'), ('space', ' '), ('word', '0')]
+            i = end + 1
+    return result
+
+def minify_js(content):
+    """Strip debug logging, comments and whitespace from JavaScript.
+    Line breaks are kept wherever automatic semicolon insertion might need them."""
+    tokens = js_strip_calls(js_tokens(content))
+    out = []
+    pending = None   # Whitespace seen since the last significant token
+    for kind, text in tokens:
+        if kind == 'space':
+            pending = '\n' if '\n' in text or (pending == '\n') else ' '
+            continue
+        if out and pending:
+            prev, nxt = out[-1][-1], text[0]
+            if (pending == '\n' and
+                    (js_is_word(prev) or prev in ')]}\'"`+-') and
+                    (js_is_word(nxt) or nxt in '{[(\'"`+-!~/')):
+                out.append('\n')
+            elif ((js_is_word(prev) and js_is_word(nxt)) or (prev in '+-' and nxt == prev) or
+                  (out[-1][0].isdigit() and nxt == '.')):   # a + +b, 1 .toString()
+                out.append(' ')
+        out.append(text)
+        pending = None
+    return ''.join(out)
+
 def escape_for_raw_string(content):
     """Escape content for C++ raw string literal"""
     # Raw strings can't contain the sequence )"
@@ -92,7 +368,11 @@ def read_file(filepath):
             # Convert binary to escaped string
             return ''.join(f'\\x{b:02x}' for b in content)
 
-def embed_file(filepath, var_name):
+def asset_etag(data):
+    """Content hash used as the ETag and as the ?v= cache-busting query"""
+    return hashlib.sha1(data).hexdigest()[:16]
+
+def embed_file(filepath, var_name, cacheable=False):
     """Embed a single file as a C++ constant"""
     content = read_file(filepath)
     file_extension = filepath.suffix.lower()
@@ -110,14 +390,281 @@ def embed_file(filepath, var_name):
         percentage = (savings / original_size) * 100
         print(f"✂️  Minified {filepath.name}: {original_size} → {minified_size} bytes ({savings} bytes saved, {percentage:.1f}%)")
     
+    sizes = size_report.setdefault(filepath.name, {})
+    sizes['source'] = len(content.encode('utf-8'))
+    sizes['minified'] = len(minified_content.encode('utf-8'))
+
     escaped_content = escape_for_raw_string(minified_content)
     
-    return f"""
+    embedded = f"""
 // Generated from: {filepath} (minified: {minified_size} bytes)
 const char {var_name}[] PROGMEM = {escaped_content}
 const size_t {var_name}_len = sizeof({var_name}) - 1;
 """
 
+    if cacheable:
+        # Served as its own route: add a content-hash ETag and a gzip variant
+        data = minified_content.encode('utf-8')
+        etag = asset_etag(data)
+        compressed = gzip.compress(data, compresslevel=9, mtime=0)
+        print(f"🗜️  Compressed {filepath.name}: {len(data)} → {len(compressed)} bytes gzipped (ETag {etag})")
+        sizes['gzip'] = len(compressed)
+        embedded += f"""const char {var_name}_etag[] = "{etag}";
+const uint8_t {var_name}_gz[] PROGMEM = {{
+{format_bytes(compressed)}
+}};
+const size_t {var_name}_gz_len = sizeof({var_name}_gz);
+"""
+
+    return embedded
+
+def template_variables(css_dir):
+    """Placeholder name -> TemplateVariable enumerator, in enum order"""
+    variables = list(TEMPLATE_VARIABLES)
+    # {{CSS_<NAME>}} names one embedded stylesheet explicitly
+    if css_dir.exists():
+        for css_file in sorted(css_dir.glob('*.css')):
+            name = sanitize_var_name(css_file.name).upper()
+            variables.append((f'CSS_{name}', f'VAR_CSS_{name}'))
+    return variables
+
+def tokenize_template(content, template_name, variables):
+    """Compile a template into (offset, length, variable, op, jump) segments.
+
+    Each segment is a literal run of the template followed by one
+    instruction: emit a placeholder (VAR_NONE for none) or a control op for
+    {{#if}}/{{else}}/{{#each}}/{{/each}}. Jumps are segment indexes.
+    Offsets and lengths are in bytes.
+    """
+    data = content.encode('utf-8')
+    lookup = dict(variables)
+    lookup['JS_PORTAL'] = 'VAR_JS'   # Alias kept for older templates
+
+    segments = []
+    blocks = []    # (kind, index of the opening segment, index of {{else}} or None)
+    start = 0
+
+    def add(end, variable, op='OP_EMIT', jump=0):
+        # Lengths are 16-bit; split any longer literal run
+        offset = start
+        length = end - start
+        while length > 0xFFFF:
+            segments.append([offset, 0xFFFF, 'VAR_NONE', 'OP_EMIT', 0])
+            offset += 0xFFFF
+            length -= 0xFFFF
+        segments.append([offset, length, variable, op, jump])
+        return len(segments) - 1
+
+    def fail(match, message):
+        line = data.count(b'\n', 0, match.start()) + 1
+        raise ValueError(f"{template_name} template, line {line}: {message}")
+
+    for match in PLACEHOLDER_PATTERN.finditer(data):
+        opener, subject, closer, name = (g.decode('ascii') if g else None for g in match.groups())
+
+        if name is not None:
+            if name not in lookup:
+                # Left in the literal text, as the runtime does for unknown names
+                print(f"⚠️ Unknown placeholder {{{{{name}}}}} in {template_name} template, kept as text")
+                continue
+            add(match.start(), lookup[name])
+        elif opener == '#if':
+            if subject not in lookup:
+                fail(match, f"unknown variable in {{{{#if {subject}}}}}")
+            blocks.append(['if', add(match.start(), lookup[subject], 'OP_IF'), None])
+        elif opener == '#each':
+            if subject not in TEMPLATE_COLLECTIONS:
+                fail(match, f"{{{{#each {subject}}}}} is not a collection")
+            if sum(1 for block in blocks if block[0] == 'each') >= TEMPLATE_MAX_LOOP_DEPTH:
+                fail(match, f"{{{{#each}}}} nested deeper than {TEMPLATE_MAX_LOOP_DEPTH}")
+            blocks.append(['each', add(match.start(), lookup[subject], 'OP_EACH'), None])
+        elif closer == 'else':
+            if not blocks or blocks[-1][0] != 'if' or blocks[-1][2] is not None:
+                fail(match, "{{else}} outside {{#if}}")
+            blocks[-1][2] = add(match.start(), 'VAR_NONE', 'OP_ELSE')
+            segments[blocks[-1][1]][4] = blocks[-1][2] + 1
+        elif closer == '/if':
+            if not blocks or blocks[-1][0] != 'if':
+                fail(match, "{{/if}} without {{#if}}")
+            kind, opening, otherwise = blocks.pop()
+            index = add(match.start(), 'VAR_NONE')
+            segments[otherwise if otherwise is not None else opening][4] = index + 1
+        else:  # /each
+            if not blocks or blocks[-1][0] != 'each':
+                fail(match, "{{/each}} without {{#each}}")
+            kind, opening, _ = blocks.pop()
+            index = add(match.start(), 'VAR_NONE', 'OP_END_EACH', opening + 1)
+            segments[opening][4] = index + 1
+        start = match.end()
+
+    if blocks:
+        raise ValueError(f"{template_name} template: unclosed {{{{#{blocks[-1][0]}}}}}")
+    add(len(data), 'VAR_NONE')
+    if len(segments) > 0xFFFF:
+        raise ValueError(f"{template_name} template has too many segments")
+    return segments
+
+def embed_segments(content, var_name, template_name, variables):
+    """Embed the build-time segment table for a template"""
+    segments = tokenize_template(content, template_name, variables)
+    rows = '\n'.join(f'    {{ {offset}, {length}, {variable}, {op}, {jump} }},'
+                     for offset, length, variable, op, jump in segments)
+    print(f"🧩 Tokenized {template_name}: {len(segments)} segments")
+    return f"""const TemplateSegment {var_name}_segments[] PROGMEM = {{
+{rows}
+}};
+const size_t {var_name}_segments_count = sizeof({var_name}_segments) / sizeof({var_name}_segments[0]);
+"""
+
+def segment_types(variables):
+    """web_asset_types.h: declarations shared by the segment tables and the template code.
+
+    Kept apart from web_assets.h so code that only needs variable IDs (such as
+    template data providers) does not include the header that defines the asset arrays.
+    """
+    enumerators = ',\n'.join(f'        {variable}' for _, variable in variables)
+    return f"""#ifndef FLEXIFI_WEB_ASSET_TYPES_H
+#define FLEXIFI_WEB_ASSET_TYPES_H
+
+/*
+ * Auto-generated by tools/embed_assets.py - DO NOT EDIT MANUALLY!
+ *
+ * Template variable IDs and the segment table layout. Defines no data, so it
+ * can be included anywhere; the assets themselves are in web_assets.h.
+ */
+
+#include <Arduino.h>
+
+namespace FlexifiAssets {{
+
+    // Template placeholders, resolved at build time
+    enum TemplateVariable : uint8_t {{
+        VAR_NONE = 0,     // No placeholder: literal text only
+{enumerators},
+        VAR_COUNT
+    }};
+
+    // What a segment does after its literal text
+    enum TemplateOp : uint8_t {{
+        OP_EMIT = 0,      // Write `variable`
+        OP_IF,            // Continue if `variable` is truthy, else go to `jump`
+        OP_ELSE,          // End of the true branch: go to `jump`
+        OP_EACH,          // Loop over the `variable` collection; empty goes to `jump`
+        OP_END_EACH       // Next item: back to `jump`, or fall through when done
+    }};
+
+    // Literal run of a template followed by one instruction
+    struct TemplateSegment {{
+        uint32_t offset;    // Byte offset of the literal text in the template
+        uint16_t length;    // Literal text length
+        uint8_t variable;   // TemplateVariable the instruction applies to
+        uint8_t op;         // TemplateOp
+        uint16_t jump;      // Target segment index for control ops
+    }};
+
+}} // namespace FlexifiAssets
+
+#endif // FLEXIFI_WEB_ASSET_TYPES_H
+"""
+
+def variable_names(variables):
+    """Placeholder name table, indexed by TemplateVariable"""
+    names = ', '.join(f'"{name}"' for name, _ in variables)
+    return f"""    // Placeholder names indexed by TemplateVariable
+    const char* const template_variable_names[VAR_COUNT] = {{ "", {names} }};
+
+"""
+
+def format_bytes(data, indent='    '):
+    """Format bytes as a C array initializer, 16 per line"""
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ', '.join(f'0x{b:02x}' for b in data[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+def render_page(template_file, css_dir, js_dir):
+    """Execute a built-in template's segments the way TemplateStream does at runtime"""
+    name = template_file.stem
+    html = minify_content(read_file(template_file), template_file.suffix.lower())
+    variables = template_variables(css_dir)
+    segments = tokenize_template(html, name, variables)
+
+    # Build-time values; there are no scan results or parameters yet
+    values = {variable: PAGE_VARIABLES.get('{{' + placeholder + '}}', '') for placeholder, variable in variables}
+    for css_file in sorted(css_dir.glob('*.css')) if css_dir.exists() else []:
+        css = minify_content(read_file(css_file), '.css')
+        values[f'VAR_CSS_{sanitize_var_name(css_file.name).upper()}'] = css
+        if css_file.stem == name:
+            values['VAR_CSS'] = css
+            values['VAR_CSS_URL'] = '/flexifi.css?v=' + asset_etag(css.encode('utf-8'))
+    js_file = js_dir / 'portal.js'
+    if js_file.exists():
+        js = minify_content(read_file(js_file), '.js')
+        values['VAR_JS'] = js
+        values['VAR_JS_URL'] = '/flexifi.js?v=' + asset_etag(js.encode('utf-8'))
+    values['VAR_NONE'] = ''
+
+    data = html.encode('utf-8')
+    page = []
+    index = 0
+    while index < len(segments):
+        offset, length, variable, op, jump = segments[index]
+        page.append(data[offset:offset + length].decode('utf-8'))
+        index += 1
+        if op == 'OP_EMIT':
+            page.append(values[variable])
+        elif op == 'OP_IF':
+            collection = variable in ('VAR_NETWORKS', 'VAR_PARAMETERS')
+            if collection or values[variable] in ('', '0', 'false'):
+                index = jump
+        elif op in ('OP_ELSE', 'OP_EACH'):
+            index = jump   # Every collection is empty at build time
+    return ''.join(page)
+
+def embed_page(template_file, css_dir, js_dir):
+    """Embed a fully assembled, gzip-compressed page"""
+    page = render_page(template_file, css_dir, js_dir).encode('utf-8')
+    # mtime=0 keeps the output reproducible across runs
+    compressed = gzip.compress(page, compresslevel=9, mtime=0)
+    var_name = f"page_{sanitize_var_name(template_file.name)}_gz"
+
+    print(f"🗜️  Pre-rendered {template_file.name}: {len(page)} → {len(compressed)} bytes gzipped")
+    sizes = size_report.setdefault(template_file.name, {})
+    sizes['page'] = len(page)
+    sizes['gzip'] = len(compressed)
+
+    return f"""
+// Pre-rendered from: {template_file} ({len(page)} bytes, gzipped: {len(compressed)} bytes)
+const uint8_t {var_name}[] PROGMEM = {{
+{format_bytes(compressed)}
+}};
+const size_t {var_name}_len = sizeof({var_name});
+"""
+
+def check_size_budgets():
+    """Print the size report and raise BudgetExceeded if an asset is over budget"""
+    columns = ('source', 'minified', 'page', 'gzip')
+    print(f"\n📊 {'Asset':<14}" + ''.join(f'{column:>10}' for column in columns))
+    over = []
+    for name in sorted(size_report):
+        sizes = size_report[name]
+        budget = SIZE_BUDGETS.get(name, {})
+        # HTML and CSS budgets assume minify-html; JS is always minified by this script
+        if not MINIFY_AVAILABLE and not name.endswith('.js'):
+            budget = {}
+        cells = ''
+        for column in columns:
+            cells += f'{sizes[column]:>10}' if column in sizes else f"{'-':>10}"
+            if column in sizes and column in budget and sizes[column] > budget[column]:
+                over.append(f"{name} {column}: {sizes[column]} bytes (budget {budget[column]})")
+        print(f"   {name:<14}{cells}")
+    if not MINIFY_AVAILABLE:
+        print("   HTML and CSS budgets not checked: minify-html is not installed")
+    print()
+
+    if over:
+        raise BudgetExceeded('Size budget exceeded:\n  ' + '\n  '.join(over))
+
 def generate_header():
     """Generate the header file with all embedded assets"""
     script_dir = Path(__file__).parent
@@ -141,6 +688,7 @@ def generate_header():
  */
 
 #include <Arduino.h>
+#include "web_asset_types.h"
 
 namespace FlexifiAssets {
 
@@ -148,27 +696,39 @@ namespace FlexifiAssets {
 
     # Embed HTML templates
     templates_dir = web_dir / 'templates'
+    variables = template_variables(web_dir / 'css')
+    types_content = segment_types(variables)
+    header_content += variable_names(variables)
     if templates_dir.exists():
         header_content += "    // HTML Templates\n"
-        for html_file in templates_dir.glob('*.html'):
+        for html_file in sorted(templates_dir.glob('*.html')):
             var_name = f"template_{sanitize_var_name(html_file.name)}"
             header_content += embed_file(html_file, var_name)
+            minified = minify_content(read_file(html_file), html_file.suffix.lower())
+            header_content += embed_segments(minified, var_name, html_file.stem, variables)
 
     # Embed CSS files
     css_dir = web_dir / 'css'
     if css_dir.exists():
         header_content += "\n    // CSS Stylesheets\n"
-        for css_file in css_dir.glob('*.css'):
+        for css_file in sorted(css_dir.glob('*.css')):
             var_name = f"css_{sanitize_var_name(css_file.name)}"
-            header_content += embed_file(css_file, var_name)
+            header_content += embed_file(css_file, var_name, cacheable=True)
 
     # Embed JavaScript files
     js_dir = web_dir / 'js'
     if js_dir.exists():
         header_content += "\n    // JavaScript Files\n"
-        for js_file in js_dir.glob('*.js'):
+        for js_file in sorted(js_dir.glob('*.js')):
             var_name = f"js_{sanitize_var_name(js_file.name)}"
-            header_content += embed_file(js_file, var_name)
+            header_content += embed_file(js_file, var_name, cacheable=True)
+
+    # Embed pre-rendered, gzip-compressed pages for the built-in templates
+    if templates_dir.exists():
+        header_content += "\n#ifndef FLEXIFI_DISABLE_PRERENDERED\n    // Pre-rendered Pages (gzip)\n"
+        for html_file in sorted(templates_dir.glob('*.html')):
+            header_content += embed_page(html_file, css_dir, js_dir)
+        header_content += "#endif // FLEXIFI_DISABLE_PRERENDERED\n"
 
     # Add asset lookup functions
     header_content += """
@@ -179,15 +739,41 @@ namespace FlexifiAssets {
     
     // Asset size functions
     size_t getTemplateSize(const char* name);
+
+    // Build-time segment tables for the built-in templates
+    const TemplateSegment* getTemplateSegments(const char* name);
+    size_t getTemplateSegmentCount(const char* name);
     size_t getCSSSize(const char* name);
     size_t getJSSize(const char* name);
 
+    // Cacheable variants of CSS and JS (gzip data and content-hash ETag)
+    const uint8_t* getCSSGzip(const char* name);
+    size_t getCSSGzipSize(const char* name);
+    const char* getCSSETag(const char* name);
+    const uint8_t* getJSGzip(const char* name);
+    size_t getJSGzipSize(const char* name);
+    const char* getJSETag(const char* name);
+
+    // Pre-rendered page lookup (nullptr/0 when unavailable or disabled)
+    const uint8_t* getPage(const char* name);
+    size_t getPageSize(const char* name);
+"""
+    header_content += asset_table_types(web_dir)
+    header_content += """
 } // namespace FlexifiAssets
 
 #endif // FLEXIFI_WEB_ASSETS_H
 """
 
-    # Write the header file
+    # Nothing is written unless every asset is within budget
+    check_size_budgets()
+
+    # Write the header files
+    types_file = generated_dir / 'web_asset_types.h'
+    with open(types_file, 'w', encoding='utf-8') as f:
+        f.write(types_content)
+    print(f"✅ Generated: {types_file}")
+
     header_file = generated_dir / 'web_assets.h'
     with open(header_file, 'w', encoding='utf-8') as f:
         f.write(header_content)
@@ -195,101 +781,228 @@ namespace FlexifiAssets {
     print(f"✅ Generated: {header_file}")
     return header_file
 
+def asset_hash(text, seed):
+    """FNV-1a over the UTF-8 bytes; must match FlexifiAssets::assetHash()"""
+    value = seed
+    for byte in text.encode('utf-8'):
+        value = ((value ^ byte) * FNV_PRIME) & 0xffffffff
+    return value
+
+def asset_entries(web_dir):
+    """(path, initializer, guard) for every embedded asset; paths are relative to src/web"""
+    entries = []
+    for html_file in sorted((web_dir / 'templates').glob('*.html')):
+        name = f"template_{sanitize_var_name(html_file.name)}"
+        entries.append((f"templates/{html_file.name}",
+                        f"{name}, {name}_len, nullptr, 0, nullptr, \"text/html\", "
+                        f"{name}_segments, {name}_segments_count", None))
+    for directory, prefix, pattern in (('css', 'css', '*.css'), ('js', 'js', '*.js')):
+        for asset_file in sorted((web_dir / directory).glob(pattern)):
+            name = f"{prefix}_{sanitize_var_name(asset_file.name)}"
+            mime = ASSET_MIME_TYPES[asset_file.suffix.lower()]
+            entries.append((f"{directory}/{asset_file.name}",
+                            f"{name}, {name}_len, {name}_gz, {name}_gz_len, {name}_etag, \"{mime}\", nullptr, 0",
+                            None))
+    for html_file in sorted((web_dir / 'templates').glob('*.html')):
+        name = f"page_{sanitize_var_name(html_file.name)}_gz"
+        entries.append((f"pages/{html_file.name}",
+                        f"nullptr, 0, {name}, {name}_len, nullptr, \"text/html\", nullptr, 0",
+                        'FLEXIFI_DISABLE_PRERENDERED'))
+    return entries
+
+def asset_slot(value, size):
+    """Table slot for a hash; must match FlexifiAssets::assetSlot()"""
+    return (value ^ (value >> 16)) & (size - 1)
+
+def perfect_hash(paths):
+    """Smallest power-of-two table and a seed that give every path its own slot"""
+    size = 1
+    while size < len(paths):
+        size *= 2
+    while True:
+        for seed in range(FNV_OFFSET_BASIS, FNV_OFFSET_BASIS + 100000):
+            if len({asset_slot(asset_hash(path, seed), size) for path in paths}) == len(paths):
+                return seed, size
+        size *= 2
+
+def asset_table_types(web_dir):
+    """C++ declarations for the asset table"""
+    seed, size = perfect_hash([path for path, _, _ in asset_entries(web_dir)])
+    return f"""
+    // Embedded file, found by its path under src/web ("css/modern.css").
+    // Pre-rendered pages are "pages/<template>.html" and only have gzip data.
+    struct Asset {{
+        const char* path;                   // nullptr for an empty slot
+        const char* data;                   // nullptr if there is no uncompressed variant
+        size_t length;
+        const uint8_t* gzip;                // nullptr if there is no compressed variant
+        size_t gzipLength;
+        const char* etag;                   // Set for assets served on their own route
+        const char* mimeType;
+        const TemplateSegment* segments;    // Templates only
+        size_t segmentCount;
+    }};
+
+    // Perfect hash over the asset paths, chosen at build time: every path has
+    // its own slot, so a lookup is one hash and one string compare
+    constexpr uint32_t ASSET_HASH_SEED = {seed}u;
+    constexpr size_t ASSET_TABLE_SIZE = {size};
+    constexpr uint32_t assetHash(const char* text, uint32_t hash = ASSET_HASH_SEED) {{
+        return *text ? assetHash(text + 1, (hash ^ (uint8_t)*text) * {FNV_PRIME}u) : hash;
+    }}
+    constexpr size_t assetSlot(uint32_t hash) {{
+        // Fold the high half in: the low bits of FNV-1a barely depend on the seed
+        return (hash ^ (hash >> 16)) & (ASSET_TABLE_SIZE - 1);
+    }}
+
+    const Asset* findAsset(const char* path);   // nullptr if nothing is embedded at path
+    const Asset* findAsset(const char* directory, const char* name, const char* extension);
+"""
+
 def generate_implementation():
-    """Generate the implementation file with lookup functions"""
+    """Generate the implementation file with the asset table and lookup functions"""
     script_dir = Path(__file__).parent
     project_root = script_dir.parent
     web_dir = project_root / 'src' / 'web'
     generated_dir = project_root / 'src' / 'generated'
-    
-    impl_content = """#include "web_assets.h"
-#include <string.h>
 
-namespace FlexifiAssets {
+    entries = asset_entries(web_dir)
+    seed, size = perfect_hash([path for path, _, _ in entries])
+    slots = [None] * size
+    for entry in entries:
+        slots[asset_slot(asset_hash(entry[0], seed), size)] = entry
+    print(f"🔑 Asset table: {len(entries)} assets in {size} slots (seed 0x{seed:08x})")
 
-const char* getTemplate(const char* name) {
-"""
+    rows = ''
+    for slot, entry in enumerate(slots):
+        if entry is None:
+            rows += f"    {{}},   // {slot}: empty\n"
+            continue
+        path, initializer, guard = entry
+        row = f"""    {{ "{path}", {initializer} }},   // {slot}\n"""
+        if guard:
+            row = f"#ifndef {guard}\n{row}#else\n    {{}},\n#endif\n"
+        rows += row
 
-    # Add template lookup
-    templates_dir = web_dir / 'templates'
-    if templates_dir.exists():
-        for html_file in templates_dir.glob('*.html'):
-            name = sanitize_var_name(html_file.name)
-            impl_content += f"""    if (strcmp(name, "{html_file.stem}") == 0) return template_{name};
-"""
+    impl_content = f"""#include "web_assets.h"
+#include <string.h>
 
-    impl_content += """    return nullptr;
-}
+namespace FlexifiAssets {{
 
-const char* getCSS(const char* name) {
-"""
+// Indexed by assetSlot(assetHash(path))
+constexpr Asset asset_table[ASSET_TABLE_SIZE] = {{
+{rows}}};
 
-    # Add CSS lookup
-    css_dir = web_dir / 'css'
-    if css_dir.exists():
-        for css_file in css_dir.glob('*.css'):
-            name = sanitize_var_name(css_file.name)
-            impl_content += f"""    if (strcmp(name, "{css_file.stem}") == 0) return css_{name};
-"""
+const Asset* findAsset(const char* path) {{
+    const Asset& asset = asset_table[assetSlot(assetHash(path))];
+    return asset.path && strcmp(asset.path, path) == 0 ? &asset : nullptr;
+}}
 
-    impl_content += """    return nullptr;
-}
+const Asset* findAsset(const char* directory, const char* name, const char* extension) {{
+    // Same as findAsset("<directory>/<name><extension>") without building the path
+    uint32_t hash = assetHash(extension, assetHash(name, assetHash("/", assetHash(directory))));
+    const Asset& asset = asset_table[assetSlot(hash)];
+    if (!asset.path) {{
+        return nullptr;
+    }}
 
-const char* getJS(const char* name) {
-"""
+    const char* path = asset.path;
+    size_t length = strlen(directory);
+    if (strncmp(path, directory, length) != 0 || path[length] != '/') {{
+        return nullptr;
+    }}
+    path += length + 1;
+    length = strlen(name);
+    if (strncmp(path, name, length) != 0) {{
+        return nullptr;
+    }}
+    return strcmp(path + length, extension) == 0 ? &asset : nullptr;
+}}
 
-    # Add JS lookup
-    js_dir = web_dir / 'js'
-    if js_dir.exists():
-        for js_file in js_dir.glob('*.js'):
-            name = sanitize_var_name(js_file.name)
-            impl_content += f"""    if (strcmp(name, "{js_file.stem}") == 0) return js_{name};
-"""
+const char* getTemplate(const char* name) {{
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->data : nullptr;
+}}
 
-    impl_content += """    return nullptr;
-}
+const char* getCSS(const char* name) {{
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->data : nullptr;
+}}
+
+const char* getJS(const char* name) {{
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->data : nullptr;
+}}
 
 // Size functions
-size_t getTemplateSize(const char* name) {
-"""
+size_t getTemplateSize(const char* name) {{
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->length : 0;
+}}
 
-    # Add template size lookup
-    if templates_dir.exists():
-        for html_file in templates_dir.glob('*.html'):
-            name = sanitize_var_name(html_file.name)
-            impl_content += f"""    if (strcmp(name, "{html_file.stem}") == 0) return template_{name}_len;
-"""
+size_t getCSSSize(const char* name) {{
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->length : 0;
+}}
 
-    impl_content += """    return 0;
-}
+size_t getJSSize(const char* name) {{
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->length : 0;
+}}
 
-size_t getCSSSize(const char* name) {
-"""
+const TemplateSegment* getTemplateSegments(const char* name) {{
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->segments : nullptr;
+}}
 
-    # Add CSS size lookup
-    if css_dir.exists():
-        for css_file in css_dir.glob('*.css'):
-            name = sanitize_var_name(css_file.name)
-            impl_content += f"""    if (strcmp(name, "{css_file.stem}") == 0) return css_{name}_len;
-"""
+size_t getTemplateSegmentCount(const char* name) {{
+    const Asset* asset = findAsset("templates", name, ".html");
+    return asset ? asset->segmentCount : 0;
+}}
 
-    impl_content += """    return 0;
-}
+// Cacheable variants
+const uint8_t* getCSSGzip(const char* name) {{
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->gzip : nullptr;
+}}
 
-size_t getJSSize(const char* name) {
-"""
+size_t getCSSGzipSize(const char* name) {{
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->gzipLength : 0;
+}}
 
-    # Add JS size lookup
-    if js_dir.exists():
-        for js_file in js_dir.glob('*.js'):
-            name = sanitize_var_name(js_file.name)
-            impl_content += f"""    if (strcmp(name, "{js_file.stem}") == 0) return js_{name}_len;
-"""
+const char* getCSSETag(const char* name) {{
+    const Asset* asset = findAsset("css", name, ".css");
+    return asset ? asset->etag : nullptr;
+}}
 
-    impl_content += """    return 0;
-}
+const uint8_t* getJSGzip(const char* name) {{
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->gzip : nullptr;
+}}
 
-} // namespace FlexifiAssets
+size_t getJSGzipSize(const char* name) {{
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->gzipLength : 0;
+}}
+
+const char* getJSETag(const char* name) {{
+    const Asset* asset = findAsset("js", name, ".js");
+    return asset ? asset->etag : nullptr;
+}}
+
+// Pre-rendered pages (empty slots when FLEXIFI_DISABLE_PRERENDERED is set)
+const uint8_t* getPage(const char* name) {{
+    const Asset* asset = findAsset("pages", name, ".html");
+    return asset ? asset->gzip : nullptr;
+}}
+
+size_t getPageSize(const char* name) {{
+    const Asset* asset = findAsset("pages", name, ".html");
+    return asset ? asset->gzipLength : 0;
+}}
+
+}} // namespace FlexifiAssets
 """
 
     # Write the implementation file
@@ -306,10 +1019,11 @@ def check_assets_exist():
     project_root = script_dir.parent
     generated_dir = project_root / 'src' / 'generated'
     
+    types_file = generated_dir / 'web_asset_types.h'
     header_file = generated_dir / 'web_assets.h'
     impl_file = generated_dir / 'web_assets.cpp'
     
-    return header_file.exists() and impl_file.exists()
+    return types_file.exists() and header_file.exists() and impl_file.exists()
 
 def main():
     """Main entry point"""
@@ -320,7 +1034,7 @@ def main():
     if MINIFY_AVAILABLE:
         print("✅ minify-html available - assets will be minified")
     else:
-        print("⚠️ minify-html not available - assets will be embedded as-is")
+        print("⚠️ minify-html not available - HTML and CSS will be embedded as-is")
         print("💡 Install with: pip install minify-html")
     print()
     
@@ -334,9 +1048,10 @@ def main():
                 print("⚠️ No pre-generated assets found, running embedding...")
         
         # Check if pre-generated assets already exist (PlatformIO postinstall context)
-        if check_assets_exist():
+        force = "--force" in sys.argv[1:]
+        if check_assets_exist() and not force:
             print("✅ Pre-generated assets already exist, skipping embedding")
-            print("ℹ️  To force regeneration, delete src/generated/ directory first")
+            print("ℹ️  To force regeneration, run with --force or delete src/generated/ first")
             return
             
         header_file = generate_header()
@@ -347,6 +1062,10 @@ def main():
         print(f"📄 Implementation: {impl_file}")
         print("\n💡 Assets embedded and ready for compilation")
         
+    except BudgetExceeded as e:
+        # A regression, not a broken environment: fail even if old assets exist
+        print(f"❌ {e}")
+        sys.exit(1)
     except Exception as e:
         print(f"❌ Error during asset embedding: {e}")
         
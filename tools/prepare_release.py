@@ -77,9 +77,14 @@ def validate_generated_assets():
     print("🔍 Validating generated assets...")
     
     assets_dir = Path("src/generated")
+    types_file = assets_dir / "web_asset_types.h"
     header_file = assets_dir / "web_assets.h"
     impl_file = assets_dir / "web_assets.cpp"
     
+    if not types_file.exists():
+        print("❌ Missing web_asset_types.h")
+        return False
+    
     if not header_file.exists():
         print("❌ Missing web_assets.h")
         return False